@@ -0,0 +1,114 @@
+﻿using Microsoft.Extensions.DependencyInjection;
+
+namespace Testudo.Benchmarks;
+
+public interface ITransientService;
+
+public class TransientService(ISingletonService singleton) : ITransientService
+{
+    public ISingletonService Singleton => singleton;
+}
+
+public interface IScopedService;
+
+public class ScopedService(ISingletonService singleton, ITransientService transient) : IScopedService
+{
+    public ISingletonService Singleton => singleton;
+    public ITransientService Transient => transient;
+}
+
+public interface ISingletonService;
+
+public class SingletonService : ISingletonService;
+
+public interface IEnumerableService;
+
+public class FirstEnumerableService : IEnumerableService;
+
+public class SecondEnumerableService(ISingletonService singleton) : IEnumerableService
+{
+    public ISingletonService Singleton => singleton;
+}
+
+public class ThirdEnumerableService(IScopedService scoped) : IEnumerableService
+{
+    public IScopedService Scoped => scoped;
+}
+
+public interface IKeyedService;
+
+public class KeyedService : IKeyedService;
+
+/// <summary>
+/// A link in a dependency chain, where <typeparamref name="TNext" /> is the next link.
+/// Nesting this type builds chains of any depth without declaring a type for each link.
+/// </summary>
+public class ChainLink<TNext>(TNext next)
+{
+    public TNext Next => next;
+}
+
+/// <summary>
+/// The end of a dependency chain.
+/// </summary>
+public class ChainEnd;
+
+/// <summary>
+/// Builds the service collections that the benchmarks resolve from, so that both containers are given exactly the
+/// same registrations.
+/// </summary>
+public static class BenchmarkServices
+{
+    public const string Key = "key";
+
+    /// <summary>
+    /// Registers a small graph of transient, scoped, singleton, enumerable and keyed services.
+    /// </summary>
+    public static IServiceCollection CreateServices()
+    {
+        var services = new ServiceCollection();
+
+        // Testudo needs the scope context to assign new scopes to, so the stock container gets it too
+        services.AddScoped<IScopeContext, ScopeContext>();
+
+        services.AddTransient<ITransientService, TransientService>();
+        services.AddScoped<IScopedService, ScopedService>();
+        services.AddSingleton<ISingletonService, SingletonService>();
+        services.AddTransient<IEnumerableService, FirstEnumerableService>();
+        services.AddTransient<IEnumerableService, SecondEnumerableService>();
+        services.AddScoped<IEnumerableService, ThirdEnumerableService>();
+        services.AddKeyedTransient<IKeyedService, KeyedService>(Key);
+        return services;
+    }
+
+    /// <summary>
+    /// Registers a chain of transient services with the given depth, and returns the type at the top of the chain.
+    /// </summary>
+    public static Type AddChain(IServiceCollection services, int depth)
+    {
+        var type = typeof(ChainEnd);
+        services.AddTransient(type);
+
+        for (var i = 1; i < depth; i++)
+        {
+            type = typeof(ChainLink<>).MakeGenericType(type);
+            services.AddTransient(type);
+        }
+
+        return type;
+    }
+
+    /// <summary>
+    /// Builds a stock Microsoft.Extensions.DependencyInjection service provider.
+    /// </summary>
+    public static ServiceProvider BuildMicrosoft(IServiceCollection services, bool validateOnBuild = false) =>
+        services.BuildServiceProvider(new ServiceProviderOptions {ValidateOnBuild = validateOnBuild});
+
+    /// <summary>
+    /// Builds a Testudo service provider the same way the generic host does.
+    /// </summary>
+    public static TestudoServiceProvider BuildTestudo(IServiceCollection services,
+        TestudoServiceProviderOptions? options = null) =>
+        (TestudoServiceProvider)new TestudoServiceProviderFactory(options ?? new TestudoServiceProviderOptions())
+            .CreateServiceProvider(services);
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+﻿using BenchmarkDotNet.Attributes;
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Testudo.Benchmarks;
+
+/// <summary>
+/// Compares building a service provider and resolving its first service, which is on the startup path of every
+/// application.
+/// </summary>
+[MemoryDiagnoser]
+public class BuildBenchmarks
+{
+    private IServiceCollection _services = null!;
+
+    [Params(false, true)]
+    public bool ValidateOnBuild { get; set; }
+
+    [GlobalSetup]
+    public void Setup() => _services = BenchmarkServices.CreateServices();
+
+    [Benchmark(Baseline = true)]
+    public object Microsoft()
+    {
+        using var provider = BenchmarkServices.BuildMicrosoft(_services, ValidateOnBuild);
+        return provider.GetRequiredService<IScopedService>();
+    }
+
+    [Benchmark]
+    public object Testudo()
+    {
+        using var provider = BenchmarkServices.BuildTestudo(_services, new TestudoServiceProviderOptions
+        {
+            ValidateOnBuild = ValidateOnBuild
+        });
+
+        return provider.GetRequiredService<IScopedService>();
+    }
+
+    [Benchmark]
+    public object TestudoParallelValidation()
+    {
+        using var provider = BenchmarkServices.BuildTestudo(_services, new TestudoServiceProviderOptions
+        {
+            ValidateOnBuild = ValidateOnBuild,
+            ValidateInParallel = true
+        });
+
+        return provider.GetRequiredService<IScopedService>();
+    }
+}
\ No newline at end of file
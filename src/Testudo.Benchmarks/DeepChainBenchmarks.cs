@@ -0,0 +1,39 @@
+﻿using BenchmarkDotNet.Attributes;
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Testudo.Benchmarks;
+
+/// <summary>
+/// Compares building a provider and resolving the top of a long dependency chain, where every link in the chain
+/// passes through <c>StackGuard</c> when its call site is created.
+/// </summary>
+[MemoryDiagnoser]
+public class DeepChainBenchmarks
+{
+    private IServiceCollection _services = null!;
+    private Type _top = null!;
+
+    [Params(10, 100)]
+    public int Depth { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _services = BenchmarkServices.CreateServices();
+        _top = BenchmarkServices.AddChain(_services, Depth);
+    }
+
+    [Benchmark(Baseline = true)]
+    public object Microsoft()
+    {
+        using var provider = BenchmarkServices.BuildMicrosoft(_services);
+        return provider.GetRequiredService(_top);
+    }
+
+    [Benchmark]
+    public object Testudo()
+    {
+        using var provider = BenchmarkServices.BuildTestudo(_services);
+        return provider.GetRequiredService(_top);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,4 @@
+﻿using BenchmarkDotNet.Running;
+
+// Run everything with "dotnet run -c Release -- --filter *", or pick benchmarks interactively with no arguments
+BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args);
\ No newline at end of file
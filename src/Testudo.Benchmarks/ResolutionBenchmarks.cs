@@ -0,0 +1,93 @@
+﻿using BenchmarkDotNet.Attributes;
+using BenchmarkDotNet.Configs;
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Testudo.Benchmarks;
+
+/// <summary>
+/// Compares steady-state service resolution from the root provider and from a window scope.
+/// </summary>
+[MemoryDiagnoser]
+[GroupBenchmarksBy(BenchmarkLogicalGroupRule.ByCategory)]
+[CategoriesColumn]
+public class ResolutionBenchmarks
+{
+    private ServiceProvider _microsoft = null!;
+    private IServiceScope _microsoftScope = null!;
+    private TestudoServiceProvider _testudo = null!;
+    private IServiceScope _testudoScope = null!;
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _microsoft = BenchmarkServices.BuildMicrosoft(BenchmarkServices.CreateServices());
+        _microsoftScope = _microsoft.CreateScope();
+        _testudo = BenchmarkServices.BuildTestudo(BenchmarkServices.CreateServices());
+        _testudoScope = _testudo.CreateScope();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        _microsoftScope.Dispose();
+        _microsoft.Dispose();
+        _testudoScope.Dispose();
+        _testudo.Dispose();
+    }
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Root.Transient")]
+    public object MicrosoftRootTransient() => _microsoft.GetRequiredService<ITransientService>();
+
+    [Benchmark, BenchmarkCategory("Root.Transient")]
+    public object TestudoRootTransient() => _testudo.GetRequiredService<ITransientService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Root.Singleton")]
+    public object MicrosoftRootSingleton() => _microsoft.GetRequiredService<ISingletonService>();
+
+    [Benchmark, BenchmarkCategory("Root.Singleton")]
+    public object TestudoRootSingleton() => _testudo.GetRequiredService<ISingletonService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Root.Enumerable")]
+    public object MicrosoftRootEnumerable() => _microsoft.GetServices<IEnumerableService>();
+
+    [Benchmark, BenchmarkCategory("Root.Enumerable")]
+    public object TestudoRootEnumerable() => _testudo.GetServices<IEnumerableService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Root.Keyed")]
+    public object MicrosoftRootKeyed() => _microsoft.GetRequiredKeyedService<IKeyedService>(BenchmarkServices.Key);
+
+    [Benchmark, BenchmarkCategory("Root.Keyed")]
+    public object TestudoRootKeyed() => _testudo.GetRequiredKeyedService<IKeyedService>(BenchmarkServices.Key);
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Scope.Transient")]
+    public object MicrosoftScopeTransient() => _microsoftScope.ServiceProvider.GetRequiredService<ITransientService>();
+
+    [Benchmark, BenchmarkCategory("Scope.Transient")]
+    public object TestudoScopeTransient() => _testudoScope.ServiceProvider.GetRequiredService<ITransientService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Scope.Scoped")]
+    public object MicrosoftScopeScoped() => _microsoftScope.ServiceProvider.GetRequiredService<IScopedService>();
+
+    [Benchmark, BenchmarkCategory("Scope.Scoped")]
+    public object TestudoScopeScoped() => _testudoScope.ServiceProvider.GetRequiredService<IScopedService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Scope.Singleton")]
+    public object MicrosoftScopeSingleton() => _microsoftScope.ServiceProvider.GetRequiredService<ISingletonService>();
+
+    [Benchmark, BenchmarkCategory("Scope.Singleton")]
+    public object TestudoScopeSingleton() => _testudoScope.ServiceProvider.GetRequiredService<ISingletonService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Scope.Enumerable")]
+    public object MicrosoftScopeEnumerable() => _microsoftScope.ServiceProvider.GetServices<IEnumerableService>();
+
+    [Benchmark, BenchmarkCategory("Scope.Enumerable")]
+    public object TestudoScopeEnumerable() => _testudoScope.ServiceProvider.GetServices<IEnumerableService>();
+
+    [Benchmark(Baseline = true), BenchmarkCategory("Scope.Keyed")]
+    public object MicrosoftScopeKeyed() =>
+        _microsoftScope.ServiceProvider.GetRequiredKeyedService<IKeyedService>(BenchmarkServices.Key);
+
+    [Benchmark, BenchmarkCategory("Scope.Keyed")]
+    public object TestudoScopeKeyed() =>
+        _testudoScope.ServiceProvider.GetRequiredKeyedService<IKeyedService>(BenchmarkServices.Key);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+﻿using BenchmarkDotNet.Attributes;
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Testudo.Benchmarks;
+
+/// <summary>
+/// Compares the lifetime of a window scope, from creating it and assigning it to its <see cref="IScopeContext" />
+/// through to disposing it.
+/// </summary>
+[MemoryDiagnoser]
+public class ScopeBenchmarks
+{
+    private ServiceProvider _microsoft = null!;
+    private TestudoServiceProvider _testudo = null!;
+
+    /// <summary>
+    /// Whether a few scoped services are resolved in the scope before it is disposed, like a window would.
+    /// </summary>
+    [Params(false, true)]
+    public bool ResolveServices { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        _microsoft = BenchmarkServices.BuildMicrosoft(BenchmarkServices.CreateServices());
+        _testudo = BenchmarkServices.BuildTestudo(BenchmarkServices.CreateServices());
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        _microsoft.Dispose();
+        _testudo.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public void Microsoft()
+    {
+        // Testudo does this itself when it creates a scope, so the stock container has to do it by hand
+        using var scope = _microsoft.CreateScope();
+        scope.ServiceProvider.GetRequiredService<IScopeContext>().ServiceProvider = scope.ServiceProvider;
+        Resolve(scope.ServiceProvider);
+    }
+
+    [Benchmark]
+    public void Testudo()
+    {
+        using var scope = _testudo.CreateScope();
+        Resolve(scope.ServiceProvider);
+    }
+
+    private void Resolve(IServiceProvider provider)
+    {
+        if (ResolveServices)
+        {
+            provider.GetRequiredService<IScopedService>();
+            provider.GetServices<IEnumerableService>();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+using System.Collections.Immutable;
+using System.Linq;
+using System.Text;
+using System.Threading;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+using Microsoft.CodeAnalysis.Operations;
+
+namespace Testudo.Generators;
+
+/// <summary>
+/// Emits constructor activators for every concrete type registered with the service collection in the compilation.
+/// </summary>
+/// <remarks>
+/// Registrations are discovered from calls to the <c>Add*</c> and <c>TryAdd*</c> extension methods on
+/// <c>IServiceCollection</c>, which covers everything except descriptors built by hand. The activators are
+/// registered with <c>Testudo.GeneratedActivators</c> from a module initializer, and the service provider falls
+/// back to reflection for any constructor that does not have one.
+/// </remarks>
+[Generator(LanguageNames.CSharp)]
+public sealed class ServiceActivatorGenerator : IIncrementalGenerator
+{
+    /// <summary>
+    /// The namespaces that contain the service collection registration extension methods.
+    /// </summary>
+    private static readonly ImmutableHashSet<string> RegistrationNamespaces = ImmutableHashSet.Create(
+        "Microsoft.Extensions.DependencyInjection",
+        "Microsoft.Extensions.DependencyInjection.Extensions");
+
+    /// <inheritdoc />
+    public void Initialize(IncrementalGeneratorInitializationContext context)
+    {
+        var implementationTypes = context.SyntaxProvider
+            .CreateSyntaxProvider(
+                static (node, _) => IsRegistrationCandidate(node),
+                static (syntaxContext, cancellationToken) =>
+                    GetImplementationType(syntaxContext.SemanticModel, syntaxContext.Node, cancellationToken))
+            .Where(static type => type is not null)
+            .Collect();
+
+        context.RegisterSourceOutput(context.CompilationProvider.Combine(implementationTypes),
+            static (productionContext, source) => Execute(productionContext, source.Left, source.Right!));
+    }
+
+    /// <summary>
+    /// Quickly filters out syntax nodes that cannot be service registrations.
+    /// </summary>
+    private static bool IsRegistrationCandidate(SyntaxNode node)
+    {
+        if (node is not InvocationExpressionSyntax {Expression: MemberAccessExpressionSyntax memberAccess})
+        {
+            return false;
+        }
+
+        var name = memberAccess.Name.Identifier.ValueText;
+        return name.StartsWith("Add", System.StringComparison.Ordinal)
+               || name.StartsWith("TryAdd", System.StringComparison.Ordinal);
+    }
+
+    /// <summary>
+    /// Gets the type that a service registration will construct.
+    /// </summary>
+    /// <returns>The implementation type, or null if the registration uses a factory or an instance.</returns>
+    private static INamedTypeSymbol? GetImplementationType(SemanticModel semanticModel,
+        SyntaxNode node,
+        CancellationToken cancellationToken)
+    {
+        if (semanticModel.GetOperation(node, cancellationToken) is not IInvocationOperation operation
+            || !RegistrationNamespaces.Contains(operation.TargetMethod.ContainingNamespace.ToDisplayString()))
+        {
+            return null;
+        }
+
+        ITypeSymbol? serviceType = null;
+        ITypeSymbol? implementationType = null;
+        foreach (var argument in operation.Arguments)
+        {
+            switch (argument.Parameter?.Name)
+            {
+                // These are constructed by user code, so there is nothing to generate
+                case "implementationFactory":
+                case "implementationInstance":
+                case "instance":
+                    return null;
+                case "serviceType":
+                case "service":
+                    serviceType = (argument.Value as ITypeOfOperation)?.TypeOperand;
+                    break;
+                case "implementationType":
+                    implementationType = (argument.Value as ITypeOfOperation)?.TypeOperand;
+                    break;
+            }
+        }
+
+        // The last type argument of the generic overloads is always the type that gets constructed
+        var typeArguments = operation.TargetMethod.TypeArguments;
+        var type = implementationType ?? (typeArguments.Length > 0 ? typeArguments[typeArguments.Length - 1] : serviceType);
+
+        return type is INamedTypeSymbol {TypeKind: TypeKind.Class, IsAbstract: false, IsStatic: false} namedType
+               && !ContainsTypeParameters(namedType)
+            ? namedType
+            : null;
+    }
+
+    /// <summary>
+    /// Determines whether the given type is or contains an unbound type parameter.
+    /// </summary>
+    private static bool ContainsTypeParameters(ITypeSymbol type) => type switch
+    {
+        ITypeParameterSymbol => true,
+        IArrayTypeSymbol array => ContainsTypeParameters(array.ElementType),
+        INamedTypeSymbol named => named.IsUnboundGenericType || named.TypeArguments.Any(ContainsTypeParameters),
+        _ => false
+    };
+
+    /// <summary>
+    /// Determines whether generated code in the compilation can name the given type.
+    /// </summary>
+    private static bool IsUsable(Compilation compilation, ITypeSymbol type) =>
+        type is not IPointerTypeSymbol and not IFunctionPointerTypeSymbol and not IDynamicTypeSymbol
+        && !type.IsRefLikeType
+        && !ContainsTypeParameters(type)
+        && compilation.IsSymbolAccessibleWithin(type, compilation.Assembly);
+
+    /// <summary>
+    /// Writes the activators for the discovered implementation types.
+    /// </summary>
+    private static void Execute(SourceProductionContext context,
+        Compilation compilation,
+        ImmutableArray<INamedTypeSymbol> implementationTypes)
+    {
+        // Nothing to register with if the compilation does not reference Testudo
+        if (implementationTypes.IsDefaultOrEmpty
+            || compilation.GetTypeByMetadataName("Testudo.GeneratedActivators") is null
+            || compilation.GetTypeByMetadataName("System.Runtime.CompilerServices.ModuleInitializerAttribute") is null)
+        {
+            return;
+        }
+
+        var builder = new StringBuilder();
+        builder.AppendLine("// <auto-generated/>");
+        builder.AppendLine("#nullable enable");
+        builder.AppendLine("#pragma warning disable CS0612, CS0618");
+        builder.AppendLine();
+        builder.AppendLine("namespace Testudo.Generated");
+        builder.AppendLine("{");
+        builder.AppendLine("    internal static class TestudoServiceActivators");
+        builder.AppendLine("    {");
+        builder.AppendLine("        [global::System.Runtime.CompilerServices.ModuleInitializer]");
+        builder.AppendLine("        internal static void Register()");
+        builder.AppendLine("        {");
+
+        var count = 0;
+        foreach (var type in implementationTypes.Distinct<INamedTypeSymbol>(SymbolEqualityComparer.Default))
+        {
+            context.CancellationToken.ThrowIfCancellationRequested();
+            if (!IsUsable(compilation, type))
+            {
+                continue;
+            }
+
+            // The service provider only ever picks public constructors
+            foreach (var constructor in type.InstanceConstructors)
+            {
+                if (constructor.DeclaredAccessibility != Accessibility.Public
+                    || constructor.Parameters.Any(p => p.RefKind != RefKind.None || !IsUsable(compilation, p.Type)))
+                {
+                    continue;
+                }
+
+                var typeName = type.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+                var parameterTypes = constructor.Parameters
+                    .Select(p => p.Type.WithNullableAnnotation(NullableAnnotation.NotAnnotated)
+                        .ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat))
+                    .ToArray();
+
+                builder.Append("            global::Testudo.GeneratedActivators.Register(typeof(")
+                    .Append(typeName)
+                    .Append("), new global::System.Type[] {")
+                    .Append(string.Join(", ", parameterTypes.Select(t => $"typeof({t})")))
+                    .Append("}, static args => new ")
+                    .Append(typeName)
+                    .Append('(')
+                    .Append(string.Join(", ", parameterTypes.Select((t, i) => $"({t})args[{i}]!")))
+                    .AppendLine("));");
+                count++;
+            }
+        }
+
+        if (count == 0)
+        {
+            return;
+        }
+
+        builder.AppendLine("        }");
+        builder.AppendLine("    }");
+        builder.AppendLine("}");
+        context.AddSource("TestudoServiceActivators.g.cs", builder.ToString());
+    }
+}
\ No newline at end of file
@@ -11,7 +11,8 @@ extern "C"
 }
 
 void nothing(void* pInstance, String arg) { }
-void* redPage(void* pInstance, String uri, int* sizeBytes, String* contentType)
+void* redPage(void* pInstance, String uri, String ifNoneMatch, int* sizeBytes, String* contentType,
+              String* entityTag)
 {
     const auto html = std::wstring(L"<html><body bgcolor=\"red\"></body></html>");
     const auto size = (wcslen(html.c_str()) + 1) * sizeof(wchar_t); // +1 for null terminator
@@ -0,0 +1,65 @@
+#include "FileDialogRequest.h"
+
+/**
+ * @brief Splits a string on the given separator, keeping empty parts.
+ */
+static std::vector<NativeString> split(const NativeString& value, const NativeString::value_type separator)
+{
+    std::vector<NativeString> parts;
+    size_t start = 0;
+    while (true)
+    {
+        const auto end = value.find(separator, start);
+        parts.push_back(value.substr(start, end - start));
+        if (end == NativeString::npos)
+        {
+            return parts;
+        }
+
+        start = end + 1;
+    }
+}
+
+FileDialogRequest::FileDialogRequest(const int requestId,
+                                     const FileDialogOptions* options,
+                                     const FileDialogCompletedDelegate handler)
+{
+    this->requestId = requestId;
+    kind = options->kind;
+    title = options->title == nullptr ? NativeString() : options->title;
+    initialDirectory = options->initialDirectory == nullptr ? NativeString() : options->initialDirectory;
+    defaultFileName = options->defaultFileName == nullptr ? NativeString() : options->defaultFileName;
+    isMultiSelectEnabled = options->isMultiSelectEnabled && kind != FileDialogKind::SaveFile;
+    _handler = handler;
+
+    if (options->filters != nullptr && kind != FileDialogKind::OpenFolder)
+    {
+        // A trailing name with no patterns is dropped
+        const auto parts = split(options->filters, '|');
+        for (size_t i = 0; i + 1 < parts.size(); i += 2)
+        {
+            Filter filter;
+            filter.name = parts[i];
+            for (auto& pattern : split(parts[i + 1], ';'))
+            {
+                if (!pattern.empty())
+                {
+                    filter.patterns.push_back(std::move(pattern));
+                }
+            }
+
+            if (!filter.patterns.empty())
+            {
+                filters.push_back(std::move(filter));
+            }
+        }
+    }
+}
+
+void FileDialogRequest::complete(const std::vector<String>& paths) const
+{
+    if (_handler != nullptr)
+    {
+        _handler(requestId, static_cast<int>(paths.size()), paths.data());
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "FileDialogOptions.h"
+#include "NativeString.h"
+#include "Testudo.h"
+
+/**
+ * @brief An owned copy of a file dialog request, handed to the main loop to show the dialog.
+ */
+class FileDialogRequest
+{
+public:
+    /**
+     * @brief A file type filter.
+     */
+    struct Filter
+    {
+        /** The display name of the filter. */
+        NativeString name;
+
+        /** The glob patterns that the filter matches. */
+        std::vector<NativeString> patterns;
+    };
+
+    /** The ID that the result will be reported with. */
+    int requestId;
+
+    /** The kind of dialog to show. */
+    FileDialogKind kind;
+
+    /** The title of the dialog, or empty for the platform default. */
+    NativeString title;
+
+    /** The directory the dialog starts in, or empty for the platform default. */
+    NativeString initialDirectory;
+
+    /** The file name that a save dialog is pre-filled with, may be empty. */
+    NativeString defaultFileName;
+
+    /** The parsed file type filters. */
+    std::vector<Filter> filters;
+
+    /** Whether more than one item may be selected. */
+    bool isMultiSelectEnabled;
+
+    /**
+     * @brief Copies the given options so they outlive the caller.
+     * @param requestId The ID that the result will be reported with.
+     * @param options The options to copy.
+     * @param handler The managed callback that receives the result.
+     */
+    FileDialogRequest(int requestId, const FileDialogOptions* options, FileDialogCompletedDelegate handler);
+
+    /**
+     * @brief Reports the selected paths to managed code.
+     * @param paths The selected paths, or empty if the dialog was cancelled. Only borrowed for the duration of the call.
+     */
+    void complete(const std::vector<String>& paths) const;
+
+private:
+    /** The managed callback that receives the result. */
+    FileDialogCompletedDelegate _handler;
+};
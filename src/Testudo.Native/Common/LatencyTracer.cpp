@@ -0,0 +1,66 @@
+#include "LatencyTracer.h"
+
+#include <chrono>
+
+std::atomic<long long> LatencyTracer::_lastMessageReceived = 0;
+
+// Prefixing the first literal makes the whole concatenation a wide string on Windows
+#if _WIN32
+const String LatencyTracer::script = L""
+#else
+const String LatencyTracer::script = ""
+#endif
+    "(function() {"
+    "    var external = window.external;"
+    "    var send = external.sendMessage;"
+    "    var receive = external.receiveMessage;"
+    "    var receivedBatches = {};"
+    "    var nextId = 1;"
+    "    var now = function() { return performance.timeOrigin + performance.now(); };"
+    "    var batchId = function(message) { return parseInt(message.substring(message.indexOf(',') + 1), 10); };"
+    "    var trace = function(entry) { send.call(external, '__testudo:trace:' + JSON.stringify(entry)); };"
+    "    external.sendMessage = function(message) {"
+    "        if (message.startsWith('__bwv:[\"DispatchBrowserEvent\",')) {"
+    "            var event = window.event;"
+    "            trace({"
+    "                id: nextId++,"
+    "                type: event ? event.type : null,"
+    "                input: event ? performance.timeOrigin + event.timeStamp : now(),"
+    "                sent: now()"
+    "            });"
+    "        } else if (message.startsWith('__bwv:[\"OnRenderCompleted\",')) {"
+    "            var id = batchId(message);"
+    "            var received = receivedBatches[id];"
+    "            if (received !== undefined) {"
+    "                delete receivedBatches[id];"
+    "                var applied = now();"
+    "                requestAnimationFrame(function() {"
+    "                    setTimeout(function() {"
+    "                        trace({ batch: id, received: received, applied: applied, painted: now() });"
+    "                    }, 0);"
+    "                });"
+    "            }"
+    "        }"
+    "        send.call(external, message);"
+    "    };"
+    "    external.receiveMessage = function(callback) {"
+    "        receive.call(external, function(message) {"
+    "            if (message.startsWith('__bwv:[\"RenderBatch\",')) {"
+    "                receivedBatches[batchId(message)] = now();"
+    "            }"
+    "            callback(message);"
+    "        });"
+    "    };"
+    "})();";
+
+void LatencyTracer::messageReceived()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    _lastMessageReceived.store(std::chrono::duration_cast<std::chrono::microseconds>(now).count(),
+                               std::memory_order_relaxed);
+}
+
+long long LatencyTracer::lastMessageReceived()
+{
+    return _lastMessageReceived.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+
+#include "Testudo.h"
+
+/**
+ * @brief The native half of the input-to-paint latency tracer, which stamps when web messages arrive from the page.
+ * @remarks The rest of an interaction is stamped by the page itself, using @ref script, and by managed code, which
+ * correlates the stamps and reports them. Times are in microseconds on the steady clock, which is the same clock that
+ * managed code reads through Stopwatch.
+ */
+class LatencyTracer
+{
+private:
+    /** When the most recent web message was received from any web view, in microseconds on the steady clock. */
+    static std::atomic<long long> _lastMessageReceived;
+
+public:
+    /**
+     * The script that stamps interactions in the page, injected after the interop script in windows that enable
+     * tracing. It wraps window.external so that browser events, received render batches, applied render batches and
+     * the following paint are reported back to managed code as trace messages.
+     */
+    static const String script;
+
+    /**
+     * @brief Stamps the receipt of a web message. Called before the message is passed to managed code.
+     * @remarks Cheap enough to be called for every message, whether tracing is enabled or not.
+     */
+    static void messageReceived();
+
+    /**
+     * @brief Gets when the most recent web message was received, in microseconds on the steady clock.
+     * @remarks Only meaningful while managed code is handling that message on the main thread.
+     */
+    static long long lastMessageReceived();
+};
@@ -0,0 +1,107 @@
+#include "MemoryAccounting.h"
+
+#if _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#endif
+
+std::atomic<long long> MemoryAccounting::_totalResourceBytesServed = 0;
+std::atomic<long long> MemoryAccounting::_totalResourceCount = 0;
+std::atomic<long long> MemoryAccounting::_totalResourceBytesHeld = 0;
+std::atomic<long long> MemoryAccounting::_totalQueuedMessageBytes = 0;
+std::atomic<int> MemoryAccounting::_totalQueuedMessageCount = 0;
+
+MemoryAccounting::Counters::~Counters()
+{
+    _totalQueuedMessageBytes -= _queuedMessageBytes;
+    _totalQueuedMessageCount -= _queuedMessageCount;
+}
+
+void MemoryAccounting::Counters::resourceServed(const long long sizeBytes)
+{
+    _resourceBytesServed += sizeBytes;
+    _resourceCount++;
+    _resourceBytesHeld += sizeBytes;
+    _totalResourceBytesServed += sizeBytes;
+    _totalResourceCount++;
+    _totalResourceBytesHeld += sizeBytes;
+}
+
+void MemoryAccounting::Counters::resourceReleased(const long long sizeBytes)
+{
+    _resourceBytesHeld -= sizeBytes;
+    _totalResourceBytesHeld -= sizeBytes;
+}
+
+void MemoryAccounting::Counters::messageQueued(const long long sizeBytes)
+{
+    _queuedMessageBytes += sizeBytes;
+    _queuedMessageCount++;
+    _totalQueuedMessageBytes += sizeBytes;
+    _totalQueuedMessageCount++;
+}
+
+void MemoryAccounting::Counters::messagesFlushed(const long long sizeBytes, const int count)
+{
+    _queuedMessageBytes -= sizeBytes;
+    _queuedMessageCount -= count;
+    _totalQueuedMessageBytes -= sizeBytes;
+    _totalQueuedMessageCount -= count;
+}
+
+void MemoryAccounting::Counters::setWebProcessId(const int processId)
+{
+    _webProcessId = processId;
+}
+
+void MemoryAccounting::Counters::fill(MemoryReport* report) const
+{
+    report->resourceBytesServed = _resourceBytesServed;
+    report->resourceCount = _resourceCount;
+    report->resourceBytesHeld = _resourceBytesHeld;
+    report->queuedMessageBytes = _queuedMessageBytes;
+    report->queuedMessageCount = _queuedMessageCount;
+    report->webProcessId = _webProcessId;
+    report->webProcessResidentBytes = report->webProcessId != 0 ? getResidentBytes(report->webProcessId) : -1;
+}
+
+void MemoryAccounting::fillTotals(MemoryReport* report)
+{
+    *report = {};
+    report->resourceBytesServed = _totalResourceBytesServed;
+    report->resourceCount = _totalResourceCount;
+    report->resourceBytesHeld = _totalResourceBytesHeld;
+    report->queuedMessageBytes = _totalQueuedMessageBytes;
+    report->queuedMessageCount = _totalQueuedMessageCount;
+    report->webProcessResidentBytes = -1;
+}
+
+long long MemoryAccounting::getResidentBytes(const int processId)
+{
+#if _WIN32
+    const auto process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, false, processId);
+    if (process == nullptr)
+    {
+        return -1;
+    }
+
+    PROCESS_MEMORY_COUNTERS counters = {};
+    const auto isSuccess = K32GetProcessMemoryInfo(process, &counters, sizeof(counters));
+    CloseHandle(process);
+    return isSuccess ? static_cast<long long>(counters.WorkingSetSize) : -1;
+#else
+    // The second field of statm is the resident set size in pages
+    std::ifstream file("/proc/" + std::to_string(processId) + "/statm");
+    long long sizePages, residentPages;
+    if (!(file >> sizePages >> residentPages))
+    {
+        return -1;
+    }
+
+    return residentPages * sysconf(_SC_PAGESIZE);
+#endif
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+
+#include "MemoryReport.h"
+
+/**
+ * @brief Keeps track of the memory that each window holds on to, along with totals for the whole application.
+ * @remarks Counters are updated from whichever thread serves resources or queues messages, so they are all atomic.
+ * The totals are kept separately rather than summed on demand so that they can be read without locking the windows.
+ */
+class MemoryAccounting
+{
+public:
+    /**
+     * @brief The counters for a single window.
+     * @remarks Windows hold these through a shared pointer so that resource buffers that outlive the window can still
+     * be released against it.
+     */
+    class Counters
+    {
+    private:
+        /** The total size of the resources served so far in bytes. */
+        std::atomic<long long> _resourceBytesServed = 0;
+
+        /** The number of resources served so far. */
+        std::atomic<long long> _resourceCount = 0;
+
+        /** The size of the resource buffers that have not been released yet in bytes. */
+        std::atomic<long long> _resourceBytesHeld = 0;
+
+        /** The size of the queued outbound messages in bytes. */
+        std::atomic<long long> _queuedMessageBytes = 0;
+
+        /** The number of queued outbound messages. */
+        std::atomic<int> _queuedMessageCount = 0;
+
+        /** The ID of the process that hosts the web view, or 0 if it is not known yet. */
+        std::atomic<int> _webProcessId = 0;
+
+    public:
+        /**
+         * @brief Removes anything still queued from the application totals, as it will never be flushed.
+         */
+        ~Counters();
+
+        /**
+         * @brief Records a resource buffer that was handed to the web view.
+         * @param sizeBytes The size of the buffer in bytes.
+         */
+        void resourceServed(long long sizeBytes);
+
+        /**
+         * @brief Records that the web view released a resource buffer.
+         * @param sizeBytes The size of the buffer in bytes.
+         */
+        void resourceReleased(long long sizeBytes);
+
+        /**
+         * @brief Records an outbound message that is waiting to be flushed.
+         * @param sizeBytes The size of the message in bytes.
+         */
+        void messageQueued(long long sizeBytes);
+
+        /**
+         * @brief Records that queued messages were flushed to the web view.
+         * @param sizeBytes The total size of the messages in bytes.
+         * @param count The number of messages.
+         */
+        void messagesFlushed(long long sizeBytes, int count);
+
+        /**
+         * @brief Sets the ID of the process that hosts the web view.
+         * @param processId The process ID.
+         */
+        void setWebProcessId(int processId);
+
+        /**
+         * @brief Fills in everything but @ref MemoryReport::pendingScriptCount, which the window owns.
+         * @param report The report to fill in.
+         */
+        void fill(MemoryReport* report) const;
+    };
+
+private:
+    /** The total size of the resources served by every window so far in bytes. */
+    static std::atomic<long long> _totalResourceBytesServed;
+
+    /** The number of resources served by every window so far. */
+    static std::atomic<long long> _totalResourceCount;
+
+    /** The size of the resource buffers across every window that have not been released yet in bytes. */
+    static std::atomic<long long> _totalResourceBytesHeld;
+
+    /** The size of the outbound messages queued across every window in bytes. */
+    static std::atomic<long long> _totalQueuedMessageBytes;
+
+    /** The number of outbound messages queued across every window. */
+    static std::atomic<int> _totalQueuedMessageCount;
+
+public:
+    /**
+     * @brief Fills in the totals for the whole application.
+     * @param report The report to fill in.
+     */
+    static void fillTotals(MemoryReport* report);
+
+    /**
+     * @brief Gets the resident memory of the given process.
+     * @param processId The process ID.
+     * @return The resident memory in bytes, or -1 if it could not be read.
+     */
+    static long long getResidentBytes(int processId);
+};
@@ -0,0 +1,74 @@
+#include "MessageRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "TestudoApplication.h"
+
+MessageRingBuffer::MessageRingBuffer(const int capacity, DeliverCallback deliver)
+{
+    // Round the capacity up to a power of two so that offsets can be masked rather than divided
+    auto roundedCapacity = 64;
+    while (roundedCapacity < capacity)
+    {
+        roundedCapacity <<= 1;
+    }
+
+    _data = std::make_unique<unsigned char[]>(roundedCapacity);
+    _ring.capacity = roundedCapacity;
+    _ring.data = _data.get();
+    _deliver = std::move(deliver);
+}
+
+MessageRing* MessageRingBuffer::ring()
+{
+    return &_ring;
+}
+
+void MessageRingBuffer::read(const long long offset, void* destination, const size_t sizeBytes) const
+{
+    const auto start = static_cast<size_t>(offset & (_ring.capacity - 1));
+    const auto firstPart = std::min(sizeBytes, static_cast<size_t>(_ring.capacity) - start);
+    memcpy(destination, _ring.data + start, firstPart);
+    memcpy(static_cast<unsigned char*>(destination) + firstPart, _ring.data, sizeBytes - firstPart);
+}
+
+void MessageRingBuffer::drain()
+{
+    // Clear the doorbell before looking for messages, so anything written after this point rings it again
+    _ring.isDrainScheduled.store(0);
+
+    // Delivery may run a nested main loop, in which case the drain that is already running picks up the messages
+    if (_isDraining)
+    {
+        return;
+    }
+
+    _isDraining = true;
+    auto readOffset = _ring.readOffset.load(std::memory_order_relaxed);
+    while (readOffset < _ring.writeOffset.load(std::memory_order_acquire))
+    {
+        int sizeBytes;
+        read(readOffset, &sizeBytes, sizeof(sizeBytes));
+        _message.resize(sizeBytes / sizeof(NativeString::value_type));
+        read(readOffset + sizeof(sizeBytes), _message.data(), sizeBytes);
+
+        // Hand the space back to managed code before delivering, as delivery may take a while
+        readOffset += sizeof(sizeBytes) + ((sizeBytes + 3) & ~3);
+        _ring.readOffset.store(readOffset, std::memory_order_release);
+        _deliver(_message.c_str());
+    }
+
+    _isDraining = false;
+}
+
+void MessageRingBuffer::scheduleDrain(const std::shared_ptr<MessageRingBuffer>& buffer)
+{
+    TestudoApplication::beginInvoke([weakBuffer = std::weak_ptr(buffer)]
+    {
+        if (const auto target = weakBuffer.lock(); target != nullptr)
+        {
+            target->drain();
+        }
+    });
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "MessageRing.h"
+#include "NativeString.h"
+
+/**
+ * @brief Owns a @ref MessageRing and delivers the messages that managed code writes into it on the main loop.
+ * @remarks Managed code writes messages without calling into native code, and only rings the doorbell when the
+ * ring goes from drained to not, so a burst of messages costs a single transition and a single main loop wakeup.
+ */
+class MessageRingBuffer
+{
+public:
+    /**
+     * @brief Delivers a message that was read from the ring to the web view.
+     */
+    using DeliverCallback = std::function<void(String message)>;
+
+private:
+    /** The state shared with managed code. */
+    MessageRing _ring = {};
+
+    /** The ring's storage. */
+    std::unique_ptr<unsigned char[]> _data;
+
+    /** Delivers messages to the web view. */
+    DeliverCallback _deliver;
+
+    /** Whether @ref drain is already running further up the stack. */
+    bool _isDraining = false;
+
+    /** Holds the message being delivered, reused to avoid allocating for every message. */
+    NativeString _message;
+
+    /**
+     * @brief Copies bytes out of the ring, wrapping around its end if necessary.
+     * @param offset The offset to read from, which is masked by the capacity.
+     * @param destination Receives the bytes.
+     * @param sizeBytes The number of bytes to copy.
+     */
+    void read(long long offset, void* destination, size_t sizeBytes) const;
+
+public:
+    /**
+     * @brief Creates an empty ring.
+     * @param capacity The minimum size of the ring in bytes, which is rounded up to a power of two.
+     * @param deliver Delivers messages to the web view.
+     */
+    MessageRingBuffer(int capacity, DeliverCallback deliver);
+
+    /**
+     * @brief Gets the state shared with managed code.
+     */
+    MessageRing* ring();
+
+    /**
+     * @brief Delivers every message that has been written so far, in order.
+     * @remarks Must be called on the main thread.
+     */
+    void drain();
+
+    /**
+     * @brief Queues the given ring to be drained on the main loop.
+     * @param buffer The ring to drain. Nothing happens if it is destroyed before the main loop gets to it.
+     * @remarks May be called from any thread.
+     */
+    static void scheduleDrain(const std::shared_ptr<MessageRingBuffer>& buffer);
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+
+#include "Testudo.h"
+
+/** An owned string of the same character type as the platform's @ref String. */
+using NativeString = std::basic_string<std::remove_const_t<std::remove_pointer_t<String>>>;
@@ -0,0 +1,59 @@
+#include "OutboundFlowControl.h"
+
+OutboundFlowControl::OutboundFlowControl(void* pInstance,
+                                         const int highWaterMarkBytes,
+                                         const int lowWaterMarkBytes,
+                                         const BackPressureChangedDelegate handler)
+{
+    _pInstance = pInstance;
+    _highWaterMarkBytes = highWaterMarkBytes > 0 ? highWaterMarkBytes : 0;
+    _lowWaterMarkBytes = lowWaterMarkBytes > 0 && lowWaterMarkBytes < highWaterMarkBytes
+                             ? lowWaterMarkBytes
+                             : _highWaterMarkBytes / 2;
+    _handler = handler;
+}
+
+void OutboundFlowControl::started(const long long sizeBytes)
+{
+    _outstandingCount++;
+    _outstandingBytes += sizeBytes;
+
+    if (!_isPaused && _highWaterMarkBytes > 0 && _outstandingBytes >= _highWaterMarkBytes)
+    {
+        _isPaused = true;
+        if (_handler != nullptr)
+        {
+            _handler(_pInstance, true, _outstandingCount, _outstandingBytes);
+        }
+    }
+}
+
+void OutboundFlowControl::completed(const long long sizeBytes)
+{
+    _outstandingCount--;
+    _outstandingBytes -= sizeBytes;
+
+    if (_isPaused && _outstandingBytes <= _lowWaterMarkBytes)
+    {
+        _isPaused = false;
+        if (_handler != nullptr)
+        {
+            _handler(_pInstance, false, _outstandingCount, _outstandingBytes);
+        }
+    }
+}
+
+void OutboundFlowControl::detach()
+{
+    _handler = nullptr;
+}
+
+int OutboundFlowControl::outstandingCount() const
+{
+    return _outstandingCount;
+}
+
+long long OutboundFlowControl::outstandingBytes() const
+{
+    return _outstandingBytes;
+}
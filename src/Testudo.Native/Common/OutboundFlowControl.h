@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Testudo.h"
+
+/**
+ * @brief Keeps track of the outbound messages that a window's web view has not finished evaluating yet, and tells
+ * managed code to pause low-priority producers when too many bytes are outstanding.
+ * @remarks Back-pressure starts once the outstanding bytes reach the high water mark and ends once they fall to the
+ * low water mark, so a web process that is just keeping up does not flip the signal for every message.
+ * Only used on the main thread, where evaluations are started and completed.
+ */
+class OutboundFlowControl
+{
+private:
+    /** Pointer to the window that the messages are sent to, passed back to managed code. */
+    void* _pInstance;
+
+    /** The outstanding bytes at which back-pressure starts, or 0 if it is disabled. */
+    long long _highWaterMarkBytes;
+
+    /** The outstanding bytes at which back-pressure ends. */
+    long long _lowWaterMarkBytes;
+
+    /** The managed callback that is told when back-pressure starts and ends. May be null. */
+    BackPressureChangedDelegate _handler;
+
+    /** The number of evaluations that have been started but not completed. */
+    int _outstandingCount = 0;
+
+    /** The size of the messages in the outstanding evaluations in bytes. */
+    long long _outstandingBytes = 0;
+
+    /** Whether managed code has been told to pause. */
+    bool _isPaused = false;
+
+public:
+    /**
+     * @brief Creates the accounting for a window.
+     * @param pInstance Pointer to the window.
+     * @param highWaterMarkBytes The outstanding bytes at which back-pressure starts, or 0 to disable it.
+     * @param lowWaterMarkBytes The outstanding bytes at which back-pressure ends. Defaults to half of
+     * @p highWaterMarkBytes if it is 0 or not below it.
+     * @param handler The managed callback that is told when back-pressure starts and ends. May be null.
+     */
+    OutboundFlowControl(void* pInstance,
+                        int highWaterMarkBytes,
+                        int lowWaterMarkBytes,
+                        BackPressureChangedDelegate handler);
+
+    /**
+     * @brief Records an evaluation that was handed to the web view.
+     * @param sizeBytes The size of the messages being evaluated in bytes.
+     */
+    void started(long long sizeBytes);
+
+    /**
+     * @brief Records that the web view finished an evaluation, successfully or not.
+     * @param sizeBytes The size that was passed to @ref started.
+     */
+    void completed(long long sizeBytes);
+
+    /**
+     * @brief Stops telling managed code about back-pressure, as the window is being destroyed.
+     * @remarks Evaluations that complete afterwards are still accounted for, but nobody is waiting for them.
+     */
+    void detach();
+
+    /**
+     * @brief Gets the number of evaluations that have been started but not completed.
+     */
+    int outstandingCount() const;
+
+    /**
+     * @brief Gets the size of the messages in the outstanding evaluations in bytes.
+     */
+    long long outstandingBytes() const;
+};
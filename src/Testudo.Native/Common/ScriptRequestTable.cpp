@@ -0,0 +1,65 @@
+#include "ScriptRequestTable.h"
+
+#include <vector>
+
+ScriptRequestTable::ScriptRequestTable(void* pInstance, const ScriptEvaluatedDelegate handler)
+{
+    _pInstance = pInstance;
+    _handler = handler;
+}
+
+bool ScriptRequestTable::add(const int requestId)
+{
+    std::lock_guard guard(_lock);
+    return !_isClosed && _pending.insert(requestId).second;
+}
+
+void ScriptRequestTable::complete(const int requestId, const bool isSuccess, const String result)
+{
+    {
+        std::lock_guard guard(_lock);
+        if (_pending.erase(requestId) == 0)
+        {
+            return;
+        }
+    }
+
+    // Invoke the callback outside the lock in case managed code queues another evaluation from it
+    if (_handler != nullptr)
+    {
+        _handler(_pInstance, requestId, isSuccess, result);
+    }
+}
+
+void ScriptRequestTable::reject(const int requestId, const String reason)
+{
+    if (_handler != nullptr)
+    {
+        _handler(_pInstance, requestId, false, reason);
+    }
+}
+
+void ScriptRequestTable::close(const String reason)
+{
+    std::vector<int> pending;
+    {
+        std::lock_guard guard(_lock);
+        _isClosed = true;
+        pending.assign(_pending.begin(), _pending.end());
+        _pending.clear();
+    }
+
+    if (_handler != nullptr)
+    {
+        for (const auto requestId : pending)
+        {
+            _handler(_pInstance, requestId, false, reason);
+        }
+    }
+}
+
+size_t ScriptRequestTable::size()
+{
+    std::lock_guard guard(_lock);
+    return _pending.size();
+}
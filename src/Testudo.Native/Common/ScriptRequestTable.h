@@ -0,0 +1,73 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_set>
+
+#include "Testudo.h"
+
+/**
+ * @brief Tracks the script evaluations that a window has in flight and reports their results to managed code.
+ * @remarks Shared between a window and its pending evaluation callbacks so that results arriving after the
+ * window has been destroyed can be safely discarded.
+ */
+class ScriptRequestTable
+{
+private:
+    /** Pointer to the window instance that results are reported for. */
+    void* _pInstance;
+
+    /** The managed callback that receives evaluation results. */
+    ScriptEvaluatedDelegate _handler;
+
+    /** Synchronises access to @ref _pending and @ref _isClosed. */
+    std::mutex _lock;
+
+    /** The IDs of the evaluations that have not completed yet. */
+    std::unordered_set<int> _pending;
+
+    /** Whether the owning window has been destroyed. */
+    bool _isClosed = false;
+
+public:
+    /**
+     * @brief Creates an empty request table.
+     * @param pInstance Pointer to the window instance that results are reported for.
+     * @param handler The managed callback that receives evaluation results.
+     */
+    ScriptRequestTable(void* pInstance, ScriptEvaluatedDelegate handler);
+
+    /**
+     * @brief Registers a new in-flight evaluation.
+     * @param requestId The ID of the evaluation.
+     * @return False if the table has been closed or the ID is already in flight.
+     */
+    bool add(int requestId);
+
+    /**
+     * @brief Reports the result of an evaluation and removes it from the table.
+     * @param requestId The ID of the evaluation.
+     * @param isSuccess Whether the script was evaluated successfully.
+     * @param result The result as JSON, or a description of the error.
+     * @remarks Results for unknown or already completed IDs are ignored.
+     */
+    void complete(int requestId, bool isSuccess, String result);
+
+    /**
+     * @brief Reports that an evaluation failed before it could be added to the table.
+     * @param requestId The ID of the evaluation.
+     * @param reason The error to report.
+     * @remarks Used when @ref add refuses a request, so that managed code is never left waiting for it.
+     */
+    void reject(int requestId, String reason);
+
+    /**
+     * @brief Fails every in-flight evaluation and stops accepting new ones.
+     * @param reason The error to report for each evaluation.
+     */
+    void close(String reason);
+
+    /**
+     * @brief Gets the number of evaluations that are still in flight.
+     */
+    size_t size();
+};
@@ -0,0 +1,159 @@
+#include "StallWatchdog.h"
+
+#include <algorithm>
+
+StallWatchdog* StallWatchdog::_instance = nullptr;
+
+StallWatchdog::StallWatchdog(const int thresholdMilliseconds, const StallDetectedDelegate handler)
+{
+    _threshold = std::chrono::milliseconds(thresholdMilliseconds);
+    _interval = std::max(_threshold / 4, std::chrono::milliseconds(10));
+    _handler = handler;
+    _lastHeartbeat = std::chrono::steady_clock::now().time_since_epoch().count();
+    _thread = std::thread(&StallWatchdog::run, this);
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    {
+        std::lock_guard guard(_stopLock);
+        _isStopping = true;
+    }
+
+    _stopSignal.notify_one();
+    _thread.join();
+}
+
+void StallWatchdog::start(const int thresholdMilliseconds, const StallDetectedDelegate handler)
+{
+    if (_instance == nullptr && thresholdMilliseconds > 0 && handler != nullptr)
+    {
+        _instance = new StallWatchdog(thresholdMilliseconds, handler);
+    }
+}
+
+void StallWatchdog::stop()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+void StallWatchdog::heartbeat()
+{
+    if (_instance != nullptr)
+    {
+        _instance->_lastHeartbeat.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                        std::memory_order_relaxed);
+    }
+}
+
+unsigned int StallWatchdog::heartbeatIntervalMilliseconds()
+{
+    return _instance == nullptr ? 0 : static_cast<unsigned int>(_instance->_interval.count());
+}
+
+void StallWatchdog::run()
+{
+    using namespace std::chrono;
+
+    auto isStalled = false;
+    milliseconds stallDuration(0);
+    Activity stalledActivity = {StallActivityKind::None, {}, {}};
+
+    std::unique_lock lock(_stopLock);
+    while (!_stopSignal.wait_for(lock, _interval, [this] { return _isStopping; }))
+    {
+        const auto now = steady_clock::now();
+        const steady_clock::time_point lastHeartbeat(
+            steady_clock::duration(_lastHeartbeat.load(std::memory_order_relaxed)));
+        auto stalledFor = duration_cast<milliseconds>(now - lastHeartbeat);
+
+        Activity current = {StallActivityKind::None, {}, {}};
+        {
+            std::lock_guard guard(_activityLock);
+            if (!_activities.empty())
+            {
+                // The outermost activity has been running the longest, the innermost is the most specific
+                stalledFor = std::max(stalledFor, duration_cast<milliseconds>(now - _activities.front().start));
+                current = _activities.back();
+            }
+        }
+
+        if (stalledFor >= _threshold)
+        {
+            stallDuration = stalledFor;
+            if (!isStalled)
+            {
+                // Report as soon as the stall is detected, as it may never end if the main thread is deadlocked
+                isStalled = true;
+                stalledActivity = std::move(current);
+                report(lock, stallDuration, true, stalledActivity);
+            }
+        }
+        else if (isStalled)
+        {
+            isStalled = false;
+
+            auto bucket = 0;
+            while (bucket < stallHistogramBucketCount - 1 && stallDuration.count() > stallHistogramBucketBounds[bucket])
+            {
+                bucket++;
+            }
+
+            _histogram[bucket]++;
+            report(lock, stallDuration, false, stalledActivity);
+        }
+    }
+}
+
+void StallWatchdog::report(std::unique_lock<std::mutex>& lock,
+                           const std::chrono::milliseconds duration,
+                           const bool isOngoing,
+                           const Activity& activity) const
+{
+    StallReport report = {};
+    report.durationMilliseconds = duration.count();
+    report.isOngoing = isOngoing;
+    report.activityKind = activity.kind;
+    report.activity = activity.description.empty() ? nullptr : activity.description.c_str();
+    std::copy_n(_histogram, stallHistogramBucketCount, report.histogram);
+
+    // The handler runs managed code, so don't hold up the destructor while it does
+    lock.unlock();
+    _handler(&report);
+    lock.lock();
+}
+
+StallWatchdog::ActivityScope::ActivityScope(const StallActivityKind kind, const String description)
+{
+    if (_instance == nullptr)
+    {
+        return;
+    }
+
+    Activity activity = {kind, {}, std::chrono::steady_clock::now()};
+    if (description != nullptr)
+    {
+        // Only scan as far as needed, as messages can be arbitrarily large
+        size_t length = 0;
+        while (length < maxActivityLength && description[length] != 0)
+        {
+            length++;
+        }
+
+        activity.description.assign(description, length);
+    }
+
+    std::lock_guard guard(_instance->_activityLock);
+    _instance->_activities.push_back(std::move(activity));
+    _isActive = true;
+}
+
+StallWatchdog::ActivityScope::~ActivityScope()
+{
+    if (_isActive && _instance != nullptr)
+    {
+        std::lock_guard guard(_instance->_activityLock);
+        _instance->_activities.pop_back();
+    }
+}
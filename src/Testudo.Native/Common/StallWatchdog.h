@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "NativeString.h"
+#include "StallReport.h"
+#include "Testudo.h"
+
+/**
+ * @brief Watches the main thread from a background thread and reports when it stops servicing its loop.
+ * @remarks The main loop calls @ref heartbeat on a timer, and long-running work on the main thread is wrapped in an
+ * @ref ActivityScope so that a stall can be attributed to whatever was running at the time. A stall is either a gap
+ * between heartbeats, or an activity that has been running for longer than the threshold, which also catches work
+ * that spins a nested loop such as a modal dialog.
+ */
+class StallWatchdog
+{
+private:
+    /** Activity descriptions are truncated to this many characters so large messages are not copied in full. */
+    static constexpr size_t maxActivityLength = 256;
+
+    /**
+     * @brief A unit of work being run by the main thread.
+     */
+    struct Activity
+    {
+        /** The kind of work. */
+        StallActivityKind kind;
+
+        /** Describes the work. */
+        NativeString description;
+
+        /** When the work started. */
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /** The running watchdog, or null if the watchdog is disabled. */
+    static StallWatchdog* _instance;
+
+    /** How long the main thread may go unserviced before it is reported as stalled. */
+    std::chrono::milliseconds _threshold;
+
+    /** How often the main loop sends a heartbeat and the watchdog checks on it. */
+    std::chrono::milliseconds _interval;
+
+    /** The managed callback that is notified of stalls. */
+    StallDetectedDelegate _handler;
+
+    /** The time of the last heartbeat, in steady clock ticks. */
+    std::atomic<std::chrono::steady_clock::rep> _lastHeartbeat;
+
+    /** Synchronises access to @ref _activities. */
+    std::mutex _activityLock;
+
+    /** The activities the main thread is running, outermost first. */
+    std::vector<Activity> _activities;
+
+    /** Synchronises access to @ref _isStopping. */
+    std::mutex _stopLock;
+
+    /** Wakes the watchdog thread when it is time to stop. */
+    std::condition_variable _stopSignal;
+
+    /** Whether the watchdog thread has been asked to stop. */
+    bool _isStopping = false;
+
+    /** The number of stalls that have ended so far, bucketed by duration. Only touched by the watchdog thread. */
+    int _histogram[stallHistogramBucketCount] = {};
+
+    /** The watchdog thread. */
+    std::thread _thread;
+
+    StallWatchdog(int thresholdMilliseconds, StallDetectedDelegate handler);
+    ~StallWatchdog();
+
+    /**
+     * @brief The body of the watchdog thread.
+     */
+    void run();
+
+    /**
+     * @brief Passes a stall report to the managed callback.
+     * @param lock The lock on @ref _stopLock held by the watchdog thread, which is released while the callback runs.
+     */
+    void report(std::unique_lock<std::mutex>& lock,
+                std::chrono::milliseconds duration,
+                bool isOngoing,
+                const Activity& activity) const;
+
+public:
+    /**
+     * @brief Marks a unit of work on the main thread for the duration of its scope.
+     * @remarks Does nothing if the watchdog is disabled.
+     */
+    class ActivityScope
+    {
+    private:
+        /** Whether an activity was pushed and needs to be popped. */
+        bool _isActive = false;
+
+    public:
+        /**
+         * @brief Marks the start of a unit of work.
+         * @param kind The kind of work.
+         * @param description Describes the work, may be null.
+         */
+        ActivityScope(StallActivityKind kind, String description);
+
+        /**
+         * @brief Marks the end of the unit of work.
+         */
+        ~ActivityScope();
+
+        ActivityScope(const ActivityScope&) = delete;
+        ActivityScope& operator=(const ActivityScope&) = delete;
+    };
+
+    /**
+     * @brief Starts the watchdog thread.
+     * @param thresholdMilliseconds How long the main thread may go unserviced before it is reported as stalled.
+     * @param handler The managed callback that is notified of stalls.
+     */
+    static void start(int thresholdMilliseconds, StallDetectedDelegate handler);
+
+    /**
+     * @brief Stops the watchdog thread, if it is running.
+     */
+    static void stop();
+
+    /**
+     * @brief Records that the main loop is still being serviced. Must be called from the main thread.
+     */
+    static void heartbeat();
+
+    /**
+     * @brief Gets how often the main loop should call @ref heartbeat, in milliseconds.
+     */
+    static unsigned int heartbeatIntervalMilliseconds();
+};
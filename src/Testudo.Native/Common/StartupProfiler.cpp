@@ -0,0 +1,154 @@
+#include "StartupProfiler.h"
+
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <ctime>
+#include <unistd.h>
+#endif
+
+/** The name of the script that starts Blazor in the web view. */
+#if _WIN32
+constexpr auto frameworkScriptName = L"blazor.webview.js";
+#else
+constexpr auto frameworkScriptName = "blazor.webview.js";
+#endif
+
+std::atomic<long long> StartupProfiler::_elapsedMicroseconds[startupPhaseCount] = {};
+std::atomic<StartupCompletedDelegate> StartupProfiler::_handler = nullptr;
+
+/**
+ * @brief Gets how long ago the process started according to the operating system.
+ * @returns The time since the process started, or zero if it could not be determined.
+ */
+static std::chrono::microseconds timeSinceProcessStart()
+{
+#if _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime, now;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        return std::chrono::microseconds::zero();
+    }
+
+    GetSystemTimePreciseAsFileTime(&now);
+    const auto toTicks = [](const FILETIME& time)
+    {
+        return static_cast<long long>(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+    };
+
+    // File times are measured in 100 nanosecond intervals
+    return std::chrono::microseconds((toTicks(now) - toTicks(creationTime)) / 10);
+#else
+    // The start time is the 22nd field of /proc/self/stat, counted in clock ticks since boot. The second field is the
+    // executable name in parentheses, which may itself contain spaces, so fields are counted from its end
+    std::ifstream file("/proc/self/stat");
+    const std::string stat((std::istreambuf_iterator(file)), std::istreambuf_iterator<char>());
+    const auto nameEnd = stat.rfind(')');
+    if (nameEnd == std::string::npos)
+    {
+        return std::chrono::microseconds::zero();
+    }
+
+    std::istringstream fields(stat.substr(nameEnd + 1));
+    std::string field;
+    for (auto i = 3; i <= 22; i++)
+    {
+        fields >> field;
+    }
+
+    timespec uptime = {};
+    const auto ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (!fields || ticksPerSecond <= 0 || clock_gettime(CLOCK_BOOTTIME, &uptime) != 0)
+    {
+        return std::chrono::microseconds::zero();
+    }
+
+    // Only accurate to a clock tick, which is usually 10ms
+    const auto startTime = std::chrono::microseconds(std::stoll(field) * 1000000 / ticksPerSecond);
+    const auto now = std::chrono::seconds(uptime.tv_sec) +
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(uptime.tv_nsec));
+    return std::max(now - startTime, std::chrono::microseconds::zero());
+#endif
+}
+
+std::chrono::steady_clock::time_point StartupProfiler::processStart()
+{
+    static const auto start = std::chrono::steady_clock::now() - timeSinceProcessStart();
+    return start;
+}
+
+void StartupProfiler::report()
+{
+    const auto handler = _handler.load();
+    if (handler == nullptr)
+    {
+        return;
+    }
+
+    StartupReport report = {};
+    for (auto i = 0; i < startupPhaseCount; i++)
+    {
+        const auto elapsed = _elapsedMicroseconds[i].load();
+        report.elapsedMicroseconds[i] = elapsed == 0 ? -1 : elapsed;
+    }
+
+    handler(&report);
+}
+
+void StartupProfiler::setHandler(const StartupCompletedDelegate handler)
+{
+    // Make sure the process start time is captured early, in case it has to fall back to the current time
+    processStart();
+    _handler = handler;
+}
+
+bool StartupProfiler::mark(const StartupPhase phase)
+{
+    auto& slot = _elapsedMicroseconds[static_cast<int>(phase)];
+    if (slot.load(std::memory_order_relaxed) != 0)
+    {
+        return false;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - processStart()).count();
+
+    // Zero means the phase has not been reached, so a phase reached in the first microsecond is rounded up
+    long long expected = 0;
+    if (!slot.compare_exchange_strong(expected, std::max<long long>(elapsed, 1)))
+    {
+        return false;
+    }
+
+    if (phase == finalPhase)
+    {
+        report();
+    }
+
+    return true;
+}
+
+bool StartupProfiler::isMarked(const StartupPhase phase)
+{
+    return _elapsedMicroseconds[static_cast<int>(phase)].load(std::memory_order_relaxed) != 0;
+}
+
+void StartupProfiler::markResourceRequested(const String uri)
+{
+    mark(StartupPhase::FirstResourceRequested);
+
+    // Only look at the URI until the framework script has been seen
+    using StringView = std::basic_string_view<std::remove_const_t<std::remove_pointer_t<String>>>;
+    if (!isMarked(StartupPhase::FrameworkScriptRequested) &&
+        uri != nullptr && StringView(uri).find(frameworkScriptName) != StringView::npos)
+    {
+        mark(StartupPhase::FrameworkScriptRequested);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "StartupReport.h"
+#include "Testudo.h"
+
+/**
+ * @brief Stamps a monotonic timestamp for each phase of startup, and reports them all once startup has completed.
+ * @remarks Each phase is only stamped the first time it is reached, so windows opened later do not affect the
+ * report. Timestamps are measured from process start so that the runtime and host startup are included, and may be
+ * stamped from any thread.
+ */
+class StartupProfiler
+{
+private:
+    /** The phase that completes startup on this platform, which is the last one that can be observed. */
+#if _WIN32
+    static constexpr auto finalPhase = StartupPhase::FirstRenderCompleted;
+#else
+    static constexpr auto finalPhase = StartupPhase::FirstPaint;
+#endif
+
+    /** The time from process start until each phase was reached in microseconds, or 0 if it has not been. */
+    static std::atomic<long long> _elapsedMicroseconds[startupPhaseCount];
+
+    /** The managed callback that receives the report. */
+    static std::atomic<StartupCompletedDelegate> _handler;
+
+    /**
+     * @brief Gets the time at which the process started on the steady clock.
+     * @remarks Falls back to the first time this is called if the platform does not say when the process started.
+     */
+    static std::chrono::steady_clock::time_point processStart();
+
+    /**
+     * @brief Passes the report to the managed callback, if there is one.
+     */
+    static void report();
+
+public:
+    /**
+     * @brief Sets the managed callback that receives the report once startup has completed.
+     * @param handler The callback, may be null.
+     */
+    static void setHandler(StartupCompletedDelegate handler);
+
+    /**
+     * @brief Stamps the given phase, unless it has already been reached.
+     * @param phase The phase that was reached.
+     * @return Whether this call was the first to reach the phase.
+     */
+    static bool mark(StartupPhase phase);
+
+    /**
+     * @brief Gets whether the given phase has been reached.
+     * @param phase The phase to check.
+     */
+    static bool isMarked(StartupPhase phase);
+
+    /**
+     * @brief Stamps the phases that are reached by web resource requests.
+     * @param uri The URI of the requested resource.
+     */
+    static void markResourceRequested(String uri);
+};
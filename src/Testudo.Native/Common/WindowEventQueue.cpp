@@ -0,0 +1,72 @@
+#include "WindowEventQueue.h"
+
+#include <algorithm>
+
+#include "TestudoApplication.h"
+
+WindowEventsDelegate WindowEventQueue::_handler = nullptr;
+std::vector<WindowEvent> WindowEventQueue::_pending;
+std::unordered_map<void*, WindowState> WindowEventQueue::_states;
+
+void WindowEventQueue::setHandler(const WindowEventsDelegate handler)
+{
+    _handler = handler;
+}
+
+void WindowEventQueue::post(const WindowEvent& event)
+{
+    if (_handler == nullptr)
+    {
+        return;
+    }
+
+    const auto existing = std::ranges::find_if(_pending, [&event](const WindowEvent& pending)
+    {
+        return pending.pInstance == event.pInstance && pending.kind == event.kind;
+    });
+
+    if (existing != _pending.end())
+    {
+        *existing = event;
+        return;
+    }
+
+    // The first event since the last batch schedules the next one, which runs once the current iteration's
+    // messages have been handled
+    if (_pending.empty())
+    {
+        TestudoApplication::beginInvoke(flush);
+    }
+
+    _pending.push_back(event);
+}
+
+void WindowEventQueue::postState(void* pInstance, const WindowState state)
+{
+    const auto [entry, isInserted] = _states.try_emplace(pInstance, WindowState::Normal);
+    if (isInserted ? state == WindowState::Normal : entry->second == state)
+    {
+        return;
+    }
+
+    entry->second = state;
+    post({pInstance, WindowEventKind::StateChanged, 0, 0, 0, 0, static_cast<int>(state)});
+}
+
+void WindowEventQueue::removeWindow(void* pInstance)
+{
+    std::erase_if(_pending, [pInstance](const WindowEvent& event) { return event.pInstance == pInstance; });
+    _states.erase(pInstance);
+}
+
+void WindowEventQueue::flush()
+{
+    // Swap the batch out first, as handling it may cause new events that belong in the next one
+    const auto batch = std::move(_pending);
+    _pending.clear();
+
+    if (_handler != nullptr && !batch.empty())
+    {
+        _handler(batch.data(), static_cast<int>(batch.size()));
+    }
+}
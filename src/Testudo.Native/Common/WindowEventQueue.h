@@ -0,0 +1,57 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Testudo.h"
+#include "WindowEvent.h"
+
+/**
+ * @brief Collects window events and delivers them to managed code in one batch per main loop iteration.
+ * @remarks Each window has at most one pending event of each kind, which is updated in place, so an interactive
+ * resize or move only reports where the window ended up by the time the batch is delivered. Only used on the main
+ * thread, where window events are raised.
+ */
+class WindowEventQueue
+{
+private:
+    /** The managed callback that receives each batch. */
+    static WindowEventsDelegate _handler;
+
+    /** The events waiting to be delivered, in the order that each window and kind first changed. */
+    static std::vector<WindowEvent> _pending;
+
+    /** The last state that was reported for each window, so that repeated notifications are not reported again. */
+    static std::unordered_map<void*, WindowState> _states;
+
+    /**
+     * @brief Delivers the pending events to managed code.
+     */
+    static void flush();
+
+public:
+    /**
+     * @brief Sets the managed callback that receives each batch.
+     * @param handler The callback, may be null to stop collecting events.
+     */
+    static void setHandler(WindowEventsDelegate handler);
+
+    /**
+     * @brief Queues an event, replacing any pending event of the same kind for the same window.
+     * @param event The event to queue.
+     */
+    static void post(const WindowEvent& event);
+
+    /**
+     * @brief Queues a @ref WindowEventKind::StateChanged event, unless the window is already in the given state.
+     * @param pInstance Pointer to the window.
+     * @param state The window's new state.
+     */
+    static void postState(void* pInstance, WindowState state);
+
+    /**
+     * @brief Discards the pending events of a window that is being destroyed.
+     * @param pInstance Pointer to the window.
+     */
+    static void removeWindow(void* pInstance);
+};
@@ -1,6 +1,9 @@
 // ReSharper disable CppInconsistentNaming (named this way for C# imports)
 
 #include "Testudo.h"
+#include "../Common/LatencyTracer.h"
+#include "../Common/MemoryAccounting.h"
+#include "../Common/StartupProfiler.h"
 
 #if _WIN32
 #include "TestudoApplication.h"
@@ -47,11 +50,49 @@ extern "C"
     }
 
     /**
-     * @brief Opens a native folder selection dialog.
-     * @return The path to the selected folder, or null if no folder was selected.
+     * @brief Invokes the given action on the main thread, attributing any stall it causes to the given tag.
+     * @param action The action to execute on the main thread.
+     * @param tag Describes the action in stall reports.
+     */
+    EXPORTED void TestudoApplication_InvokeTagged(const Action action, const String tag)
+    {
+        TestudoApplication::invoke(action, tag);
+    }
+
+    /**
+     * @brief Shows a native file dialog without blocking the caller or the main loop.
+     * @param requestId The ID that the result will be reported with.
+     * @param options Describes the dialog. Copied before this function returns.
+     */
+    EXPORTED void TestudoApplication_ShowFileDialog(const int requestId, const FileDialogOptions* options)
+    {
+        TestudoApplication::showFileDialog(requestId, options);
+    }
+
+    /**
+     * @brief Stamps a phase of startup that is only observable from managed code.
+     * @param phase The phase that was reached. Ignored if it has already been reached.
+     */
+    EXPORTED void TestudoApplication_MarkStartupPhase(const StartupPhase phase)
+    {
+        StartupProfiler::mark(phase);
+    }
+
+    /**
+     * @brief Gets when the web message that managed code is handling was received, for the latency tracer.
+     * @returns The time in microseconds on the steady clock.
+     */
+    EXPORTED long long TestudoApplication_GetLastMessageReceivedTime()
+    {
+        return LatencyTracer::lastMessageReceived();
+    }
+
+    /**
+     * @brief Reports the memory held by every window in the application, including those already destroyed.
+     * @param report Receives the report.
      */
-    EXPORTED String TestudoApplication_OpenFolderDialog()
+    EXPORTED void TestudoApplication_GetMemoryReport(MemoryReport* report)
     {
-        return TestudoApplication::openFolderDialog();
+        MemoryAccounting::fillTotals(report);
     }
 }
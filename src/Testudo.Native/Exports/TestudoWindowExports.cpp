@@ -1,6 +1,7 @@
 // ReSharper disable CppInconsistentNaming (named this way for C# imports)
 
 #include "Testudo.h"
+#include "TestudoApplication.h"
 #include "TestudoWindowConfiguration.h"
 
 #if _WIN32
@@ -21,6 +22,22 @@ extern "C"
         return new TestudoWindow(configuration);
     }
 
+    /**
+     * @brief Creates and shows a new native window on the main thread without waiting for it.
+     * @param configuration The window's configuration.
+     * @param requestId The ID that the new window will be reported to
+     * @ref TestudoWindowConfiguration::windowCreatedHandler with once its web view is ready.
+     * @remarks The window does not navigate to its initial URI, so that the caller can finish preparing to serve it
+     * while the web view is being created.
+     */
+    EXPORTED void TestudoWindow_CreateAsync(const TestudoWindowConfiguration* configuration, const int requestId)
+    {
+        TestudoApplication::beginInvoke([configuration, requestId]
+        {
+            (new TestudoWindow(configuration))->showAsync(requestId);
+        });
+    }
+
     /**
      * @brief Destroys an existing web view window.
      * @param instance A pointer to the window instance that should be destroyed.
@@ -39,6 +56,15 @@ extern "C"
         instance->show();
     }
 
+    /**
+     * @brief Restores the given window if it is minimized, and brings it to the front with focus.
+     * @param instance A pointer to the window instance to activate.
+     */
+    EXPORTED void TestudoWindow_Activate(const TestudoWindow* instance)
+    {
+        instance->activate();
+    }
+
     /**
      * @brief Navigates the given window's web view to the given URI.
      * @param instance A pointer to the window whose web view should be navigated.
@@ -58,4 +84,67 @@ extern "C"
     {
         instance->sendMessage(message);
     }
+
+    /**
+     * @brief Sends the same JavaScript message to several windows' web views for evaluation.
+     * @param instances Pointers to the windows containing the web views.
+     * @param count The number of windows.
+     * @param message The JavaScript message to send and evaluate.
+     * @remarks Must be called on the main thread. The message is marshaled, escaped and formatted once rather than
+     * once per window.
+     */
+    EXPORTED void TestudoWindow_Broadcast(TestudoWindow* const* instances, const int count, const String message)
+    {
+        TestudoWindow::broadcast(instances, count, message);
+    }
+
+    /**
+     * @brief Evaluates JavaScript in the given window's web view without waiting for the result.
+     * @param instance A pointer to the window containing the web view.
+     * @param requestId The ID that the result will be reported with.
+     * @param script The JavaScript to evaluate.
+     */
+    EXPORTED void TestudoWindow_ExecuteScript(TestudoWindow* instance, const int requestId, const String script)
+    {
+        instance->executeScript(requestId, script);
+    }
+
+    /**
+     * @brief Reports the memory that the given window is holding on to.
+     * @param instance A pointer to the window to report on.
+     * @param report Receives the report.
+     */
+    EXPORTED void TestudoWindow_GetMemoryReport(const TestudoWindow* instance, MemoryReport* report)
+    {
+        instance->getMemoryReport(report);
+    }
+
+    /**
+     * @brief Gets the ring that managed code writes the given window's outbound messages into.
+     * @param instance A pointer to the window that owns the ring.
+     * @return The ring, or null if the window was not configured with one. Valid until the window is destroyed.
+     */
+    EXPORTED MessageRing* TestudoWindow_GetMessageRing(const TestudoWindow* instance)
+    {
+        return instance->getMessageRing();
+    }
+
+    /**
+     * @brief Queues the given window's message ring to be drained on the main thread, without waiting for it.
+     * @param instance A pointer to the window that owns the ring.
+     */
+    EXPORTED void TestudoWindow_RingMessageDoorbell(const TestudoWindow* instance)
+    {
+        instance->ringMessageDoorbell();
+    }
+
+    /**
+     * @brief Sends every message in the given window's message ring to its web view.
+     * @param instance A pointer to the window that owns the ring.
+     * @remarks Must be called on the main thread, where it lets a sender that is waiting for space make progress.
+     */
+    EXPORTED void TestudoWindow_DrainMessages(const TestudoWindow* instance)
+    {
+        instance->drainMessages();
+    }
 }
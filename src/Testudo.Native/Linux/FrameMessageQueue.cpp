@@ -0,0 +1,214 @@
+#ifdef __linux__
+
+#include "FrameMessageQueue.h"
+
+#include <cstring>
+#include <utility>
+
+/** The refresh interval to assume when the frame clock cannot report one, in microseconds. */
+constexpr gint64 defaultRefreshInterval = 16667;
+
+/** Pending messages are flushed without waiting for a frame once they reach this many bytes. */
+constexpr size_t maxPendingBytes = 4 * 1024 * 1024;
+
+/** How long pending messages wait for a frame before they are flushed anyway, in milliseconds. */
+constexpr guint fallbackTimeout = 100;
+
+FrameMessageQueue::FrameMessageQueue(GtkWidget* widget,
+                                     FlushCallback flush,
+                                     void* pInstance,
+                                     const FrameStatisticsDelegate statisticsHandler)
+{
+    _widget = widget;
+    _flush = std::move(flush);
+    _pInstance = pInstance;
+    _statisticsHandler = statisticsHandler;
+
+    g_signal_connect(_widget, "realize", G_CALLBACK(widgetRealizeCallback), this);
+    g_signal_connect(_widget, "unrealize", G_CALLBACK(widgetUnrealizeCallback), this);
+
+    if (gtk_widget_get_realized(_widget))
+    {
+        attachFrameClock();
+    }
+}
+
+FrameMessageQueue::~FrameMessageQueue()
+{
+    g_signal_handlers_disconnect_by_data(_widget, this);
+    cancelFallback();
+
+    if (_frameClock != nullptr)
+    {
+        g_signal_handler_disconnect(_frameClock, _updateHandlerId);
+    }
+}
+
+/**
+ * @brief Attaches to the widget's frame clock once it has one.
+ */
+void FrameMessageQueue::widgetRealizeCallback(
+    [[maybe_unused]] GtkWidget* widget,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    static_cast<FrameMessageQueue*>(data)->attachFrameClock();
+}
+
+/**
+ * @brief Detaches from the widget's frame clock before it goes away.
+ */
+void FrameMessageQueue::widgetUnrealizeCallback(
+    [[maybe_unused]] GtkWidget* widget,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    static_cast<FrameMessageQueue*>(data)->detachFrameClock();
+}
+
+/**
+ * @brief Flushes pending messages at the start of the frame, before layout.
+ */
+void FrameMessageQueue::frameClockUpdateCallback(
+    GdkFrameClock* frame_clock,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    static_cast<FrameMessageQueue*>(data)->flush(frame_clock);
+}
+
+/**
+ * @brief Flushes pending messages when the frame clock has stopped ticking, such as while the window is hidden.
+ */
+gboolean FrameMessageQueue::fallbackTimeoutCallback(
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    const auto queue = static_cast<FrameMessageQueue*>(data);
+    queue->_fallbackSourceId = 0;
+    queue->flushNow();
+    return G_SOURCE_REMOVE;
+}
+
+void FrameMessageQueue::attachFrameClock()
+{
+    _frameClock = gtk_widget_get_frame_clock(_widget);
+    if (_frameClock != nullptr)
+    {
+        _updateHandlerId = g_signal_connect(_frameClock, "update",
+                                            G_CALLBACK(frameClockUpdateCallback), this);
+    }
+}
+
+void FrameMessageQueue::detachFrameClock()
+{
+    if (_frameClock == nullptr)
+    {
+        return;
+    }
+
+    // Nothing will draw until the widget is realized again, so don't hold messages back
+    flushNow();
+
+    g_signal_handler_disconnect(_frameClock, _updateHandlerId);
+    _frameClock = nullptr;
+    _updateHandlerId = 0;
+}
+
+bool FrameMessageQueue::enqueue(const String message)
+{
+    if (_frameClock == nullptr)
+    {
+        return false;
+    }
+
+    // Only the first message of a frame needs to ask for one
+    if (_pending.empty())
+    {
+        _oldestQueuedTime = g_get_monotonic_time();
+        gdk_frame_clock_request_phase(_frameClock, GDK_FRAME_CLOCK_PHASE_UPDATE);
+        _fallbackSourceId = g_timeout_add(fallbackTimeout, fallbackTimeoutCallback, this);
+    }
+
+    _pending.emplace_back(message);
+    _pendingBytes += strlen(message);
+
+    // Don't let the queue grow without bound while frames are not arriving
+    if (_pendingBytes >= maxPendingBytes)
+    {
+        flushNow();
+    }
+
+    return true;
+}
+
+void FrameMessageQueue::flushNow()
+{
+    cancelFallback();
+    if (_pending.empty())
+    {
+        return;
+    }
+
+    // Swap the queue out first so messages sent while flushing are queued again
+    std::vector<std::string> messages;
+    messages.swap(_pending);
+    _pendingBytes = 0;
+    _flush(messages);
+}
+
+void FrameMessageQueue::cancelFallback()
+{
+    if (_fallbackSourceId != 0)
+    {
+        g_source_remove(_fallbackSourceId);
+        _fallbackSourceId = 0;
+    }
+}
+
+void FrameMessageQueue::flush(GdkFrameClock* frame_clock)
+{
+    cancelFallback();
+    if (_pending.empty())
+    {
+        return;
+    }
+
+    // Swap the queue out first so messages sent while flushing wait for the next frame
+    std::vector<std::string> messages;
+    messages.swap(_pending);
+    const auto bytes = _pendingBytes;
+    _pendingBytes = 0;
+
+    _flush(messages);
+
+    const auto frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+    gint64 refresh_interval = 0;
+    gdk_frame_clock_get_refresh_info(frame_clock, frame_time, &refresh_interval, nullptr);
+    if (refresh_interval <= 0)
+    {
+        refresh_interval = defaultRefreshInterval;
+    }
+
+    // A frame is late if the oldest message missed the display refresh that followed it
+    const auto is_late = frame_time - _oldestQueuedTime > refresh_interval;
+    if (is_late)
+    {
+        _lateFrameCount++;
+    }
+
+    if (_statisticsHandler != nullptr)
+    {
+        FrameStatistics statistics = {};
+        statistics.frameCounter = gdk_frame_clock_get_frame_counter(frame_clock);
+        statistics.frameTime = frame_time;
+        statistics.refreshInterval = refresh_interval;
+        statistics.messageCount = static_cast<int>(messages.size());
+        statistics.byteCount = static_cast<int>(bytes);
+        statistics.lateFrameCount = _lateFrameCount;
+        statistics.isLate = is_late;
+        _statisticsHandler(_pInstance, &statistics);
+    }
+}
+
+#endif
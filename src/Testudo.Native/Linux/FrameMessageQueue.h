@@ -0,0 +1,119 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <gtk/gtk.h>
+
+#include "FrameStatistics.h"
+#include "Testudo.h"
+
+/**
+ * @brief Buffers outbound messages for a web view and flushes them once per display frame.
+ * @remarks Flushing happens in the frame clock's update phase, which runs just before layout and paint,
+ * so the web process applies every message for a frame in one go instead of rendering intermediate states.
+ * The frame clock stops ticking while the window is hidden or minimized, so messages are also flushed directly once
+ * too many bytes are pending, or once no frame has arrived for a while after the first one was queued.
+ */
+class FrameMessageQueue
+{
+public:
+    /**
+     * @brief Delivers a frame's worth of messages to the web view, in the order they were queued.
+     */
+    using FlushCallback = std::function<void(const std::vector<std::string>& messages)>;
+
+private:
+    /** The widget whose frame clock drives flushing. */
+    GtkWidget* _widget;
+
+    /** The frame clock of @ref _widget, or null until the widget is realized. */
+    GdkFrameClock* _frameClock = nullptr;
+
+    /** The ID of the handler connected to the frame clock's update signal. */
+    gulong _updateHandlerId = 0;
+
+    /** Delivers messages to the web view. */
+    FlushCallback _flush;
+
+    /** Pointer to the window instance that statistics are reported for. */
+    void* _pInstance;
+
+    /** The managed callback that receives frame statistics, may be null. */
+    FrameStatisticsDelegate _statisticsHandler;
+
+    /** The messages waiting for the next frame. */
+    std::vector<std::string> _pending;
+
+    /** The total size of @ref _pending in bytes. */
+    size_t _pendingBytes = 0;
+
+    /** When the oldest message in @ref _pending was queued, in microseconds on the monotonic clock. */
+    gint64 _oldestQueuedTime = 0;
+
+    /** The number of frames so far that flushed messages late. */
+    int _lateFrameCount = 0;
+
+    /** The ID of the timeout that flushes pending messages if no frame arrives, or 0 if none is scheduled. */
+    guint _fallbackSourceId = 0;
+
+    static void widgetRealizeCallback(GtkWidget* widget, gpointer data);
+
+    static void widgetUnrealizeCallback(GtkWidget* widget, gpointer data);
+
+    static void frameClockUpdateCallback(GdkFrameClock* frame_clock, gpointer data);
+
+    static gboolean fallbackTimeoutCallback(gpointer data);
+
+    /**
+     * @brief Starts listening to the frame clock of the realized widget.
+     */
+    void attachFrameClock();
+
+    /**
+     * @brief Stops listening to the frame clock, flushing anything still pending.
+     */
+    void detachFrameClock();
+
+    /**
+     * @brief Delivers the pending messages and reports statistics for the given frame.
+     */
+    void flush(GdkFrameClock* frame_clock);
+
+    /**
+     * @brief Delivers the pending messages without waiting for a frame, and without reporting statistics.
+     */
+    void flushNow();
+
+    /**
+     * @brief Cancels the fallback timeout, if one is scheduled.
+     */
+    void cancelFallback();
+
+public:
+    /**
+     * @brief Creates a queue driven by the frame clock of the given widget.
+     * @param widget The widget whose frame clock drives flushing.
+     * @param flush Delivers messages to the web view.
+     * @param pInstance Pointer to the window instance that statistics are reported for.
+     * @param statisticsHandler The managed callback that receives frame statistics, may be null.
+     */
+    FrameMessageQueue(GtkWidget* widget, FlushCallback flush, void* pInstance,
+                      FrameStatisticsDelegate statisticsHandler);
+
+    /**
+     * @brief Disconnects from the widget and its frame clock.
+     */
+    ~FrameMessageQueue();
+
+    /**
+     * @brief Queues a message to be flushed at the next frame.
+     * @param message The message to queue.
+     * @return False if the widget has no frame clock yet, in which case the message should be sent directly.
+     */
+    bool enqueue(String message);
+};
+
+#endif
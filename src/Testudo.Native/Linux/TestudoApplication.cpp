@@ -1,17 +1,79 @@
 #ifdef __linux__
 
-#include "../TestudoApplication.h"
+#include "TestudoApplication.h"
+#include "WebExtensionChannel.h"
+#include "WebViewEnvironment.h"
+#include "../Common/FileDialogRequest.h"
+#include "../Common/StallWatchdog.h"
+#include "../Common/StartupProfiler.h"
+#include "../Common/WindowEventQueue.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <gtk/gtk.h>
 
 /** Used to synchronise main thread invocations. */
 std::mutex invocation_lock;
 
-TestudoApplication::TestudoApplication()
+/** The callback that receives the results of native file dialogs. */
+FileDialogCompletedDelegate file_dialog_completed_handler = nullptr;
+
+/** The source ID of the timer that sends heartbeats to the stall watchdog, or 0 if the watchdog is disabled. */
+guint stall_heartbeat_source = 0;
+
+/**
+ * @brief Sends a heartbeat to the stall watchdog.
+ * @returns Always true, so the timer keeps firing.
+ */
+static gboolean stall_heartbeat_callback([[maybe_unused]] gpointer data)
+{
+    StallWatchdog::heartbeat();
+    return true;
+}
+
+TestudoApplication::TestudoApplication(const TestudoApplicationConfiguration* pConfiguration)
 {
+    StartupProfiler::setHandler(pConfiguration->startupCompletedHandler);
+    StartupProfiler::mark(StartupPhase::ApplicationCreating);
+
     gtk_init(nullptr, nullptr);
+    StartupProfiler::mark(StartupPhase::ToolkitInitialized);
+    file_dialog_completed_handler = pConfiguration->fileDialogCompletedHandler;
+    WindowEventQueue::setHandler(pConfiguration->windowEventsHandler);
+
+    // The web extension must be configured before the first web process is spawned
+    const auto context = WebViewEnvironment::createContext(pConfiguration);
+    if (pConfiguration->webExtensionDirectory != nullptr)
+    {
+        WebExtensionChannel::start(context, pConfiguration->webExtensionDirectory);
+    }
+
+    // Set up the shared web context now, and spawn a web process if requested, so that it overlaps with the rest
+    // of startup
+    WebViewEnvironment::start(pConfiguration);
+
+    // Drive the stall watchdog's heartbeat from the main loop
+    StallWatchdog::start(pConfiguration->stallThresholdMilliseconds, pConfiguration->stallDetectedHandler);
+    if (const auto interval = StallWatchdog::heartbeatIntervalMilliseconds(); interval > 0)
+    {
+        stall_heartbeat_source = g_timeout_add(interval, stall_heartbeat_callback, nullptr);
+    }
+
+    StartupProfiler::mark(StartupPhase::ApplicationCreated);
 }
 
 TestudoApplication::~TestudoApplication()
 {
+    // Stop the watchdog before the main loop goes away so it does not report the shutdown as a stall
+    if (stall_heartbeat_source != 0)
+    {
+        g_source_remove(stall_heartbeat_source);
+        stall_heartbeat_source = 0;
+    }
+
+    StallWatchdog::stop();
+    WebViewEnvironment::stop();
     gtk_main_quit();
 }
 
@@ -26,48 +88,152 @@ void TestudoApplication::run()
  * @returns Always false.
  */
 // ReSharper disable once CppParameterMayBeConst
-gboolean TestudoApplication::invoke_function(gpointer data)
+static gboolean invoke_function(gpointer data)
 {
     const auto invocation = static_cast<Invocation*>(data);
-    invocation->action();
+    {
+        StallWatchdog::ActivityScope activity(StallActivityKind::Invoke, invocation->tag);
+        invocation->action();
+    }
+
     {
         std::lock_guard guard(invocation_lock);
-        invocation->is_completed = true;
+        invocation->isCompleted = true;
     }
 
     invocation->completion.notify_one();
     return false;
 }
 
-void TestudoApplication::invoke(const Action action)
+void TestudoApplication::invoke(const Action action, const String tag)
 {
     Invocation invocation = {};
     invocation.action = action;
+    invocation.tag = tag;
     gdk_threads_add_idle(invoke_function, &invocation);
 
     std::unique_lock lock(invocation_lock);
-    invocation.completion.wait(lock, [&] { return invocation.is_completed; });
+    invocation.completion.wait(lock, [&] { return invocation.isCompleted; });
 }
 
-String TestudoApplication::open_folder_dialog()
+/**
+ * @brief Reports the selection of a file chooser to managed code and destroys it.
+ */
+static void file_dialog_response_callback(
+    GtkNativeDialog* dialog,
+    const gint response,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
 {
-    String result = nullptr;
-    const auto dialog = gtk_file_chooser_dialog_new("Select Directory", nullptr,
-                                                    GTK_FILE_CHOOSER_ACTION_SELECT_FOLDER,
-                                                    GTK_STOCK_CANCEL, GTK_RESPONSE_CANCEL,
-                                                    GTK_STOCK_OPEN, GTK_RESPONSE_ACCEPT,
-                                                    nullptr);
-
-    const auto response = gtk_dialog_run(GTK_DIALOG(dialog));
+    const std::unique_ptr<FileDialogRequest> request(static_cast<FileDialogRequest*>(data));
+    std::vector<String> paths;
+    GSList* filenames = nullptr;
 
     if (response == GTK_RESPONSE_ACCEPT)
     {
-        result = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+        filenames = gtk_file_chooser_get_filenames(GTK_FILE_CHOOSER(dialog));
+        for (auto item = filenames; item != nullptr; item = item->next)
+        {
+            paths.push_back(static_cast<String>(item->data));
+        }
+    }
+
+    // The paths are freed as soon as the callback returns, managed code copies them
+    request->complete(paths);
+    g_slist_free_full(filenames, g_free);
+    g_object_unref(dialog);
+}
+
+/**
+ * @brief Creates and shows a file chooser for the given @ref FileDialogRequest.
+ * @param data Pointer to the @ref FileDialogRequest, which is owned by the dialog from here on.
+ * @returns Always false.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static gboolean show_file_dialog_callback(gpointer data)
+{
+    const auto request = static_cast<FileDialogRequest*>(data);
+
+    GtkFileChooserAction action;
+    String default_title;
+    switch (request->kind)
+    {
+    case FileDialogKind::OpenFolder:
+        action = GTK_FILE_CHOOSER_ACTION_SELECT_FOLDER;
+        default_title = "Select Folder";
+        break;
+    case FileDialogKind::SaveFile:
+        action = GTK_FILE_CHOOSER_ACTION_SAVE;
+        default_title = "Save File";
+        break;
+    default:
+        action = GTK_FILE_CHOOSER_ACTION_OPEN;
+        default_title = "Open File";
+        break;
+    }
+
+    // The native chooser goes through the portal where available, and either way is driven by the main loop
+    // rather than a nested one
+    const auto dialog = gtk_file_chooser_native_new(
+        request->title.empty() ? default_title : request->title.c_str(),
+        nullptr, action, nullptr, nullptr);
+    const auto chooser = GTK_FILE_CHOOSER(dialog);
+
+    gtk_file_chooser_set_select_multiple(chooser, request->isMultiSelectEnabled);
+    if (action == GTK_FILE_CHOOSER_ACTION_SAVE)
+    {
+        gtk_file_chooser_set_do_overwrite_confirmation(chooser, true);
+        if (!request->defaultFileName.empty())
+        {
+            gtk_file_chooser_set_current_name(chooser, request->defaultFileName.c_str());
+        }
+    }
+
+    if (!request->initialDirectory.empty())
+    {
+        gtk_file_chooser_set_current_folder(chooser, request->initialDirectory.c_str());
     }
 
-    gtk_widget_destroy(dialog);
-    return result;
+    for (const auto& [name, patterns] : request->filters)
+    {
+        const auto filter = gtk_file_filter_new();
+        gtk_file_filter_set_name(filter, name.c_str());
+        for (const auto& pattern : patterns)
+        {
+            gtk_file_filter_add_pattern(filter, pattern.c_str());
+        }
+
+        gtk_file_chooser_add_filter(chooser, filter);
+    }
+
+    g_signal_connect(dialog, "response", G_CALLBACK(file_dialog_response_callback), request);
+    gtk_native_dialog_show(GTK_NATIVE_DIALOG(dialog));
+    return false;
+}
+
+void TestudoApplication::showFileDialog(const int requestId, const FileDialogOptions* options)
+{
+    const auto request = new FileDialogRequest(requestId, options, file_dialog_completed_handler);
+    gdk_threads_add_idle(show_file_dialog_callback, request);
 }
 
+/**
+ * @brief Runs and deletes an action that was queued with @ref TestudoApplication::beginInvoke.
+ * @param data Pointer to the action, which is owned by this callback.
+ * @returns Always false.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static gboolean begin_invoke_callback(gpointer data)
+{
+    const std::unique_ptr<std::function<void()>> action(static_cast<std::function<void()>*>(data));
+    StallWatchdog::ActivityScope activity(StallActivityKind::Invoke, nullptr);
+    (*action)();
+    return false;
+}
+
+void TestudoApplication::beginInvoke(std::function<void()> action)
+{
+    gdk_threads_add_idle(begin_invoke_callback, new std::function(std::move(action)));
+}
 
 #endif
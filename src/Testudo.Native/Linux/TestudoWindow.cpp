@@ -1,83 +1,298 @@
 #ifdef __linux__
 
-#include "../TestudoWindow.h"
-
+#include "TestudoWindow.h"
+#include "WebExtensionChannel.h"
+#include "WebViewEnvironment.h"
+#include "../Common/LatencyTracer.h"
+#include "../Common/StallWatchdog.h"
+#include "../Common/OutboundFlowControl.h"
+#include "../Common/StartupProfiler.h"
+#include "../Common/WindowEventQueue.h"
+
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string>
-#include <webkit/webkit2.h>
+#include <webkit2/webkit2.h>
+
+/**
+ * @brief Holds information pertaining to an outbound message evaluation.
+ */
+struct OutboundEvaluation
+{
+    /** The flow control of the window that sent the messages. */
+    std::shared_ptr<OutboundFlowControl> flow_control;
+
+    /** The size of the messages being evaluated in bytes. */
+    long long size_bytes;
+};
 
 /**
- * @brief Holds information pertaining to a JavaScript invocation.
+ * @brief Holds information pertaining to an asynchronous script evaluation.
  */
-struct JavaScriptInvocation
+struct ScriptRequest
 {
-    /** Specifies whether or not the invocation has completed. */
-    bool is_completed;
+    /** The request table of the window that requested the evaluation. */
+    std::shared_ptr<ScriptRequestTable> table;
+
+    /** The ID that the result will be reported with. */
+    int request_id;
 };
 
-/** Reference to the GTK window. */
-GtkWidget* _window;
+/**
+ * @brief Holds a resource buffer that was handed to the web view until it is released.
+ */
+struct ResourceBuffer
+{
+    /** The memory counters of the window that served the buffer. */
+    std::shared_ptr<MemoryAccounting::Counters> memory;
 
-/** Reference to the GTK web view. */
-GtkWidget* _web_view;
+    /** The buffer allocated by managed code. */
+    void* data;
+
+    /** The size of the buffer in bytes. */
+    int size_bytes;
+};
 
-/** Reference to the web view's content manager. */
-WebKitUserContentManager* _content_manager;
+/**
+ * @brief Frees a resource buffer once the web view has finished reading it.
+ */
+static void resource_buffer_free_callback(gpointer data)
+{
+    const auto buffer = static_cast<ResourceBuffer*>(data);
+    buffer->memory->resourceReleased(buffer->size_bytes);
+    free(buffer->data);
+    delete buffer;
+}
 
 /**
  * @brief Passes a JavaScript result back to managed code for processing.
+ * @param data The @ref TestudoWindow whose web view sent the message.
  */
-static void TestudoWindow::script_message_received_callback(
+static void script_message_received_callback(
     [[maybe_unused]] WebKitUserContentManager* content_manager,
     WebKitJavascriptResult* js_result,
     // ReSharper disable once CppParameterMayBeConst
     gpointer data)
 {
+    LatencyTracer::messageReceived();
     JSCValue* js_value = webkit_javascript_result_get_js_value(js_result);
 
     if (jsc_value_is_string(js_value))
     {
         char* value = jsc_value_to_string(js_value);
-        reinterpret_cast<WebMessageReceivedDelegate>(data)(value);
+        static_cast<TestudoWindow*>(data)->dispatchWebMessage(value);
         g_free(value);
     }
 
     webkit_javascript_result_unref(js_result);
 }
 
-/**
- * @brief Pulls a resource's data buffer from managed code and passes it to the web view.
- */
-// ReSharper disable once CppParameterMayBeConst
-static void TestudoWindow::web_context_register_uri_scheme_callback(WebKitURISchemeRequest* request, gpointer data)
+void TestudoWindow::handleUriSchemeRequest(WebKitURISchemeRequest* request)
 {
-    // ReSharper disable once CppCStyleCast
-    const auto delegate = (WebResourceRequestedDelegate)data;
     const auto uri = webkit_uri_scheme_request_get_uri(request);
 
+    // Pass along the entity tag of the copy that WebKit has cached, if it has one
+    String if_none_match = nullptr;
+    if (const auto request_headers = webkit_uri_scheme_request_get_http_headers(request); request_headers != nullptr)
+    {
+        if_none_match = soup_message_headers_get_one(request_headers, "If-None-Match");
+    }
+
     int size_bytes;
     String content_type;
-    const auto result =
-        delegate(const_cast<String>(uri), &size_bytes, &content_type);
+    String entity_tag = nullptr;
+    StartupProfiler::markResourceRequested(uri);
+    StallWatchdog::ActivityScope activity(StallActivityKind::ResourceRequest, uri);
+    const auto result = _configuration->webResourceRequestedHandler(
+        this, uri, if_none_match, &size_bytes, &content_type, &entity_tag);
+
+    // The buffer belongs to the stream until WebKit has read it, which may be well after this returns
+    GInputStream* stream;
+    if (result != nullptr)
+    {
+        _memory->resourceServed(size_bytes);
+        const auto buffer = new ResourceBuffer{_memory, result, size_bytes};
+        GBytes* bytes = g_bytes_new_with_free_func(result, size_bytes, resource_buffer_free_callback, buffer);
+        stream = g_memory_input_stream_new_from_bytes(bytes);
+        g_bytes_unref(bytes);
+    }
+    else
+    {
+        stream = g_memory_input_stream_new();
+    }
+
+    const auto response = webkit_uri_scheme_response_new(stream, result != nullptr ? size_bytes : 0);
+    webkit_uri_scheme_response_set_content_type(response, content_type);
+
+    // Responses carry their entity tag, and must be revalidated so that a changed resource is never missed
+    if (entity_tag != nullptr)
+    {
+        const auto headers = soup_message_headers_new(SOUP_MESSAGE_HEADERS_RESPONSE);
+        soup_message_headers_append(headers, "ETag", entity_tag);
+        soup_message_headers_append(headers, "Cache-Control", "no-cache");
+        webkit_uri_scheme_response_set_http_headers(response, headers);
+
+        // WebKit's cached copy is still current, so there is nothing to send
+        if (result == nullptr)
+        {
+            webkit_uri_scheme_response_set_status(response, 304, "Not Modified");
+        }
+    }
 
-    GInputStream* stream = g_memory_input_stream_new_from_data(
-        result, size_bytes, nullptr);
-    webkit_uri_scheme_request_finish(request, stream, -1, content_type);
+    webkit_uri_scheme_request_finish_with_response(request, response);
 
+    g_object_unref(response);
     g_object_unref(stream);
-    delete[] content_type;
+    // Both strings were allocated by managed code with Marshal.StringToHGlobalAuto, which is malloc on Unix
+    free(const_cast<char*>(content_type));
+    free(const_cast<char*>(entity_tag));
+}
+
+/**
+ * @brief Stamps the first frame painted after the first render, then stops watching the frame clock.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static void frame_clock_after_paint_callback(GdkFrameClock* clock, [[maybe_unused]] gpointer data)
+{
+    if (StartupProfiler::isMarked(StartupPhase::FirstRenderCompleted))
+    {
+        StartupProfiler::mark(StartupPhase::FirstPaint);
+        g_signal_handlers_disconnect_by_func(clock, reinterpret_cast<gpointer>(frame_clock_after_paint_callback),
+                                             nullptr);
+    }
 }
 
-TestudoWindow::TestudoWindow(const TestudoWindowConfiguration* configuration)
+/**
+ * @brief Stamps the navigation phases of startup.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static void web_view_load_changed_callback(WebKitWebView* web_view,
+                                           const WebKitLoadEvent load_event,
+                                           [[maybe_unused]] gpointer data)
 {
-    // Create the window
-    _window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+    switch (load_event)
+    {
+    case WEBKIT_LOAD_STARTED:
+        StartupProfiler::mark(StartupPhase::NavigationStarted);
+        break;
+    case WEBKIT_LOAD_COMMITTED:
+        // Only the window that reached this first goes on to complete startup, so only it needs to watch for paints
+        if (StartupProfiler::mark(StartupPhase::NavigationCommitted))
+        {
+            if (const auto clock = gtk_widget_get_frame_clock(GTK_WIDGET(web_view)); clock != nullptr)
+            {
+                g_signal_connect(clock, "after-paint", G_CALLBACK(frame_clock_after_paint_callback), nullptr);
+            }
+        }
+        break;
+    case WEBKIT_LOAD_FINISHED:
+        StartupProfiler::mark(StartupPhase::NavigationFinished);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Reports the window's latest position and size.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static gboolean window_configure_callback([[maybe_unused]] GtkWidget* widget, GdkEventConfigure* event, gpointer data)
+{
+    WindowEventQueue::post({data, WindowEventKind::Moved, event->x, event->y, 0, 0, 0});
+    WindowEventQueue::post({data, WindowEventKind::Resized, 0, 0, event->width, event->height, 0});
+    return FALSE;
+}
+
+/**
+ * @brief Reports that the window gained or lost focus.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static gboolean window_focus_callback([[maybe_unused]] GtkWidget* widget, GdkEventFocus* event, gpointer data)
+{
+    WindowEventQueue::post({data, WindowEventKind::FocusChanged, 0, 0, 0, 0, event->in != 0});
+    return FALSE;
+}
+
+/**
+ * @brief Reports that the window was shown.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static void window_map_callback([[maybe_unused]] GtkWidget* widget, gpointer data)
+{
+    WindowEventQueue::post({data, WindowEventKind::VisibilityChanged, 0, 0, 0, 0, true});
+}
+
+/**
+ * @brief Reports that the window was hidden.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static void window_unmap_callback([[maybe_unused]] GtkWidget* widget, gpointer data)
+{
+    WindowEventQueue::post({data, WindowEventKind::VisibilityChanged, 0, 0, 0, 0, false});
+}
+
+/**
+ * @brief Reports that the window was minimized, maximized, made fullscreen or restored.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static gboolean window_state_callback([[maybe_unused]] GtkWidget* widget, GdkEventWindowState* event, gpointer data)
+{
+    const auto state = event->new_window_state;
+    WindowEventQueue::postState(data,
+                                state & GDK_WINDOW_STATE_ICONIFIED
+                                    ? WindowState::Minimized
+                                    : state & GDK_WINDOW_STATE_FULLSCREEN
+                                    ? WindowState::Fullscreen
+                                    : state & GDK_WINDOW_STATE_MAXIMIZED
+                                    ? WindowState::Maximized
+                                    : WindowState::Normal);
+    return FALSE;
+}
+
+/**
+ * @brief Reports that the user asked to close the window, then lets it close as it did before.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static gboolean window_delete_callback([[maybe_unused]] GtkWidget* widget,
+                                       [[maybe_unused]] GdkEvent* event,
+                                       gpointer data)
+{
+    WindowEventQueue::post({data, WindowEventKind::CloseRequested, 0, 0, 0, 0, 0});
+    return FALSE;
+}
+
+TestudoWindow::TestudoWindow(const TestudoWindowConfiguration* configuration): ITestudoWindow(configuration)
+{
+    StartupProfiler::mark(StartupPhase::WindowCreating);
+    _configuration = configuration;
+    _scriptRequests = std::make_shared<ScriptRequestTable>(this, configuration->scriptEvaluatedHandler);
+    _scriptCancellable = g_cancellable_new();
+    _memory = std::make_shared<MemoryAccounting::Counters>();
+    _flowControl = std::make_shared<OutboundFlowControl>(this,
+                                                         configuration->outboundHighWaterMarkBytes,
+                                                         configuration->outboundLowWaterMarkBytes,
+                                                         configuration->backPressureChangedHandler);
+    if (configuration->messageRingCapacity > 0)
+    {
+        _messageRing = std::make_shared<MessageRingBuffer>(configuration->messageRingCapacity,
+                                                           [this](const String message) { sendMessage(message); });
+    }
+
+    // Create the window, offscreen windows render into a surface that is never mapped to the screen
+    _window = configuration->isOffscreen
+                  ? gtk_offscreen_window_new()
+                  : gtk_window_new(GTK_WINDOW_TOPLEVEL);
+
+    // GTK destroys the window when the user closes it, which may be well before this instance is destroyed, so hold
+    // on to it until then
+    g_object_ref(_window);
 
     // Apply window configuration
     gtk_window_set_default_size(GTK_WINDOW(_window), configuration->width, configuration->height);
 
-    if (configuration->is_centered)
+    if (configuration->isCentered)
     {
         gtk_window_set_position(GTK_WINDOW(_window), GTK_WIN_POS_CENTER);
     }
@@ -86,64 +301,148 @@ TestudoWindow::TestudoWindow(const TestudoWindowConfiguration* configuration)
         gtk_window_move(GTK_WINDOW(_window), configuration->left, configuration->top);
     }
 
-    // Create the web view and add it to the window
-    _content_manager = webkit_user_content_manager_new();
-    _web_view = webkit_web_view_new_with_user_content_manager(_content_manager);
-    gtk_container_add(GTK_CONTAINER(_window), _web_view);
-
-    // Setup interop script
-    const auto script = webkit_user_script_new(
-        "window.__receiveMessageCallbacks = [];"
-        "window.__dispatchMessageCallback = function(message) {"
-        "	window.__receiveMessageCallbacks.forEach(function(callback) { callback(message); });"
-        "};"
-        "window.external = {"
-        "	sendMessage: function(message) {"
-        "		window.webkit.messageHandlers.visium.postMessage(message);"
-        "	},"
-        "	receiveMessage: function(callback) {"
-        "		window.__receiveMessageCallbacks.push(callback);"
-        "	}"
-        "};",
-        WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES,
-        WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START, nullptr, nullptr);
-
-    webkit_user_content_manager_add_script(_content_manager, script);
-    webkit_user_script_unref(script);
-
-    g_signal_connect(_content_manager, "script-message-received::visium",
-                     G_CALLBACK(script_message_received_callback),
-                     configuration->web_message_received_handler);
+    // Report changes to the window, which are coalesced and delivered once per main loop iteration
+    g_signal_connect(_window, "configure-event", G_CALLBACK(window_configure_callback), this);
+    g_signal_connect(_window, "focus-in-event", G_CALLBACK(window_focus_callback), this);
+    g_signal_connect(_window, "focus-out-event", G_CALLBACK(window_focus_callback), this);
+    g_signal_connect(_window, "map", G_CALLBACK(window_map_callback), this);
+    g_signal_connect(_window, "unmap", G_CALLBACK(window_unmap_callback), this);
+    g_signal_connect(_window, "window-state-event", G_CALLBACK(window_state_callback), this);
+    g_signal_connect(_window, "delete-event", G_CALLBACK(window_delete_callback), this);
+
+    // Create the web view and add it to the window, adopting the one warmed up with the application if there is one
+    _webView = WebViewEnvironment::createWebView(this);
+    _contentManager = webkit_web_view_get_user_content_manager(WEBKIT_WEB_VIEW(_webView));
+    gtk_container_add(GTK_CONTAINER(_window), _webView);
+    g_signal_connect(_webView, "load-changed", G_CALLBACK(web_view_load_changed_callback), nullptr);
+    StartupProfiler::mark(StartupPhase::WebViewCreated);
+
+    g_signal_connect(_contentManager, "script-message-received::visium",
+                     G_CALLBACK(script_message_received_callback), this);
 
     webkit_user_content_manager_register_script_message_handler(
-        _content_manager, "visium");
+        _contentManager, "visium");
 
-    // Setup custom scheme handler
-    const auto context = webkit_web_context_get_default();
-    webkit_web_context_register_uri_scheme(context,
-                                           "app",
-                                           web_context_register_uri_scheme_callback,
-                                           configuration->web_resource_requested_handler,
-                                           nullptr);
+    // Stamp interactions in the page, wrapping the interop script that the web view was created with
+    if (configuration->isLatencyTracingEnabled)
+    {
+        const auto script = webkit_user_script_new(LatencyTracer::script,
+                                                   WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES,
+                                                   WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START, nullptr, nullptr);
+        webkit_user_content_manager_add_script(_contentManager, script);
+        webkit_user_script_unref(script);
+    }
 
+    // Coalesce outbound messages to the display's frame rate if requested. Offscreen windows never present a frame,
+    // so there is nothing to align to
+    if (configuration->isFrameAlignedMessagingEnabled && !configuration->isOffscreen)
+    {
+        _frameQueue = std::make_unique<FrameMessageQueue>(
+            _webView,
+            [this](const std::vector<std::string>& messages) { flushMessages(messages); },
+            this,
+            configuration->frameStatisticsHandler);
+    }
+
+    // Route frames from the web extension to this window, if it is enabled
+    if (const auto channel = WebExtensionChannel::instance(); channel != nullptr)
+    {
+        channel->registerWindow(webkit_web_view_get_page_id(WEBKIT_WEB_VIEW(_webView)), this);
+    }
+
+    StartupProfiler::mark(StartupPhase::WindowCreated);
+}
+
+void TestudoWindow::show()
+{
     // Navigate to the initial URI
-    if (configuration->initial_uri != nullptr)
+    if (_configuration->initialUri != nullptr)
     {
-        navigate(configuration->initial_uri);
+        navigate(_configuration->initialUri);
     }
 
     // Show the window
     gtk_widget_show_all(_window);
 }
 
+void TestudoWindow::showAsync(const int requestId)
+{
+    // The web view is created along with the window, so it is ready to navigate as soon as it is shown
+    gtk_widget_show_all(_window);
+
+    if (_configuration->windowCreatedHandler != nullptr)
+    {
+        _configuration->windowCreatedHandler(requestId, this, true);
+    }
+}
+
 TestudoWindow::~TestudoWindow()
 {
+    // Fail any evaluations that are still in flight, their callbacks will see the cancellation and do nothing
+    _flowControl->detach();
+    g_cancellable_cancel(_scriptCancellable);
+    _scriptRequests->close("The window was destroyed before the script finished evaluating.");
+    g_object_unref(_scriptCancellable);
+
+    if (const auto channel = WebExtensionChannel::instance(); channel != nullptr)
+    {
+        channel->unregisterWindow(webkit_web_view_get_page_id(WEBKIT_WEB_VIEW(_webView)));
+    }
+
+    // Drop any queued messages rather than flushing them into a web view that is going away
+    _frameQueue.reset();
+
+    // Stop reporting changes before the window goes, so that none are queued for a window that no longer exists
+    g_signal_handlers_disconnect_by_data(_window, this);
+    WindowEventQueue::removeWindow(this);
+
+    // Destroying the window again is harmless if the user already closed it
     gtk_widget_destroy(_window);
+    g_object_unref(_webView);
+    g_object_unref(_window);
+}
+
+void TestudoWindow::getMemoryReport(MemoryReport* report) const
+{
+    _memory->fill(report);
+    report->pendingScriptCount = static_cast<int>(_scriptRequests->size());
+}
+
+void TestudoWindow::setWebProcessId(const int processId) const
+{
+    _memory->setWebProcessId(processId);
+}
+
+MessageRing* TestudoWindow::getMessageRing() const
+{
+    return _messageRing != nullptr ? _messageRing->ring() : nullptr;
+}
+
+void TestudoWindow::ringMessageDoorbell() const
+{
+    MessageRingBuffer::scheduleDrain(_messageRing);
+}
+
+void TestudoWindow::drainMessages() const
+{
+    if (_messageRing != nullptr)
+    {
+        _messageRing->drain();
+    }
+}
+
+void TestudoWindow::activate() const
+{
+    // Offscreen windows are never shown, so presenting one would only map it for nothing
+    if (!_configuration->isOffscreen)
+    {
+        gtk_window_present(GTK_WINDOW(_window));
+    }
 }
 
 void TestudoWindow::navigate(const String uri) const
 {
-    webkit_web_view_load_uri(WEBKIT_WEB_VIEW(_web_view), uri);
+    webkit_web_view_load_uri(WEBKIT_WEB_VIEW(_webView), uri);
 }
 
 /**
@@ -151,7 +450,7 @@ void TestudoWindow::navigate(const String uri) const
  * @param string: The JSON string to format.
  * @returns The formatted JSON string.
  */
-static std::string TestudoWindow::escape_json(const std::string& string)
+static std::string escape_json(const std::string& string)
 {
     std::ostringstream string_stream;
 
@@ -198,48 +497,205 @@ static std::string TestudoWindow::escape_json(const std::string& string)
 }
 
 /**
-  * @brief Callback function for @ref webkit_web_view_evaluate_javascript.
+  * @brief Callback function for @ref webkit_web_view_evaluate_javascript when called to deliver outbound messages.
+  * Releases the messages from the window's flow control, whether or not the evaluation succeeded.
   * @param source_object The web view instance that initiated the evaluation.
   * @param result The result of the JavaScript evaluation.
-  * @param data @ref JSInvocation instance passed through from the consumer.
-  * Should be an instance of @ref JSInvocation.
+  * @param data The @ref OutboundEvaluation associated with the evaluation.
   */
-static void TestudoWindow::web_view_evaluate_java_script_callback(
-    [[maybe_unused]] GObject* source_object,
-    [[maybe_unused]] GAsyncResult* result,
+static void web_view_send_message_callback(
+    GObject* source_object,
+    GAsyncResult* result,
     // ReSharper disable once CppParameterMayBeConst
     gpointer data)
 {
-    const auto invocation = static_cast<JavaScriptInvocation*>(data);
-    invocation->is_completed = true;
+    const std::unique_ptr<OutboundEvaluation> evaluation(static_cast<OutboundEvaluation*>(data));
+    evaluation->flow_control->completed(evaluation->size_bytes);
+
+    GError* error = nullptr;
+    if (const auto js_value = webkit_web_view_evaluate_javascript_finish(WEBKIT_WEB_VIEW(source_object), result, &error);
+        js_value != nullptr)
+    {
+        g_object_unref(js_value);
+    }
+    else
+    {
+        g_error_free(error);
+    }
+}
+
+void TestudoWindow::evaluateMessages(const std::string& javascript, const long long sizeBytes) const
+{
+    // Ownership of the evaluation passes to the callback
+    _flowControl->started(sizeBytes);
+    const auto evaluation = new OutboundEvaluation{_flowControl, sizeBytes};
+    webkit_web_view_evaluate_javascript(
+        WEBKIT_WEB_VIEW(_webView),
+        javascript.c_str(),
+        static_cast<gssize>(javascript.size()),
+        nullptr,
+        nullptr,
+        _scriptCancellable,
+        web_view_send_message_callback,
+        evaluation);
+}
+
+void TestudoWindow::dispatchWebMessage(const String message)
+{
+    StallWatchdog::ActivityScope activity(StallActivityKind::WebMessage, message);
+    _configuration->webMessageReceivedHandler(this, message);
+}
+
+void TestudoWindow::dispatchWebBinaryMessage(const void* data, const size_t sizeBytes)
+{
+    if (_configuration->webBinaryMessageReceivedHandler != nullptr)
+    {
+        _configuration->webBinaryMessageReceivedHandler(this, data, static_cast<int>(sizeBytes));
+    }
+}
+
+void TestudoWindow::sendMessage(const String message) const
+{
+    std::string javascript;
+    deliverMessage(message, strlen(message), javascript);
+}
+
+void TestudoWindow::broadcast(TestudoWindow* const* windows, const int count, const String message)
+{
+    // The script is built by the first window that needs it and shared with the rest
+    const auto size_bytes = strlen(message);
+    std::string javascript;
+
+    for (auto i = 0; i < count; i++)
+    {
+        // Anything already in the window's ring was sent first, so it must be delivered first
+        windows[i]->drainMessages();
+        windows[i]->deliverMessage(message, size_bytes, javascript);
+    }
 }
 
-void TestudoWindow::send_message(const String message) const
+void TestudoWindow::deliverMessage(const String message, const size_t sizeBytes, std::string& javascript) const
 {
+    // Wait for the next frame if messages are being coalesced
+    if (_frameQueue != nullptr && _frameQueue->enqueue(message))
+    {
+        _memory->messageQueued(static_cast<long long>(sizeBytes));
+        return;
+    }
+
+    // Prefer the web extension channel, which needs neither escaping nor script evaluation
+    if (const auto channel = WebExtensionChannel::instance(); channel != nullptr
+        && channel->send(webkit_web_view_get_page_id(WEBKIT_WEB_VIEW(_webView)),
+                         WebExtensionFrameType::Text, message, sizeBytes))
+    {
+        return;
+    }
+
     // Format the message appropriately for Linux
+    if (javascript.empty())
+    {
+        javascript.append("__dispatchMessageCallback(\"");
+        javascript.append(escape_json(message));
+        javascript.append("\")");
+    }
+
+    // Evaluations run in the order they were started, so there is no need to wait for this one to finish, which
+    // would hold up every other window while this web view is busy
+    evaluateMessages(javascript, static_cast<long long>(sizeBytes));
+}
+
+void TestudoWindow::flushMessages(const std::vector<std::string>& messages) const
+{
+    long long size_bytes = 0;
+    for (const auto& message : messages)
+    {
+        size_bytes += static_cast<long long>(message.size());
+    }
+
+    _memory->messagesFlushed(size_bytes, static_cast<int>(messages.size()));
+
+    const auto channel = WebExtensionChannel::instance();
+    const auto page_id = webkit_web_view_get_page_id(WEBKIT_WEB_VIEW(_webView));
+
+    // Either every message can go through the web extension channel or none of them can
+    if (channel != nullptr && channel->send(page_id, WebExtensionFrameType::Text,
+                                            messages.front().data(), messages.front().size()))
+    {
+        for (size_t i = 1; i < messages.size(); i++)
+        {
+            channel->send(page_id, WebExtensionFrameType::Text, messages[i].data(), messages[i].size());
+        }
+
+        return;
+    }
+
+    // Combine the frame's messages into a single evaluation
     std::string javascript;
-    javascript.append("__dispatchMessageCallback(\"");
-    javascript.append(escape_json(message));
-    javascript.append("\")");
-    const auto script = javascript.c_str();
+    for (const auto& message : messages)
+    {
+        javascript.append("__dispatchMessageCallback(\"");
+        javascript.append(escape_json(message));
+        javascript.append("\");");
+    }
+
+    // No need to wait for completion, the frame clock already paces the evaluations
+    evaluateMessages(javascript, size_bytes);
+}
+
+/**
+ * @brief Callback function for @ref webkit_web_view_evaluate_javascript when called from
+ * @ref TestudoWindow::executeScript.
+ * Converts the result to JSON and reports it to managed code.
+ * @param source_object The web view instance that initiated the evaluation.
+ * @param result The result of the JavaScript evaluation.
+ * @param data The @ref ScriptRequest associated with the evaluation.
+ */
+static void web_view_execute_script_callback(
+    GObject* source_object,
+    GAsyncResult* result,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    const std::unique_ptr<ScriptRequest> request(static_cast<ScriptRequest*>(data));
+
+    GError* error = nullptr;
+    JSCValue* js_value = webkit_web_view_evaluate_javascript_finish(WEBKIT_WEB_VIEW(source_object), result, &error);
 
-    // Invoke the JavaScript evaluation
-    JavaScriptInvocation invocation = {};
+    if (js_value == nullptr)
+    {
+        request->table->complete(request->request_id, false, error->message);
+        g_error_free(error);
+        return;
+    }
+
+    // Undefined has no JSON representation, so report it the same way as null
+    char* json = jsc_value_is_undefined(js_value) ? nullptr : jsc_value_to_json(js_value, 0);
+    request->table->complete(request->request_id, true, json != nullptr ? json : "null");
+
+    g_free(json);
+    g_object_unref(js_value);
+}
+
+void TestudoWindow::executeScript(const int requestId, const String script)
+{
+    if (!_scriptRequests->add(requestId))
+    {
+        _scriptRequests->reject(requestId,
+                                "The window has been destroyed, or the request is already in flight.");
+        return;
+    }
+
+    // Ownership of the request passes to the callback
+    const auto request = new ScriptRequest{_scriptRequests, requestId};
     webkit_web_view_evaluate_javascript(
-        WEBKIT_WEB_VIEW(_web_view),
+        WEBKIT_WEB_VIEW(_webView),
         script,
         static_cast<gssize>(strlen(script)),
         nullptr,
         nullptr,
-        nullptr,
-        web_view_evaluate_java_script_callback,
-        &invocation);
-
-    // Block until the invocation is complete
-    while (!invocation.is_completed)
-    {
-        g_main_context_iteration(nullptr, true);
-    }
+        _scriptCancellable,
+        web_view_execute_script_callback,
+        request);
 }
 
 #endif
@@ -0,0 +1,147 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtk/gtk.h>
+#include <webkit2/webkit2.h>
+
+#include "ITestudoWindow.h"
+#include "FrameMessageQueue.h"
+#include "../Common/MemoryAccounting.h"
+#include "../Common/MessageRingBuffer.h"
+#include "../Common/OutboundFlowControl.h"
+#include "../Common/ScriptRequestTable.h"
+
+class TestudoWindow final : ITestudoWindow
+{
+private:
+    /** The configuration for this window. */
+    const TestudoWindowConfiguration* _configuration;
+
+    /** Reference to the GTK window. */
+    GtkWidget* _window;
+
+    /** Reference to the GTK web view. */
+    GtkWidget* _webView;
+
+    /** Reference to the web view's content manager. */
+    WebKitUserContentManager* _contentManager;
+
+    /** The script evaluations that are still in flight for this window. */
+    std::shared_ptr<ScriptRequestTable> _scriptRequests;
+
+    /** Cancels any script evaluations that are still in flight when this window is destroyed. */
+    GCancellable* _scriptCancellable;
+
+    /** Keeps track of the memory that this window is holding on to. */
+    std::shared_ptr<MemoryAccounting::Counters> _memory;
+
+    /** Keeps track of the outbound messages that the web view has not finished evaluating yet. */
+    std::shared_ptr<OutboundFlowControl> _flowControl;
+
+    /** The ring that managed code writes outbound messages into, or null if it is not enabled. */
+    std::shared_ptr<MessageRingBuffer> _messageRing;
+
+    /** Coalesces outbound messages to the display's frame rate, or null if not enabled. */
+    std::unique_ptr<FrameMessageQueue> _frameQueue;
+
+    /**
+     * @brief Delivers a frame's worth of coalesced messages to the web view in one go.
+     * @param messages The messages to deliver, in order.
+     */
+    void flushMessages(const std::vector<std::string>& messages) const;
+
+    /**
+     * @brief Evaluates outbound messages in the web view without waiting for them, accounting for them until the
+     * web view has finished.
+     * @param javascript The script that dispatches the messages.
+     * @param sizeBytes The size of the messages in bytes.
+     */
+    void evaluateMessages(const std::string& javascript, long long sizeBytes) const;
+
+    /**
+     * @brief Delivers a message to the web view by whichever route is enabled.
+     * @param message The message to deliver.
+     * @param sizeBytes The size of the message in bytes.
+     * @param javascript The script that dispatches the message, which is built here if it is empty so that it can
+     * be reused for other windows.
+     */
+    void deliverMessage(String message, size_t sizeBytes, std::string& javascript) const;
+
+public:
+    explicit TestudoWindow(const TestudoWindowConfiguration* configuration);
+
+    ~TestudoWindow() override;
+
+    void show() override;
+
+    void showAsync(int requestId) override;
+
+    /**
+     * @brief Restores the window if it is minimized, and brings it to the front with focus.
+     */
+    void activate() const;
+
+    void navigate(String uri) const override;
+
+    void sendMessage(String message) const override;
+
+    /**
+     * @brief Sends the same message to several windows, escaping and formatting it once for all of them.
+     * @param windows The windows to send the message to.
+     * @param count The number of windows.
+     * @param message The message to send.
+     * @remarks Must be called on the main thread.
+     */
+    static void broadcast(TestudoWindow* const* windows, int count, String message);
+
+    void executeScript(int requestId, String script) override;
+
+    void getMemoryReport(MemoryReport* report) const override;
+
+    /**
+     * @brief Gets the ring that managed code writes outbound messages into.
+     * @return The ring, or null if @ref TestudoWindowConfiguration::messageRingCapacity is 0.
+     */
+    MessageRing* getMessageRing() const;
+
+    /**
+     * @brief Queues the message ring to be drained on the main loop. May be called from any thread.
+     */
+    void ringMessageDoorbell() const;
+
+    /**
+     * @brief Sends every message in the message ring to the web view. Must be called on the main thread.
+     */
+    void drainMessages() const;
+
+    /**
+     * @brief Pulls a resource's data buffer from managed code and passes it to the web view.
+     * @param request The app:// request made by this window's web view.
+     */
+    void handleUriSchemeRequest(WebKitURISchemeRequest* request);
+
+    /**
+     * @brief Records the web process that is hosting this window's page.
+     * @param processId The ID of the web process.
+     */
+    void setWebProcessId(int processId) const;
+
+    /**
+     * @brief Passes a text message received from the web view to managed code.
+     * @param message The message that was received.
+     */
+    void dispatchWebMessage(String message);
+
+    /**
+     * @brief Passes a binary message received from the web view to managed code.
+     * @param data The message that was received.
+     * @param sizeBytes The size of the message in bytes.
+     */
+    void dispatchWebBinaryMessage(const void* data, size_t sizeBytes);
+};
+
+#endif
@@ -0,0 +1,239 @@
+#ifdef __linux__
+
+/*
+ * The Testudo web extension is loaded into each web process by WebKit when a directory is given in
+ * TestudoApplicationConfiguration::webExtensionDirectory. It exposes a "testudo" object to JavaScript
+ * that talks to the UI process over a dedicated socket instead of the script message handler and
+ * script evaluation.
+ *
+ * This file is compiled into its own shared object together with ../WebExtensionConnection.cpp.
+ */
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <gio/gunixsocketaddress.h>
+#include <webkit2/webkit-web-extension.h>
+
+#include "../WebExtensionConnection.h"
+
+/** The connection to the UI process, or null if it could not be established. */
+static WebExtensionConnection* _connection;
+
+/** The JavaScript receive callbacks registered by each web page, keyed by web page ID. */
+static std::unordered_map<uint64_t, std::vector<JSCValue*>> _receive_callbacks;
+
+/**
+ * @brief Releases the receive callbacks registered by the given web page.
+ */
+static void clear_receive_callbacks(const uint64_t page_id)
+{
+    const auto callbacks = _receive_callbacks.find(page_id);
+    if (callbacks != _receive_callbacks.end())
+    {
+        for (const auto callback : callbacks->second)
+        {
+            g_object_unref(callback);
+        }
+
+        _receive_callbacks.erase(callbacks);
+    }
+}
+
+/**
+ * @brief Implements testudo.send(message) for a web page.
+ * Strings are sent as text, ArrayBuffers and typed arrays as binary, and anything else as JSON text.
+ * @param value The message to send.
+ * @param data Pointer to the ID of the web page the function belongs to.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static void send_function_callback(JSCValue* value, gpointer data)
+{
+    const auto page_id = *static_cast<uint64_t*>(data);
+
+    if (_connection == nullptr)
+    {
+        return;
+    }
+
+    if (jsc_value_is_string(value))
+    {
+        char* text = jsc_value_to_string(value);
+        _connection->send(WebExtensionFrameType::Text, page_id, text, strlen(text));
+        g_free(text);
+    }
+    else if (jsc_value_is_array_buffer(value))
+    {
+        gsize size = 0;
+        const auto buffer = static_cast<const char*>(jsc_value_array_buffer_get_data(value, &size));
+        _connection->send(WebExtensionFrameType::Binary, page_id, buffer, size);
+    }
+    else if (jsc_value_is_typed_array(value))
+    {
+        const auto buffer = static_cast<const char*>(jsc_value_typed_array_get_data(value, nullptr));
+        _connection->send(WebExtensionFrameType::Binary, page_id, buffer, jsc_value_typed_array_get_size(value));
+    }
+    else
+    {
+        char* json = jsc_value_to_json(value, 0);
+        if (json != nullptr)
+        {
+            _connection->send(WebExtensionFrameType::Text, page_id, json, strlen(json));
+            g_free(json);
+        }
+    }
+}
+
+/**
+ * @brief Implements testudo.receive(callback) for a web page.
+ * @param callback The JavaScript function to call with each message received from the UI process.
+ * @param data Pointer to the ID of the web page the function belongs to.
+ */
+// ReSharper disable once CppParameterMayBeConst
+static void receive_function_callback(JSCValue* callback, gpointer data)
+{
+    if (jsc_value_is_function(callback))
+    {
+        const auto page_id = *static_cast<uint64_t*>(data);
+        _receive_callbacks[page_id].push_back(JSC_VALUE(g_object_ref(callback)));
+    }
+}
+
+/**
+ * @brief Passes a frame from the UI process to the receive callbacks of the web page it is addressed to.
+ */
+static void frame_received_callback(
+    [[maybe_unused]] WebExtensionConnection* connection,
+    const WebExtensionFrameType type,
+    const uint64_t page_id,
+    const char* data,
+    const size_t length)
+{
+    const auto callbacks = _receive_callbacks.find(page_id);
+    if (callbacks == _receive_callbacks.end() || callbacks->second.empty())
+    {
+        return;
+    }
+
+    // Copy the list as a callback may register further callbacks while it runs
+    const auto receivers = callbacks->second;
+    const auto context = jsc_value_get_context(receivers.front());
+    JSCValue* argument;
+
+    if (type == WebExtensionFrameType::Binary)
+    {
+        const auto buffer = g_memdup2(data, length);
+        argument = jsc_value_new_array_buffer(context, buffer, length, g_free, buffer);
+    }
+    else
+    {
+        GBytes* bytes = g_bytes_new(data, length);
+        argument = jsc_value_new_string_from_bytes(context, bytes);
+        g_bytes_unref(bytes);
+    }
+
+    for (const auto receiver : receivers)
+    {
+        JSCValue* result = jsc_value_function_call(receiver, JSC_TYPE_VALUE, argument, G_TYPE_NONE);
+        g_clear_object(&result);
+    }
+
+    g_object_unref(argument);
+}
+
+/**
+ * @brief Installs the testudo object into each new main frame window and tells the UI process that
+ * the page can now use the channel.
+ */
+static void window_object_cleared_callback(
+    WebKitScriptWorld* world,
+    WebKitWebPage* page,
+    WebKitFrame* frame,
+    [[maybe_unused]] gpointer data)
+{
+    if (!webkit_frame_is_main_frame(frame))
+    {
+        return;
+    }
+
+    const auto page_id = webkit_web_page_get_id(page);
+    clear_receive_callbacks(page_id);
+
+    if (_connection == nullptr)
+    {
+        return;
+    }
+
+    JSCContext* context = webkit_frame_get_js_context_for_script_world(frame, world);
+    JSCValue* testudo = jsc_value_new_object(context, nullptr, nullptr);
+
+    JSCValue* send = jsc_value_new_function(context, "send",
+                                            G_CALLBACK(send_function_callback),
+                                            new uint64_t(page_id),
+                                            [](gpointer id) { delete static_cast<uint64_t*>(id); },
+                                            G_TYPE_NONE, 1, JSC_TYPE_VALUE);
+    jsc_value_object_set_property(testudo, "send", send);
+
+    JSCValue* receive = jsc_value_new_function(context, "receive",
+                                               G_CALLBACK(receive_function_callback),
+                                               new uint64_t(page_id),
+                                               [](gpointer id) { delete static_cast<uint64_t*>(id); },
+                                               G_TYPE_NONE, 1, JSC_TYPE_VALUE);
+    jsc_value_object_set_property(testudo, "receive", receive);
+
+    jsc_context_set_value(context, "testudo", testudo);
+
+    g_object_unref(receive);
+    g_object_unref(send);
+    g_object_unref(testudo);
+    g_object_unref(context);
+
+    _connection->send(WebExtensionFrameType::Attach, page_id, nullptr, 0);
+}
+
+/**
+ * @brief Entry point called by WebKit when the web process loads this extension.
+ * @param extension The web extension instance.
+ * @param user_data The address of the UI process socket as a string.
+ */
+extern "C" G_MODULE_EXPORT void webkit_web_extension_initialize_with_user_data(
+    [[maybe_unused]] WebKitWebExtension* extension,
+    const GVariant* user_data)
+{
+    const auto address = g_variant_get_string(const_cast<GVariant*>(user_data), nullptr);
+    GSocketAddress* socket_address = g_unix_socket_address_new_with_type(
+        address, -1, G_UNIX_SOCKET_ADDRESS_ABSTRACT);
+
+    // Connecting to a local socket completes immediately, and nothing can run in the page before this anyway
+    GError* error = nullptr;
+    GSocketClient* client = g_socket_client_new();
+    GSocketConnection* connection = g_socket_client_connect(
+        client, G_SOCKET_CONNECTABLE(socket_address), nullptr, &error);
+
+    if (connection != nullptr)
+    {
+        _connection = new WebExtensionConnection(
+            connection,
+            frame_received_callback,
+            [](WebExtensionConnection* closed)
+            {
+                // The UI process has gone away, so there is nothing left to talk to
+                _connection = nullptr;
+                delete closed;
+            });
+    }
+    else
+    {
+        g_warning("Testudo web extension could not connect to %s: %s", address, error->message);
+        g_error_free(error);
+    }
+
+    g_object_unref(client);
+    g_object_unref(socket_address);
+
+    g_signal_connect(webkit_script_world_get_default(), "window-object-cleared",
+                     G_CALLBACK(window_object_cleared_callback), nullptr);
+}
+
+#endif
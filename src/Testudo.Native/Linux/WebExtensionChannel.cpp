@@ -0,0 +1,235 @@
+#ifdef __linux__
+
+#include "WebExtensionChannel.h"
+#include "TestudoWindow.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <unistd.h>
+#include <gio/gunixsocketaddress.h>
+
+WebExtensionChannel* WebExtensionChannel::_instance = nullptr;
+
+WebExtensionChannel::WebExtensionChannel(std::string address)
+{
+    _address = std::move(address);
+    _service = g_socket_service_new();
+
+    GError* error = nullptr;
+    const auto socket_address = g_unix_socket_address_new_with_type(
+        _address.c_str(), -1, G_UNIX_SOCKET_ADDRESS_ABSTRACT);
+
+    if (!g_socket_listener_add_address(G_SOCKET_LISTENER(_service), socket_address,
+                                       G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT,
+                                       nullptr, nullptr, &error))
+    {
+        g_warning("Testudo web extension channel could not listen on %s: %s", _address.c_str(), error->message);
+        g_error_free(error);
+    }
+
+    g_object_unref(socket_address);
+    g_signal_connect(_service, "incoming", G_CALLBACK(socketServiceIncomingCallback), this);
+    g_socket_service_start(_service);
+}
+
+void WebExtensionChannel::start(WebKitWebContext* context, const String directory)
+{
+    if (_instance != nullptr)
+    {
+        return;
+    }
+
+    // Generate an address that is unique to this process so multiple applications never cross wires
+    std::random_device random;
+    std::ostringstream address;
+    address << "testudo-" << getpid() << "-" << std::hex << random();
+    _instance = new WebExtensionChannel(address.str());
+
+    webkit_web_context_set_web_extensions_directory(context, directory);
+    webkit_web_context_set_web_extensions_initialization_user_data(
+        context, g_variant_new_string(_instance->_address.c_str()));
+}
+
+WebExtensionChannel* WebExtensionChannel::instance()
+{
+    return _instance;
+}
+
+/**
+ * @brief Gets the parent of the given process.
+ * @return The parent's process ID, or 0 if it could not be determined.
+ */
+static pid_t get_parent_process_id(const pid_t process_id)
+{
+    // The parent is the fourth field of the stat file, counted from the end of the executable name in parentheses
+    std::ifstream file("/proc/" + std::to_string(process_id) + "/stat");
+    const std::string stat((std::istreambuf_iterator(file)), std::istreambuf_iterator<char>());
+    const auto name_end = stat.rfind(')');
+    if (name_end == std::string::npos)
+    {
+        return 0;
+    }
+
+    std::istringstream fields(stat.substr(name_end + 1));
+    std::string state;
+    pid_t parent_process_id = 0;
+    fields >> state >> parent_process_id;
+    return fields ? parent_process_id : 0;
+}
+
+bool WebExtensionChannel::isTrustedPeer(GSocketConnection* connection)
+{
+    const auto credentials = g_socket_get_credentials(g_socket_connection_get_socket(connection), nullptr);
+    if (credentials == nullptr)
+    {
+        return false;
+    }
+
+    const auto user_id = g_credentials_get_unix_user(credentials, nullptr);
+    const auto process_id = g_credentials_get_unix_pid(credentials, nullptr);
+    g_object_unref(credentials);
+    if (user_id != getuid() || process_id <= 0)
+    {
+        return false;
+    }
+
+    // Web processes may be started through a sandbox launcher, so they are descendants rather than children
+    constexpr auto max_depth = 8;
+    auto ancestor = process_id;
+    for (auto depth = 0; depth < max_depth && ancestor > 1; depth++)
+    {
+        ancestor = get_parent_process_id(ancestor);
+        if (ancestor == getpid())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Takes ownership of a connection from a newly started web process.
+ * @remarks Connections from anything else are closed straight away.
+ */
+gboolean WebExtensionChannel::socketServiceIncomingCallback(
+    [[maybe_unused]] GSocketService* service,
+    GSocketConnection* connection,
+    [[maybe_unused]] GObject* source_object,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    const auto channel = static_cast<WebExtensionChannel*>(data);
+    if (!isTrustedPeer(connection))
+    {
+        g_warning("Testudo web extension channel refused a connection from an untrusted process.");
+        g_io_stream_close(G_IO_STREAM(connection), nullptr, nullptr);
+        return true;
+    }
+
+    g_object_ref(connection);
+
+    channel->_connections.push_back(std::make_unique<WebExtensionConnection>(
+        connection,
+        [channel](WebExtensionConnection* source, const WebExtensionFrameType type, const uint64_t pageId,
+                  const char* payload, const size_t length)
+        {
+            channel->onFrameReceived(source, type, pageId, payload, length);
+        },
+        [channel](WebExtensionConnection* source)
+        {
+            channel->onClosed(source);
+        }));
+
+    return true;
+}
+
+void WebExtensionChannel::onFrameReceived(WebExtensionConnection* connection,
+                                          const WebExtensionFrameType type,
+                                          const uint64_t pageId,
+                                          const char* data,
+                                          const size_t length)
+{
+    const auto window = _windows.find(pageId);
+    if (window == _windows.end())
+    {
+        return;
+    }
+
+    // A page can only be attached to one connection, and only that connection may speak for it. The page attaches
+    // again after each navigation, which is fine from the same connection. If a process swap moves the page, the old
+    // process' connection closes and detaches it, after which the new process can attach
+    const auto page = _pages.find(pageId);
+    if (type == WebExtensionFrameType::Attach)
+    {
+        if (page != _pages.end() && page->second != connection)
+        {
+            g_warning("Testudo web extension channel refused a second attachment for web page %" G_GUINT64_FORMAT ".",
+                      pageId);
+            return;
+        }
+
+        _pages[pageId] = connection;
+        window->second->setWebProcessId(connection->peerProcessId());
+        return;
+    }
+
+    if (page == _pages.end() || page->second != connection)
+    {
+        return;
+    }
+
+    switch (type)
+    {
+    case WebExtensionFrameType::Text:
+        window->second->dispatchWebMessage(std::string(data, length).c_str());
+        break;
+    case WebExtensionFrameType::Binary:
+        window->second->dispatchWebBinaryMessage(data, length);
+        break;
+    default:
+        break;
+    }
+}
+
+void WebExtensionChannel::onClosed(WebExtensionConnection* connection)
+{
+    // Pages served by the dead process fall back to the message handler until they attach again
+    for (auto page = _pages.begin(); page != _pages.end();)
+    {
+        page = page->second == connection ? _pages.erase(page) : std::next(page);
+    }
+
+    std::erase_if(_connections, [connection](const auto& item) { return item.get() == connection; });
+}
+
+void WebExtensionChannel::registerWindow(const uint64_t pageId, TestudoWindow* window)
+{
+    _windows[pageId] = window;
+}
+
+void WebExtensionChannel::unregisterWindow(const uint64_t pageId)
+{
+    _windows.erase(pageId);
+    _pages.erase(pageId);
+}
+
+bool WebExtensionChannel::send(const uint64_t pageId,
+                               const WebExtensionFrameType type,
+                               const char* data,
+                               const size_t length)
+{
+    const auto page = _pages.find(pageId);
+    if (page == _pages.end())
+    {
+        return false;
+    }
+
+    page->second->send(type, pageId, data, length);
+    return true;
+}
+
+#endif
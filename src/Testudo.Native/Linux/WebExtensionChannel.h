@@ -0,0 +1,103 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <webkit2/webkit2.h>
+
+#include "Testudo.h"
+#include "WebExtensionConnection.h"
+
+class TestudoWindow;
+
+/**
+ * @brief The UI process end of the channel to the Testudo web extension.
+ * @remarks Listens on an abstract Unix socket whose address is passed to each web process when it starts.
+ * Each web process connects once, and frames are routed to windows by web page ID. As any local process can reach an
+ * abstract socket, only connections from web processes spawned by this process are accepted, and each web page can
+ * only be attached to one connection at a time.
+ */
+class WebExtensionChannel
+{
+private:
+    /** The channel for this process, or null if the web extension is not enabled. */
+    static WebExtensionChannel* _instance;
+
+    /** Accepts connections from web processes. */
+    GSocketService* _service;
+
+    /** The abstract socket address that web processes connect to. */
+    std::string _address;
+
+    /** One connection per web process. */
+    std::vector<std::unique_ptr<WebExtensionConnection>> _connections;
+
+    /** The windows that can receive frames, keyed by the ID of their web page. */
+    std::unordered_map<uint64_t, TestudoWindow*> _windows;
+
+    /** The connections that each web page has attached to, keyed by web page ID. */
+    std::unordered_map<uint64_t, WebExtensionConnection*> _pages;
+
+    explicit WebExtensionChannel(std::string address);
+
+    /**
+     * @brief Checks that a connection comes from a web process that this process spawned, running as the same user.
+     */
+    static bool isTrustedPeer(GSocketConnection* connection);
+
+    static gboolean socketServiceIncomingCallback(
+        GSocketService* service,
+        GSocketConnection* connection,
+        GObject* source_object,
+        gpointer data);
+
+    /**
+     * @brief Routes a frame received from a web process to the window that owns the web page.
+     */
+    void onFrameReceived(WebExtensionConnection* connection,
+                         WebExtensionFrameType type,
+                         uint64_t pageId,
+                         const char* data,
+                         size_t length);
+
+    /**
+     * @brief Forgets a connection whose web process has gone away.
+     */
+    void onClosed(WebExtensionConnection* connection);
+
+public:
+    /**
+     * @brief Loads the web extension into every web process created by the given context and begins
+     * listening for connections from them.
+     * @param context The web context to configure. Must not have spawned a web process yet.
+     * @param directory The directory containing the web extension shared object.
+     */
+    static void start(WebKitWebContext* context, String directory);
+
+    /**
+     * @brief Gets the channel for this process.
+     * @return The channel, or null if the web extension is not enabled.
+     */
+    static WebExtensionChannel* instance();
+
+    /**
+     * @brief Allows frames sent from the given web page to be routed to the given window.
+     */
+    void registerWindow(uint64_t pageId, TestudoWindow* window);
+
+    /**
+     * @brief Stops routing frames to and from the given web page.
+     */
+    void unregisterWindow(uint64_t pageId);
+
+    /**
+     * @brief Sends a frame to the given web page.
+     * @return False if the web page has not attached to the channel, in which case nothing was sent.
+     */
+    bool send(uint64_t pageId, WebExtensionFrameType type, const char* data, size_t length);
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifdef __linux__
+
+#include "WebExtensionConnection.h"
+
+#include <cstring>
+#include <utility>
+
+WebExtensionConnection::WebExtensionConnection(GSocketConnection* connection,
+                                               FrameReceivedCallback frameReceived,
+                                               ClosedCallback closed)
+{
+    _connection = connection;
+    _cancellable = g_cancellable_new();
+    _frameReceived = std::move(frameReceived);
+    _closed = std::move(closed);
+    readNext();
+}
+
+WebExtensionConnection::~WebExtensionConnection()
+{
+    // Outstanding callbacks will see the cancellation and return without touching this instance
+    g_cancellable_cancel(_cancellable);
+    g_io_stream_close(G_IO_STREAM(_connection), nullptr, nullptr);
+    g_object_unref(_cancellable);
+    g_object_unref(_connection);
+}
+
+void WebExtensionConnection::readNext()
+{
+    g_input_stream_read_all_async(
+        g_io_stream_get_input_stream(G_IO_STREAM(_connection)),
+        &_header,
+        sizeof(_header),
+        G_PRIORITY_DEFAULT,
+        _cancellable,
+        readHeaderCallback,
+        this);
+}
+
+/**
+ * @brief Completes reading a frame header, then begins reading its payload.
+ */
+void WebExtensionConnection::readHeaderCallback(
+    GObject* source_object,
+    GAsyncResult* result,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    gsize bytes_read = 0;
+    GError* error = nullptr;
+    g_input_stream_read_all_finish(G_INPUT_STREAM(source_object), result, &bytes_read, &error);
+
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        g_error_free(error);
+        return;
+    }
+
+    const auto connection = static_cast<WebExtensionConnection*>(data);
+
+    // A short read means the other end has gone away
+    if (error != nullptr || bytes_read < sizeof(connection->_header)
+        || connection->_header.length > maxFrameLength)
+    {
+        g_clear_error(&error);
+        connection->_closed(connection);
+        return;
+    }
+
+    if (connection->_header.length == 0)
+    {
+        connection->_payload.clear();
+        connection->dispatchFrame();
+        return;
+    }
+
+    connection->_payload.resize(connection->_header.length);
+    g_input_stream_read_all_async(
+        G_INPUT_STREAM(source_object),
+        connection->_payload.data(),
+        connection->_payload.size(),
+        G_PRIORITY_DEFAULT,
+        connection->_cancellable,
+        readPayloadCallback,
+        connection);
+}
+
+/**
+ * @brief Completes reading a frame payload and dispatches the frame.
+ */
+void WebExtensionConnection::readPayloadCallback(
+    GObject* source_object,
+    GAsyncResult* result,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    gsize bytes_read = 0;
+    GError* error = nullptr;
+    g_input_stream_read_all_finish(G_INPUT_STREAM(source_object), result, &bytes_read, &error);
+
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        g_error_free(error);
+        return;
+    }
+
+    const auto connection = static_cast<WebExtensionConnection*>(data);
+
+    if (error != nullptr || bytes_read < connection->_payload.size())
+    {
+        g_clear_error(&error);
+        connection->_closed(connection);
+        return;
+    }
+
+    connection->dispatchFrame();
+}
+
+void WebExtensionConnection::dispatchFrame()
+{
+    // Start reading the next frame first, as the handler is allowed to send frames of its own
+    const auto header = _header;
+    const auto payload = std::move(_payload);
+    readNext();
+
+    _frameReceived(this, static_cast<WebExtensionFrameType>(header.type), header.pageId,
+                    payload.data(), payload.size());
+}
+
+void WebExtensionConnection::send(const WebExtensionFrameType type,
+                                  const uint64_t pageId,
+                                  const char* data,
+                                  const size_t length)
+{
+    WebExtensionFrameHeader header = {};
+    header.type = static_cast<uint32_t>(type);
+    header.length = static_cast<uint32_t>(length);
+    header.pageId = pageId;
+
+    // Write the header and payload as one buffer so frames from different callers never interleave
+    std::string frame;
+    frame.resize(sizeof(header) + length);
+    memcpy(frame.data(), &header, sizeof(header));
+    if (length > 0)
+    {
+        memcpy(frame.data() + sizeof(header), data, length);
+    }
+
+    _writeQueue.push_back(std::move(frame));
+
+    writeNext();
+}
+
+void WebExtensionConnection::writeNext()
+{
+    if (_isWriting || _writeQueue.empty())
+    {
+        return;
+    }
+
+    _isWriting = true;
+    const auto& frame = _writeQueue.front();
+    g_output_stream_write_all_async(
+        g_io_stream_get_output_stream(G_IO_STREAM(_connection)),
+        frame.data(),
+        frame.size(),
+        G_PRIORITY_DEFAULT,
+        _cancellable,
+        writeCallback,
+        this);
+}
+
+/**
+ * @brief Completes writing a frame, then begins writing the next one.
+ */
+void WebExtensionConnection::writeCallback(
+    GObject* source_object,
+    GAsyncResult* result,
+    // ReSharper disable once CppParameterMayBeConst
+    gpointer data)
+{
+    GError* error = nullptr;
+    g_output_stream_write_all_finish(G_OUTPUT_STREAM(source_object), result, nullptr, &error);
+
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+        g_error_free(error);
+        return;
+    }
+
+    const auto connection = static_cast<WebExtensionConnection*>(data);
+    connection->_isWriting = false;
+    connection->_writeQueue.pop_front();
+
+    if (error != nullptr)
+    {
+        // The read side will notice the broken connection and report it
+        g_error_free(error);
+        connection->_writeQueue.clear();
+        return;
+    }
+
+    connection->writeNext();
+}
+
+int WebExtensionConnection::peerProcessId() const
+{
+    const auto credentials = g_socket_get_credentials(g_socket_connection_get_socket(_connection), nullptr);
+    if (credentials == nullptr)
+    {
+        return 0;
+    }
+
+    const auto process_id = g_credentials_get_unix_pid(credentials, nullptr);
+    g_object_unref(credentials);
+    return process_id > 0 ? process_id : 0;
+}
+
+#endif
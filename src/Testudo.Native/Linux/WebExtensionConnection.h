@@ -0,0 +1,145 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <gio/gio.h>
+
+/**
+ * @brief The kinds of frame that can be sent between the UI process and the web extension.
+ */
+enum class WebExtensionFrameType : uint32_t
+{
+    /** Sent by the web extension when a page's window object is created and the channel can be used. */
+    Attach = 0,
+
+    /** A UTF-8 text message. */
+    Text = 1,
+
+    /** An opaque binary message. */
+    Binary = 2
+};
+
+/**
+ * @brief The fixed-size header that precedes every frame on the channel.
+ */
+struct WebExtensionFrameHeader
+{
+    /** The @ref WebExtensionFrameType of the frame. */
+    uint32_t type;
+
+    /** The size of the payload that follows the header in bytes. */
+    uint32_t length;
+
+    /** The ID of the web page that the frame was sent from or is addressed to. */
+    uint64_t pageId;
+};
+
+/**
+ * @brief A framed, bidirectional stream between the UI process and a web process.
+ * @remarks Used by both sides of the channel. All reads and writes are asynchronous and complete on the
+ * thread-default main context, so no method of this class ever blocks.
+ */
+class WebExtensionConnection
+{
+public:
+    /**
+     * @brief Handles a frame received from the other end of the connection.
+     * @remarks The payload is only valid for the duration of the call.
+     */
+    using FrameReceivedCallback = std::function<void(
+        WebExtensionConnection* connection,
+        WebExtensionFrameType type,
+        uint64_t pageId,
+        const char* data,
+        size_t length)>;
+
+    /**
+     * @brief Handles the other end of the connection closing.
+     * @remarks The connection may be deleted from within this callback.
+     */
+    using ClosedCallback = std::function<void(WebExtensionConnection* connection)>;
+
+    /** The largest payload that will be accepted, to guard against a corrupt stream. */
+    static constexpr uint32_t maxFrameLength = 64 * 1024 * 1024;
+
+private:
+    /** The underlying socket connection. */
+    GSocketConnection* _connection;
+
+    /** Cancels outstanding operations when this connection is destroyed. */
+    GCancellable* _cancellable;
+
+    /** Handles received frames. */
+    FrameReceivedCallback _frameReceived;
+
+    /** Handles the connection closing. */
+    ClosedCallback _closed;
+
+    /** The header of the frame currently being read. */
+    WebExtensionFrameHeader _header = {};
+
+    /** The payload of the frame currently being read. */
+    std::string _payload;
+
+    /** Frames that are waiting to be written, including their headers. */
+    std::deque<std::string> _writeQueue;
+
+    /** Whether a write is currently in progress. */
+    bool _isWriting = false;
+
+    static void readHeaderCallback(GObject* source_object, GAsyncResult* result, gpointer data);
+
+    static void readPayloadCallback(GObject* source_object, GAsyncResult* result, gpointer data);
+
+    static void writeCallback(GObject* source_object, GAsyncResult* result, gpointer data);
+
+    /**
+     * @brief Begins reading the next frame header.
+     */
+    void readNext();
+
+    /**
+     * @brief Begins writing the next queued frame if no write is in progress.
+     */
+    void writeNext();
+
+    /**
+     * @brief Passes the frame that has just been read to @ref _frameReceived, then reads the next one.
+     */
+    void dispatchFrame();
+
+public:
+    /**
+     * @brief Takes ownership of the given connection and begins reading frames from it.
+     * @param connection The connected socket.
+     * @param frameReceived Handles received frames.
+     * @param closed Handles the connection closing.
+     */
+    WebExtensionConnection(GSocketConnection* connection, FrameReceivedCallback frameReceived, ClosedCallback closed);
+
+    /**
+     * @brief Cancels outstanding operations and closes the connection.
+     */
+    ~WebExtensionConnection();
+
+    /**
+     * @brief Queues a frame to be written to the connection.
+     * @param type The kind of frame.
+     * @param pageId The ID of the web page that the frame relates to.
+     * @param data The payload.
+     * @param length The size of the payload in bytes.
+     */
+    void send(WebExtensionFrameType type, uint64_t pageId, const char* data, size_t length);
+
+    /**
+     * @brief Gets the ID of the web process on the other end of the connection from the socket's credentials.
+     * @return The process ID, or 0 if the credentials could not be read.
+     */
+    [[nodiscard]] int peerProcessId() const;
+};
+
+#endif
@@ -0,0 +1,140 @@
+#ifdef __linux__
+
+#include "WebViewEnvironment.h"
+#include "TestudoWindow.h"
+
+GtkWidget* WebViewEnvironment::_warmWebView = nullptr;
+WebKitWebContext* WebViewEnvironment::_context = nullptr;
+
+// ReSharper disable once CppParameterMayBeConst
+void WebViewEnvironment::uriSchemeRequestCallback(WebKitURISchemeRequest* request, [[maybe_unused]] gpointer data)
+{
+    const auto web_view = webkit_uri_scheme_request_get_web_view(request);
+    if (const auto window = static_cast<TestudoWindow*>(getWindow(web_view)); window != nullptr)
+    {
+        window->handleUriSchemeRequest(request);
+        return;
+    }
+
+    // The warm web view does not request anything from the application until a window adopts it
+    const auto error = g_error_new_literal(G_IO_ERROR, G_IO_ERROR_NOT_FOUND, "No window is serving this web view.");
+    webkit_uri_scheme_request_finish_error(request, error);
+    g_error_free(error);
+}
+
+GtkWidget* WebViewEnvironment::createColdWebView()
+{
+    const auto content_manager = webkit_user_content_manager_new();
+    const auto web_view = GTK_WIDGET(g_object_new(WEBKIT_TYPE_WEB_VIEW,
+                                                  "web-context", _context,
+                                                  "user-content-manager", content_manager,
+                                                  nullptr));
+    g_object_ref_sink(web_view);
+    g_object_unref(content_manager);
+
+    // Setup interop script
+    const auto script = webkit_user_script_new(
+        "window.__receiveMessageCallbacks = [];"
+        "window.__dispatchMessageCallback = function(message) {"
+        "	window.__receiveMessageCallbacks.forEach(function(callback) { callback(message); });"
+        "};"
+        "window.external = {"
+        "	sendMessage: function(message) {"
+        "		if (window.testudo) {"
+        "			window.testudo.send(message);"
+        "		} else {"
+        "			window.webkit.messageHandlers.visium.postMessage(message);"
+        "		}"
+        "	},"
+        "	receiveMessage: function(callback) {"
+        "		window.__receiveMessageCallbacks.push(callback);"
+        "		if (window.testudo) {"
+        "			window.testudo.receive(callback);"
+        "		}"
+        "	}"
+        "};",
+        WEBKIT_USER_CONTENT_INJECT_ALL_FRAMES,
+        WEBKIT_USER_SCRIPT_INJECT_AT_DOCUMENT_START, nullptr, nullptr);
+
+    webkit_user_content_manager_add_script(content_manager, script);
+    webkit_user_script_unref(script);
+
+    return web_view;
+}
+
+WebKitWebContext* WebViewEnvironment::createContext(const TestudoApplicationConfiguration* configuration)
+{
+    if (configuration->dataDirectory == nullptr)
+    {
+        _context = webkit_web_context_get_default();
+        return _context;
+    }
+
+    // Keep the disk and bytecode caches, along with local storage and the like, where the next run will find them
+    const auto data_directory = g_build_filename(configuration->dataDirectory, "data", nullptr);
+    const auto cache_directory = g_build_filename(configuration->dataDirectory, "cache", nullptr);
+    const auto data_manager = webkit_website_data_manager_new("base-data-directory", data_directory,
+                                                              "base-cache-directory", cache_directory,
+                                                              nullptr);
+    _context = webkit_web_context_new_with_website_data_manager(data_manager);
+    webkit_web_context_set_cache_model(_context, WEBKIT_CACHE_MODEL_DOCUMENT_BROWSER);
+
+    g_object_unref(data_manager);
+    g_free(cache_directory);
+    g_free(data_directory);
+    return _context;
+}
+
+void WebViewEnvironment::start(const TestudoApplicationConfiguration* configuration)
+{
+    // Every window's web view shares the same context, so the scheme is registered once for all of them
+    const auto context = _context;
+    webkit_web_context_register_uri_scheme(context, "app", uriSchemeRequestCallback, nullptr, nullptr);
+
+    if (configuration->isWebViewPrewarmEnabled)
+    {
+        // Spawn a web process now, and load a page in it so that its JavaScript engine is initialized by the time
+        // the first window adopts it
+        webkit_web_context_prewarm(context);
+        _warmWebView = createColdWebView();
+        webkit_web_view_load_uri(WEBKIT_WEB_VIEW(_warmWebView), "about:blank");
+    }
+}
+
+void WebViewEnvironment::stop()
+{
+    if (_warmWebView != nullptr)
+    {
+        gtk_widget_destroy(_warmWebView);
+        g_object_unref(_warmWebView);
+        _warmWebView = nullptr;
+    }
+
+    // The default context belongs to WebKit
+    if (_context != nullptr && _context != webkit_web_context_get_default())
+    {
+        g_object_unref(_context);
+    }
+
+    _context = nullptr;
+}
+
+GtkWidget* WebViewEnvironment::createWebView(void* window)
+{
+    auto web_view = _warmWebView;
+    _warmWebView = nullptr;
+    if (web_view == nullptr)
+    {
+        web_view = createColdWebView();
+    }
+
+    g_object_set_data(G_OBJECT(web_view), windowDataKey, window);
+    return web_view;
+}
+
+void* WebViewEnvironment::getWindow(WebKitWebView* webView)
+{
+    return webView == nullptr ? nullptr : g_object_get_data(G_OBJECT(webView), windowDataKey);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <gtk/gtk.h>
+#include <webkit2/webkit2.h>
+
+#include "TestudoApplicationConfiguration.h"
+
+/**
+ * @brief Configures the web context that is shared by every window in the application.
+ * @remarks The context is set up as soon as the application is created, rather than by the first window. If
+ * prewarming is enabled, a web process is spawned straight away and a web view is loaded in it, which the first
+ * window adopts instead of waiting for a web process of its own. Must only be used from the main thread.
+ */
+class WebViewEnvironment
+{
+private:
+    /** The key that each web view's @ref TestudoWindow is stored under, so scheme requests can be routed to it. */
+    static constexpr auto windowDataKey = "testudo-window";
+
+    /** A web view that has already been loaded in a web process, or null if there is none. */
+    static GtkWidget* _warmWebView;
+
+    /** The web context that every web view is created in. */
+    static WebKitWebContext* _context;
+
+    /**
+     * @brief Passes an app:// request to the window whose web view made it.
+     */
+    static void uriSchemeRequestCallback(WebKitURISchemeRequest* request, gpointer data);
+
+    /**
+     * @brief Creates a web view with the interop script installed.
+     * @returns A new web view that the caller holds a reference to.
+     */
+    static GtkWidget* createColdWebView();
+
+    /**
+     * @brief Gets the window that app:// requests from the given web view are routed to.
+     * @param webView The web view.
+     * @returns The window passed to @ref createWebView, or null if the web view does not belong to one.
+     */
+    static void* getWindow(WebKitWebView* webView);
+
+public:
+    /**
+     * @brief Creates the shared web context, keeping its data and caches in the configured data directory.
+     * @param configuration The application configuration.
+     * @returns The context, which is used by every web view.
+     * @remarks Must be called before anything else uses the context, such as the web extension.
+     */
+    static WebKitWebContext* createContext(const TestudoApplicationConfiguration* configuration);
+
+    /**
+     * @brief Configures the shared web context, and starts warming it up if prewarming is enabled.
+     * @param configuration The application configuration.
+     * @remarks Must be called after the web extension has been configured, as it may spawn a web process.
+     */
+    static void start(const TestudoApplicationConfiguration* configuration);
+
+    /**
+     * @brief Releases the warm web view, if it was never adopted.
+     */
+    static void stop();
+
+    /**
+     * @brief Gets a web view for a new window, adopting the warm web view if there is one.
+     * @param window The window that app:// requests from the web view are routed to.
+     * @returns A web view with the interop script installed, that the caller holds a reference to.
+     */
+    static GtkWidget* createWebView(void* window);
+};
+
+#endif
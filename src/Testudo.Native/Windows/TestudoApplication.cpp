@@ -2,19 +2,31 @@
 
 #include "TestudoApplication.h"
 #include "TestudoApplicationConfiguration.h"
+#include "WebViewEnvironment.h"
 #include "WindowsHelper.h"
+#include "../Common/FileDialogRequest.h"
+#include "../Common/StallWatchdog.h"
+#include "../Common/StartupProfiler.h"
+#include "../Common/WindowEventQueue.h"
 
 #include <comdef.h>
 #include <format>
 #include <windows.h>
-#include <ShObjIdl.h>
 
 /** Handle to the system tray icon hidden window that represents this application. */
 HWND _processWindow;
 
+/** The callback that receives the results of native file dialogs. */
+FileDialogCompletedDelegate _fileDialogCompletedHandler;
+
 TestudoApplication::TestudoApplication(const TestudoApplicationConfiguration* pConfiguration)
 {
+    StartupProfiler::setHandler(pConfiguration->startupCompletedHandler);
+    StartupProfiler::mark(StartupPhase::ApplicationCreating);
+
     const auto hInstance = GetModuleHandle(nullptr);
+    _fileDialogCompletedHandler = pConfiguration->fileDialogCompletedHandler;
+    WindowEventQueue::setHandler(pConfiguration->windowEventsHandler);
 
     // Generate the class name
     std::wstringstream stream;
@@ -32,6 +44,10 @@ TestudoApplication::TestudoApplication(const TestudoApplicationConfiguration* pC
     _processWindow = CreateWindowEx(0, className.c_str(), pConfiguration->applicationName,
                                    0, 0, 0, 0, 0,
                                    HWND_MESSAGE, nullptr, hInstance, nullptr);
+    StartupProfiler::mark(StartupPhase::ToolkitInitialized);
+
+    // Start the browser process now if requested, so that it overlaps with the rest of startup
+    WebViewEnvironment::start(pConfiguration);
 
     // Create the system tray notification
     NOTIFYICONDATA notification = {};
@@ -46,6 +62,15 @@ TestudoApplication::TestudoApplication(const TestudoApplicationConfiguration* pC
     memcpy_s(notification.szTip, sizeof(notification.szTip),
              pConfiguration->applicationName, wcslen(pConfiguration->applicationName) * sizeof(wchar_t));
     Shell_NotifyIcon(NIM_ADD, &notification);
+
+    // Drive the stall watchdog's heartbeat from the main message loop
+    StallWatchdog::start(pConfiguration->stallThresholdMilliseconds, pConfiguration->stallDetectedHandler);
+    if (const auto interval = StallWatchdog::heartbeatIntervalMilliseconds(); interval > 0)
+    {
+        SetTimer(_processWindow, STALL_HEARTBEAT_TIMER_ID, interval, nullptr);
+    }
+
+    StartupProfiler::mark(StartupPhase::ApplicationCreated);
 }
 
 TestudoApplication::~TestudoApplication()
@@ -57,6 +82,12 @@ TestudoApplication::~TestudoApplication()
     notification.uID = 1;
     Shell_NotifyIcon(NIM_DELETE, &notification);
 
+    // Stop the watchdog before the message loop goes away so it does not report the shutdown as a stall
+    KillTimer(_processWindow, STALL_HEARTBEAT_TIMER_ID);
+    StallWatchdog::stop();
+
+    WebViewEnvironment::stop();
+
     // Destroy the message-only window
     DestroyWindow(_processWindow);
 }
@@ -71,10 +102,11 @@ void TestudoApplication::run()
     }
 }
 
-void TestudoApplication::invoke(Action action)
+void TestudoApplication::invoke(Action action, String tag)
 {
     // Post the message to the invisible window's message queue
     Invocation invocation = {};
+    invocation.tag = tag;
     PostMessage(_processWindow,
                 WM_USER_INVOKE,
                 reinterpret_cast<WPARAM>(action),
@@ -85,77 +117,19 @@ void TestudoApplication::invoke(Action action)
     invocation.completion.wait(lock, [&] { return invocation.isCompleted; });
 }
 
-String TestudoApplication::openFolderDialog()
+void TestudoApplication::beginInvoke(std::function<void()> action)
 {
-    String result = nullptr;
-    IFileDialog* pFileDialog = nullptr;
-    
-    HRESULT hr = CoCreateInstance(CLSID_FileOpenDialog, nullptr, CLSCTX_ALL,
-        IID_IFileOpenDialog, reinterpret_cast<void**>(&pFileDialog));
-
-    if (SUCCEEDED(hr))
-    {
-        DWORD dwOptions;
-        hr = pFileDialog->GetOptions(&dwOptions);
-        
-        if (SUCCEEDED(hr))
-        {
-            hr = pFileDialog->SetOptions(dwOptions | FOS_PICKFOLDERS);
-            
-            if (SUCCEEDED(hr))
-            {
-                hr = pFileDialog->Show(_processWindow);
-                
-                if (SUCCEEDED(hr))
-                {
-                    IShellItem* pItem;
-                    hr = pFileDialog->GetResult(&pItem);
-                    
-                    if (SUCCEEDED(hr))
-                    {
-                        PWSTR pszFilePath = nullptr;
-                        hr = pItem->GetDisplayName(SIGDN_FILESYSPATH, &pszFilePath);
-                        
-                        if (SUCCEEDED(hr))
-                        {
-                            result = pszFilePath;
-                            CoTaskMemFree(pszFilePath);
-                        }
-                        else
-                        {
-                            DISPLAY_ERROR(hr);
-                        }
-                        
-                        pItem->Release();
-                    }
-                    else
-                    {
-                        DISPLAY_ERROR(hr);
-                    }
-                }
-                else if (hr != HRESULT_FROM_WIN32(ERROR_CANCELLED))
-                {
-                    DISPLAY_ERROR(hr);
-                }
-            }
-            else
-            {
-                DISPLAY_ERROR(hr);
-            }
-        }
-        else
-        {
-            DISPLAY_ERROR(hr);
-        }
-        
-        pFileDialog->Release();
-    }
-    else
-    {
-        DISPLAY_ERROR(hr);
-    }
+    // The window procedure takes ownership of the action and deletes it once it has run
+    PostMessage(_processWindow, WM_USER_BEGIN_INVOKE, 0,
+                reinterpret_cast<LPARAM>(new std::function(std::move(action))));
+}
 
-    return result;
+void TestudoApplication::showFileDialog(const int requestId, const FileDialogOptions* options)
+{
+    // The common item dialogs are modal, but their nested loop still dispatches messages to the other windows
+    // and invocations, so the dialog is shown from the main loop and the caller returns immediately
+    const auto request = new FileDialogRequest(requestId, options, _fileDialogCompletedHandler);
+    PostMessage(_processWindow, WM_USER_FILE_DIALOG, 0, reinterpret_cast<LPARAM>(request));
 }
 
 #endif
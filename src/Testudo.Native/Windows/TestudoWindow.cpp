@@ -1,12 +1,17 @@
 #if _WIN32
 
 #include "TestudoWindow.h"
+#include "WebViewEnvironment.h"
 #include "WindowsHelper.h"
+#include "../Common/LatencyTracer.h"
+#include "../Common/StallWatchdog.h"
+#include "../Common/StartupProfiler.h"
+#include "../Common/WindowEventQueue.h"
 
 #include <comdef.h>
 #include <dwmapi.h>
 #include <shlwapi.h>
-#include <WebView2EnvironmentOptions.h>
+#include <wil/resource.h>
 #include <windows.h>
 #include <wrl.h>
 
@@ -29,11 +34,14 @@ HRESULT TestudoWindow::webMessageReceivedHandler(
     ICoreWebView2* sender,
     ICoreWebView2WebMessageReceivedEventArgs* args)
 {
+    LatencyTracer::messageReceived();
+
     // Get the message
     wil::unique_cotaskmem_string message;
     CHECK_HRESULT(args->TryGetWebMessageAsString(&message));
 
     // Pass the message back to managed code
+    StallWatchdog::ActivityScope activity(StallActivityKind::WebMessage, message.get());
     _configuration->webMessageReceivedHandler(this, message.get());
 
     return S_OK;
@@ -51,19 +59,60 @@ HRESULT TestudoWindow::webResourceRequestedHandler(
     wil::unique_cotaskmem_string uri;
     CHECK_HRESULT(request->get_Uri(&uri));
 
+    // Pass along the entity tag of the copy that the browser has cached, if it has one
+    wil::unique_cotaskmem_string ifNoneMatch;
+    wil::com_ptr<ICoreWebView2HttpRequestHeaders> requestHeaders;
+    BOOL hasIfNoneMatch = FALSE;
+    if (SUCCEEDED(request->get_Headers(&requestHeaders))
+        && SUCCEEDED(requestHeaders->Contains(L"If-None-Match", &hasIfNoneMatch)) && hasIfNoneMatch)
+    {
+        requestHeaders->GetHeader(L"If-None-Match", &ifNoneMatch);
+    }
+
     // Pass the request back to managed code
     int sizeBytes;
     String contentType;
+    String entityTag = nullptr;
+    StartupProfiler::markResourceRequested(uri.get());
+    StallWatchdog::ActivityScope activity(StallActivityKind::ResourceRequest, uri.get());
     const wil::unique_cotaskmem data(_configuration->
-        webResourceRequestedHandler(this, uri.get(), &sizeBytes, &contentType));
+        webResourceRequestedHandler(this, uri.get(), ifNoneMatch.get(), &sizeBytes, &contentType, &entityTag));
+    const wil::unique_hlocal entityTagOwner(const_cast<wchar_t*>(entityTag));
+
+    // Responses carry their entity tag, and must be revalidated so that a changed resource is never missed
+    std::wstring validatorHeaders;
+    if (entityTag != nullptr)
+    {
+        validatorHeaders = L"ETag: " + std::wstring(entityTag) + L"\r\nCache-Control: no-cache";
+    }
+
+    // The browser's cached copy is still current, so there is nothing to send
+    if (data == nullptr && entityTag != nullptr)
+    {
+        wil::com_ptr<ICoreWebView2WebResourceResponse> response;
+        CHECK_HRESULT(_webViewEnvironment->CreateWebResourceResponse(
+            nullptr, 304, L"Not Modified", validatorHeaders.c_str(), &response));
+        CHECK_HRESULT(args->put_Response(response.get()));
+        return S_OK;
+    }
 
     // Create the response object from the resulting resource
     if (data != nullptr && contentType != nullptr)
     {
         const auto stream = SHCreateMemStream(static_cast<BYTE*>(data.get()), sizeBytes);
-        const auto type = L"Content-Type: " + std::wstring(contentType);
+
+        // The stream takes a copy and the buffer is freed when this handler returns, so it is never held past here
+        _memory->resourceServed(sizeBytes);
+        _memory->resourceReleased(sizeBytes);
+
+        auto headers = L"Content-Type: " + std::wstring(contentType);
+        if (!validatorHeaders.empty())
+        {
+            headers += L"\r\n" + validatorHeaders;
+        }
+
         wil::com_ptr<ICoreWebView2WebResourceResponse> response;
-        CHECK_HRESULT(_webViewEnvironment->CreateWebResourceResponse(stream, 200, L"OK", type.c_str(), &response));
+        CHECK_HRESULT(_webViewEnvironment->CreateWebResourceResponse(stream, 200, L"OK", headers.c_str(), &response));
         CHECK_HRESULT(args->put_Response(response.get()));
     }
 
@@ -74,8 +123,21 @@ HRESULT TestudoWindow::createCoreWebView2ControllerHandler(
     HRESULT errorCode,
     ICoreWebView2Controller* createdController)
 {
+    // Report the outcome to the caller of showAsync however this handler returns
+    auto isInitialized = false;
+    const auto creationReporter = wil::scope_exit([this, &isInitialized] { completeCreation(isInitialized); });
+
+    CHECK_HRESULT(errorCode);
     webviewController = createdController;
     CHECK_HRESULT(webviewController->get_CoreWebView2(&_webView));
+    StartupProfiler::mark(StartupPhase::WebViewCreated);
+
+    // WebView2 does not expose the renderer process of a single view, so report the browser process it belongs to
+    UINT32 browserProcessId;
+    if (SUCCEEDED(_webView->get_BrowserProcessId(&browserProcessId)))
+    {
+        _memory->setWebProcessId(static_cast<int>(browserProcessId));
+    }
 
     // Enable dev tools
     if (_configuration->areDevToolsEnabled)
@@ -90,6 +152,12 @@ HRESULT TestudoWindow::createCoreWebView2ControllerHandler(
     GetClientRect(_hWnd, &bounds);
     CHECK_HRESULT(webviewController->put_Bounds(bounds));
 
+    // Stop the web view from rendering and compositing, scripts and the app:// scheme carry on as usual
+    if (_configuration->isOffscreen)
+    {
+        CHECK_HRESULT(webviewController->put_IsVisible(false));
+    }
+
     // Setup interop script
     CHECK_HRESULT(_webView->AddScriptToExecuteOnDocumentCreated(
         L"window.external = { "
@@ -102,6 +170,12 @@ HRESULT TestudoWindow::createCoreWebView2ControllerHandler(
         "};",
         nullptr));
 
+    // Stamp interactions in the page, wrapping the interop script above
+    if (_configuration->isLatencyTracingEnabled)
+    {
+        CHECK_HRESULT(_webView->AddScriptToExecuteOnDocumentCreated(LatencyTracer::script, nullptr));
+    }
+
     // Specify that all URIs should be intercepted and passed to webResourceRequestedHandler
     CHECK_HRESULT(_webView->AddWebResourceRequestedFilter(L"*", COREWEBVIEW2_WEB_RESOURCE_CONTEXT_ALL));
 
@@ -112,9 +186,33 @@ HRESULT TestudoWindow::createCoreWebView2ControllerHandler(
     CHECK_HRESULT(_webView->add_WebResourceRequested(Callback<ICoreWebView2WebResourceRequestedEventHandler>
         (this, &TestudoWindow::webResourceRequestedHandler).Get(), &token));
 
-    // Navigate to the startup page
-    CHECK_HRESULT(_webView->Navigate(_configuration->initialUri));
+    // Stamp the navigation phases of startup
+    CHECK_HRESULT(_webView->add_NavigationStarting(Callback<ICoreWebView2NavigationStartingEventHandler>(
+        [](ICoreWebView2*, ICoreWebView2NavigationStartingEventArgs*) -> HRESULT
+        {
+            StartupProfiler::mark(StartupPhase::NavigationStarted);
+            return S_OK;
+        }).Get(), &token));
+    CHECK_HRESULT(_webView->add_ContentLoading(Callback<ICoreWebView2ContentLoadingEventHandler>(
+        [](ICoreWebView2*, ICoreWebView2ContentLoadingEventArgs*) -> HRESULT
+        {
+            StartupProfiler::mark(StartupPhase::NavigationCommitted);
+            return S_OK;
+        }).Get(), &token));
+    CHECK_HRESULT(_webView->add_NavigationCompleted(Callback<ICoreWebView2NavigationCompletedEventHandler>(
+        [](ICoreWebView2*, ICoreWebView2NavigationCompletedEventArgs*) -> HRESULT
+        {
+            StartupProfiler::mark(StartupPhase::NavigationFinished);
+            return S_OK;
+        }).Get(), &token));
+
+    // Navigate to the startup page, unless the caller of showAsync will do so once it is ready to serve it
+    if (!_createRequestId.has_value())
+    {
+        CHECK_HRESULT(_webView->Navigate(_configuration->initialUri));
+    }
 
+    isInitialized = true;
     return S_OK;
 }
 
@@ -122,6 +220,17 @@ HRESULT TestudoWindow::createCoreWebView2EnvironmentHandler(
     HRESULT errorCode,
     ICoreWebView2Environment* createdEnvironment)
 {
+    // The controller handler reports the outcome from here on, so only failures before then are reported here
+    auto isControllerRequested = false;
+    const auto creationReporter = wil::scope_exit([this, &isControllerRequested]
+    {
+        if (!isControllerRequested)
+        {
+            completeCreation(false);
+        }
+    });
+
+    CHECK_HRESULT(errorCode);
     _webViewEnvironment = createdEnvironment;
 
     // Create the web view controller
@@ -129,12 +238,22 @@ HRESULT TestudoWindow::createCoreWebView2EnvironmentHandler(
         Callback<ICoreWebView2CreateCoreWebView2ControllerCompletedHandler>
         (this, &TestudoWindow::createCoreWebView2ControllerHandler).Get()));
 
+    isControllerRequested = true;
     return S_OK;
 }
 
 TestudoWindow::TestudoWindow(const TestudoWindowConfiguration* configuration): ITestudoWindow(configuration)
 {
+    StartupProfiler::mark(StartupPhase::WindowCreating);
     _configuration = configuration;
+    _scriptRequests = std::make_shared<ScriptRequestTable>(this, configuration->scriptEvaluatedHandler);
+    _memory = std::make_shared<MemoryAccounting::Counters>();
+    if (configuration->messageRingCapacity > 0)
+    {
+        _messageRing = std::make_shared<MessageRingBuffer>(configuration->messageRingCapacity,
+                                                           [this](const String message) { sendMessage(message); });
+    }
+
     const auto hInstance = GetModuleHandle(nullptr);
     const auto className = generateClassName();
 
@@ -151,10 +270,12 @@ TestudoWindow::TestudoWindow(const TestudoWindowConfiguration* configuration): I
     CHECK_WIN32_ERROR(RegisterClassEx(&windowClass));
 
     // Create the window
-    _hWnd = CreateWindowEx(0,
+    // Offscreen windows are kept out of the taskbar and can never be activated, as they are never shown
+    const auto hasWindowShell = configuration->hasWindowShell && !configuration->isOffscreen;
+    _hWnd = CreateWindowEx(configuration->isOffscreen ? WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE : 0,
                            className.c_str(),
                            configuration->title,
-                           configuration->hasWindowShell ? WS_OVERLAPPEDWINDOW : WS_POPUP,
+                           hasWindowShell ? WS_OVERLAPPEDWINDOW : WS_POPUP,
                            configuration->left,
                            configuration->top,
                            configuration->width,
@@ -169,26 +290,62 @@ TestudoWindow::TestudoWindow(const TestudoWindowConfiguration* configuration): I
     // Set dark mode on Windows 10+ to prevent title bar going white when window loses focus
     int state = 1;
     DISPLAY_HRESULT(DwmSetWindowAttribute(_hWnd, DWMWA_USE_IMMERSIVE_DARK_MODE, &state, sizeof(int)));
+    StartupProfiler::mark(StartupPhase::WindowCreated);
 }
 
 TestudoWindow::~TestudoWindow()
 {
+    _scriptRequests->close(L"The window was destroyed before the script finished evaluating.");
     DestroyWindow(_hWnd);
+
+    // Destroying the window deactivates and hides it, so only drop its events once that has been reported
+    WindowEventQueue::removeWindow(this);
+}
+
+void TestudoWindow::completeCreation(const bool isSuccess)
+{
+    if (_createRequestId.has_value())
+    {
+        const auto requestId = *_createRequestId;
+        _createRequestId.reset();
+
+        if (_configuration->windowCreatedHandler != nullptr)
+        {
+            _configuration->windowCreatedHandler(requestId, this, isSuccess);
+        }
+    }
 }
 
 void TestudoWindow::show()
 {
     // Show the window
-    ShowWindow(_hWnd, SW_SHOWDEFAULT);
-    UpdateWindow(_hWnd);
+    if (!_configuration->isOffscreen)
+    {
+        ShowWindow(_hWnd, SW_SHOWDEFAULT);
+        UpdateWindow(_hWnd);
+    }
+
+    // Create the web view in the shared environment, which may already be warm if it was started with the application
+    WebViewEnvironment::getAsync([this](const HRESULT errorCode, ICoreWebView2Environment* environment)
+    {
+        return createCoreWebView2EnvironmentHandler(errorCode, environment);
+    });
+}
 
-    // Create the web view
-    const auto options = Make<CoreWebView2EnvironmentOptions>();
-    const auto arguments = _configuration->areDevToolsEnabled ? L"--force-devtools-available" : L"--kiosk";
-    DISPLAY_HRESULT(options->put_AdditionalBrowserArguments(arguments));
-    DISPLAY_HRESULT(CreateCoreWebView2EnvironmentWithOptions(nullptr, nullptr, options.Get(),
-        Callback<ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler>
-            (this, &TestudoWindow::createCoreWebView2EnvironmentHandler).Get()));
+void TestudoWindow::showAsync(const int requestId)
+{
+    _createRequestId = requestId;
+    show();
+}
+
+void TestudoWindow::activate() const
+{
+    if (IsIconic(_hWnd))
+    {
+        ShowWindow(_hWnd, SW_RESTORE);
+    }
+
+    SetForegroundWindow(_hWnd);
 }
 
 void TestudoWindow::navigate(const String uri) const
@@ -201,6 +358,122 @@ void TestudoWindow::sendMessage(const String message) const
     DISPLAY_HRESULT(_webView->PostWebMessageAsString(message));
 }
 
+void TestudoWindow::broadcast(TestudoWindow* const* windows, const int count, const String message)
+{
+    for (auto i = 0; i < count; i++)
+    {
+        // Anything already in the window's ring was sent first, so it must be delivered first
+        windows[i]->drainMessages();
+        windows[i]->sendMessage(message);
+    }
+}
+
+void TestudoWindow::executeScript(const int requestId, const String script)
+{
+    if (!_scriptRequests->add(requestId))
+    {
+        _scriptRequests->reject(requestId,
+                                L"The window has been destroyed, or the request is already in flight.");
+        return;
+    }
+
+    if (_webView == nullptr)
+    {
+        _scriptRequests->complete(requestId, false, L"The web view has not been initialized yet.");
+        return;
+    }
+
+    // Capture the table rather than this window so late results are discarded safely after destruction
+    HRESULT hr;
+    if (const auto webView21 = _webView.try_query<ICoreWebView2_21>())
+    {
+        // ExecuteScript reports a script that throws as a successful "null", so prefer the variant that surfaces
+        // the exception when the runtime supports it
+        hr = webView21->ExecuteScriptWithResult(script, Callback<ICoreWebView2ExecuteScriptWithResultCompletedHandler>(
+            [requestTable = _scriptRequests, requestId](const HRESULT errorCode,
+                                                        ICoreWebView2ExecuteScriptResult* result)
+            {
+                if (FAILED(errorCode))
+                {
+                    const _com_error error(errorCode);
+                    requestTable->complete(requestId, false, error.ErrorMessage());
+                    return S_OK;
+                }
+
+                BOOL succeeded = FALSE;
+                wil::unique_cotaskmem_string resultJson;
+                if (SUCCEEDED(result->get_Succeeded(&succeeded)) && succeeded &&
+                    SUCCEEDED(result->get_ResultAsJson(&resultJson)))
+                {
+                    requestTable->complete(requestId, true, resultJson.get());
+                    return S_OK;
+                }
+
+                wil::com_ptr<ICoreWebView2ScriptException> exception;
+                wil::unique_cotaskmem_string message;
+                if (SUCCEEDED(result->get_Exception(&exception)) && exception != nullptr &&
+                    SUCCEEDED(exception->get_Message(&message)) && message != nullptr && *message.get() != L'\0')
+                {
+                    requestTable->complete(requestId, false, message.get());
+                }
+                else
+                {
+                    requestTable->complete(requestId, false, L"The script threw an exception.");
+                }
+
+                return S_OK;
+            }).Get());
+    }
+    else
+    {
+        hr = _webView->ExecuteScript(script, Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+            [requestTable = _scriptRequests, requestId](const HRESULT errorCode, const LPCWSTR resultObjectAsJson)
+            {
+                if (SUCCEEDED(errorCode))
+                {
+                    requestTable->complete(requestId, true, resultObjectAsJson);
+                }
+                else
+                {
+                    const _com_error error(errorCode);
+                    requestTable->complete(requestId, false, error.ErrorMessage());
+                }
+
+                return S_OK;
+            }).Get());
+    }
+
+    if (FAILED(hr))
+    {
+        const _com_error error(hr);
+        _scriptRequests->complete(requestId, false, error.ErrorMessage());
+    }
+}
+
+void TestudoWindow::getMemoryReport(MemoryReport* report) const
+{
+    _memory->fill(report);
+    report->pendingScriptCount = static_cast<int>(_scriptRequests->size());
+}
+
+MessageRing* TestudoWindow::getMessageRing() const
+{
+    return _messageRing != nullptr ? _messageRing->ring() : nullptr;
+}
+
+void TestudoWindow::ringMessageDoorbell() const
+{
+    MessageRingBuffer::scheduleDrain(_messageRing);
+}
+
+void TestudoWindow::drainMessages() const
+{
+    if (_messageRing != nullptr)
+    {
+        _messageRing->drain();
+    }
+}
+
 void TestudoWindow::resizeWebView(const RECT* bounds) const
 {
     if (webviewController != nullptr)
@@ -2,11 +2,16 @@
 
 #if _WIN32
 
+#include <memory>
+#include <optional>
 #include <string>
 #include <WebView2.h>
 #include <wil/com.h>
 
 #include "ITestudoWindow.h"
+#include "../Common/MemoryAccounting.h"
+#include "../Common/MessageRingBuffer.h"
+#include "../Common/ScriptRequestTable.h"
 
 class TestudoWindow final : ITestudoWindow
 {
@@ -26,12 +31,30 @@ private:
     /** The web view embedded in this window. */
     wil::com_ptr<ICoreWebView2> _webView;
 
+    /** The script evaluations that are still in flight for this window. */
+    std::shared_ptr<ScriptRequestTable> _scriptRequests;
+
+    /** Keeps track of the memory that this window is holding on to. */
+    std::shared_ptr<MemoryAccounting::Counters> _memory;
+
+    /** The ring that managed code writes outbound messages into, or null if it is not enabled. */
+    std::shared_ptr<MessageRingBuffer> _messageRing;
+
+    /** The ID to report when the web view is ready, if this window was shown with @ref showAsync. */
+    std::optional<int> _createRequestId;
+
     /**
      * @brief Generates a random unique class name for a new window.
      * @return The randomly generated class name as a wide string.
      */
     static std::wstring generateClassName();
 
+    /**
+     * @brief Reports the outcome of @ref showAsync to managed code. Does nothing if the window was not shown that way.
+     * @param isSuccess Whether the web view was created successfully.
+     */
+    void completeCreation(bool isSuccess);
+
     /**
      * @brief Event handler for @ref ICoreWebView2.add_WebMessageReceived.
      * @param sender The web view that sent the event.
@@ -63,7 +86,7 @@ private:
         ICoreWebView2Controller* createdController);
 
     /**
-     * @brief Event handler for @ref CreateCoreWebView2Environment.
+     * @brief Receives the shared environment from @ref WebViewEnvironment::getAsync.
      * @param errorCode The error code representing errors that occured while creating the web view environment, if any.
      * @param createdEnvironment The newly created environment.
      * @return Whether the call was successful.
@@ -79,10 +102,46 @@ public:
 
     void show() override;
 
+    void showAsync(int requestId) override;
+
+    /**
+     * @brief Restores the window if it is minimized, and brings it to the front with focus.
+     */
+    void activate() const;
+
     void navigate(String uri) const override;
 
     void sendMessage(String message) const override;
 
+    /**
+     * @brief Sends the same message to several windows, marshaled once for all of them.
+     * @param windows The windows to send the message to.
+     * @param count The number of windows.
+     * @param message The message to send.
+     * @remarks Must be called on the main thread.
+     */
+    static void broadcast(TestudoWindow* const* windows, int count, String message);
+
+    void executeScript(int requestId, String script) override;
+
+    void getMemoryReport(MemoryReport* report) const override;
+
+    /**
+     * @brief Gets the ring that managed code writes outbound messages into.
+     * @return The ring, or null if @ref TestudoWindowConfiguration::messageRingCapacity is 0.
+     */
+    MessageRing* getMessageRing() const;
+
+    /**
+     * @brief Queues the message ring to be drained on the main loop. May be called from any thread.
+     */
+    void ringMessageDoorbell() const;
+
+    /**
+     * @brief Sends every message in the message ring to the web view. Must be called on the main thread.
+     */
+    void drainMessages() const;
+
     void resizeWebView(const RECT* bounds) const;
 };
 
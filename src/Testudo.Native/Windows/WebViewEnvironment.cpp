@@ -0,0 +1,92 @@
+#if _WIN32
+
+#include "WebViewEnvironment.h"
+#include "WindowsHelper.h"
+
+#include <WebView2EnvironmentOptions.h>
+#include <wrl.h>
+
+using namespace Microsoft::WRL;
+
+wil::com_ptr<ICoreWebView2Environment> WebViewEnvironment::_environment;
+std::wstring WebViewEnvironment::_arguments = L"--kiosk";
+std::wstring WebViewEnvironment::_userDataFolder;
+bool WebViewEnvironment::_isCreating = false;
+std::vector<WebViewEnvironment::EnvironmentCallback> WebViewEnvironment::_pendingCallbacks;
+
+void WebViewEnvironment::create()
+{
+    _isCreating = true;
+
+    const auto options = Make<CoreWebView2EnvironmentOptions>();
+    auto result = options->put_AdditionalBrowserArguments(_arguments.c_str());
+    if (SUCCEEDED(result))
+    {
+        const auto userDataFolder = _userDataFolder.empty() ? nullptr : _userDataFolder.c_str();
+        result = CreateCoreWebView2EnvironmentWithOptions(nullptr, userDataFolder, options.Get(),
+            Callback<ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler>(
+                [](const HRESULT errorCode, ICoreWebView2Environment* environment) -> HRESULT
+                {
+                    complete(errorCode, environment);
+                    return S_OK;
+                }).Get());
+    }
+
+    // The completion handler will never run if creation could not be started
+    if (FAILED(result))
+    {
+        DISPLAY_ERROR(result);
+        complete(result, nullptr);
+    }
+}
+
+void WebViewEnvironment::complete(const HRESULT errorCode, ICoreWebView2Environment* environment)
+{
+    _isCreating = false;
+    if (SUCCEEDED(errorCode))
+    {
+        _environment = environment;
+    }
+
+    // Callbacks may queue more callbacks, such as a window that retries after a failure
+    const auto callbacks = std::move(_pendingCallbacks);
+    _pendingCallbacks.clear();
+    for (const auto& callback : callbacks)
+    {
+        callback(errorCode, _environment.get());
+    }
+}
+
+void WebViewEnvironment::start(const TestudoApplicationConfiguration* configuration)
+{
+    // Every window shares the browser process, so its arguments apply to all of them
+    _arguments = configuration->areDevToolsEnabled ? L"--force-devtools-available" : L"--kiosk";
+    _userDataFolder = configuration->dataDirectory != nullptr ? configuration->dataDirectory : L"";
+    if (configuration->isWebViewPrewarmEnabled)
+    {
+        create();
+    }
+}
+
+void WebViewEnvironment::stop()
+{
+    _environment.reset();
+    _pendingCallbacks.clear();
+}
+
+void WebViewEnvironment::getAsync(EnvironmentCallback callback)
+{
+    if (_environment)
+    {
+        callback(S_OK, _environment.get());
+        return;
+    }
+
+    _pendingCallbacks.push_back(std::move(callback));
+    if (!_isCreating)
+    {
+        create();
+    }
+}
+
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+
+#if _WIN32
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <WebView2.h>
+#include <wil/com.h>
+
+#include "TestudoApplicationConfiguration.h"
+
+/**
+ * @brief Owns the WebView2 environment that is shared by every window in the application.
+ * @remarks Creating the environment spawns the browser process, which is the longest step in showing the first
+ * window. It can be started as soon as the application is created so that it overlaps with the rest of startup.
+ * Must only be used from the main thread.
+ */
+class WebViewEnvironment
+{
+public:
+    /**
+     * @brief Receives the shared environment once it has been created.
+     * @param errorCode The error that occurred while creating the environment, if any.
+     * @param environment The environment, or null if it could not be created.
+     */
+    using EnvironmentCallback = std::function<HRESULT(HRESULT errorCode, ICoreWebView2Environment* environment)>;
+
+private:
+    /** The shared environment, or null if it has not been created yet. */
+    static wil::com_ptr<ICoreWebView2Environment> _environment;
+
+    /** The additional browser arguments that the environment is created with. */
+    static std::wstring _arguments;
+
+    /** The directory that the browser keeps its data and caches in, or empty to use the default. */
+    static std::wstring _userDataFolder;
+
+    /** Whether the environment is being created. */
+    static bool _isCreating;
+
+    /** The callbacks that are waiting for the environment to be created. */
+    static std::vector<EnvironmentCallback> _pendingCallbacks;
+
+    /**
+     * @brief Starts creating the environment.
+     */
+    static void create();
+
+    /**
+     * @brief Stores the created environment and passes it to the waiting callbacks.
+     * @param errorCode The error that occurred while creating the environment, if any.
+     * @param environment The environment, or null if it could not be created.
+     */
+    static void complete(HRESULT errorCode, ICoreWebView2Environment* environment);
+
+public:
+    /**
+     * @brief Configures the environment, and starts creating it if prewarming is enabled.
+     * @param configuration The application configuration.
+     */
+    static void start(const TestudoApplicationConfiguration* configuration);
+
+    /**
+     * @brief Releases the environment.
+     */
+    static void stop();
+
+    /**
+     * @brief Passes the shared environment to the given callback, creating it first if needed.
+     * @param callback The callback, which is called immediately if the environment has already been created.
+     * @remarks If the environment could not be created, the next call tries again.
+     */
+    static void getAsync(EnvironmentCallback callback);
+};
+
+#endif
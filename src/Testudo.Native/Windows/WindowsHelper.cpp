@@ -1,8 +1,12 @@
 #include "WindowsHelper.h"
 
 #include <comdef.h>
+#include <memory>
+#include <ShObjIdl.h>
 
 #include "TestudoApplication.h"
+#include "../Common/StallWatchdog.h"
+#include "../Common/WindowEventQueue.h"
 
 std::map<HWND, TestudoWindow*> WindowsHelper::_windows;
 
@@ -13,24 +17,230 @@ void WindowsHelper::registerWindow(const HWND hWnd, TestudoWindow* window)
     _windows[hWnd] = window;
 }
 
+HRESULT WindowsHelper::runFileDialog(const HWND hWndOwner,
+                                     const FileDialogRequest& request,
+                                     std::vector<wil::unique_cotaskmem_string>& paths)
+{
+    const auto isSaveDialog = request.kind == FileDialogKind::SaveFile;
+    wil::com_ptr<IFileDialog> dialog;
+    HRESULT hr = CoCreateInstance(isSaveDialog ? CLSID_FileSaveDialog : CLSID_FileOpenDialog,
+                                  nullptr, CLSCTX_ALL, IID_PPV_ARGS(&dialog));
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    FILEOPENDIALOGOPTIONS options;
+    if (FAILED(hr = dialog->GetOptions(&options)))
+    {
+        return hr;
+    }
+
+    options |= FOS_FORCEFILESYSTEM;
+    if (request.kind == FileDialogKind::OpenFolder)
+    {
+        options |= FOS_PICKFOLDERS;
+    }
+
+    if (request.isMultiSelectEnabled)
+    {
+        options |= FOS_ALLOWMULTISELECT;
+    }
+
+    if (FAILED(hr = dialog->SetOptions(options)))
+    {
+        return hr;
+    }
+
+    if (!request.title.empty() && FAILED(hr = dialog->SetTitle(request.title.c_str())))
+    {
+        return hr;
+    }
+
+    if (!request.defaultFileName.empty() && FAILED(hr = dialog->SetFileName(request.defaultFileName.c_str())))
+    {
+        return hr;
+    }
+
+    if (!request.initialDirectory.empty())
+    {
+        // An initial directory that no longer exists is not worth failing the dialog over
+        wil::com_ptr<IShellItem> folder;
+        if (SUCCEEDED(SHCreateItemFromParsingName(request.initialDirectory.c_str(), nullptr, IID_PPV_ARGS(&folder))))
+        {
+            dialog->SetFolder(folder.get());
+        }
+    }
+
+    if (!request.filters.empty())
+    {
+        // The dialog copies the specs, so they only need to outlive this call
+        std::vector<std::wstring> patterns;
+        std::vector<COMDLG_FILTERSPEC> specs;
+        patterns.reserve(request.filters.size());
+        for (const auto& filter : request.filters)
+        {
+            std::wstring joined;
+            for (const auto& pattern : filter.patterns)
+            {
+                joined += joined.empty() ? pattern : L";" + pattern;
+            }
+
+            patterns.push_back(std::move(joined));
+            specs.push_back({filter.name.c_str(), patterns.back().c_str()});
+        }
+
+        if (FAILED(hr = dialog->SetFileTypes(static_cast<UINT>(specs.size()), specs.data())))
+        {
+            return hr;
+        }
+    }
+
+    if (FAILED(hr = dialog->Show(hWndOwner)))
+    {
+        return hr;
+    }
+
+    if (isSaveDialog)
+    {
+        wil::com_ptr<IShellItem> item;
+        wil::unique_cotaskmem_string path;
+        if (FAILED(hr = dialog->GetResult(&item)) || FAILED(hr = item->GetDisplayName(SIGDN_FILESYSPATH, &path)))
+        {
+            return hr;
+        }
+
+        paths.push_back(std::move(path));
+        return S_OK;
+    }
+
+    wil::com_ptr<IShellItemArray> items;
+    DWORD count = 0;
+    if (FAILED(hr = dialog.query<IFileOpenDialog>()->GetResults(&items)) || FAILED(hr = items->GetCount(&count)))
+    {
+        return hr;
+    }
+
+    for (DWORD i = 0; i < count; i++)
+    {
+        wil::com_ptr<IShellItem> item;
+        wil::unique_cotaskmem_string path;
+        if (FAILED(hr = items->GetItemAt(i, &item)) || FAILED(hr = item->GetDisplayName(SIGDN_FILESYSPATH, &path)))
+        {
+            return hr;
+        }
+
+        paths.push_back(std::move(path));
+    }
+
+    return S_OK;
+}
+
+void WindowsHelper::showFileDialog(const HWND hWndOwner, const FileDialogRequest& request)
+{
+    std::vector<wil::unique_cotaskmem_string> ownedPaths;
+    const auto hr = runFileDialog(hWndOwner, request, ownedPaths);
+    if (FAILED(hr))
+    {
+        ownedPaths.clear();
+        if (hr != HRESULT_FROM_WIN32(ERROR_CANCELLED))
+        {
+            DISPLAY_ERROR(hr);
+        }
+    }
+
+    // The paths are freed when this function returns, managed code copies them during the callback
+    std::vector<String> paths;
+    for (const auto& path : ownedPaths)
+    {
+        paths.push_back(path.get());
+    }
+
+    request.complete(paths);
+}
+
 LRESULT CALLBACK WindowsHelper::windowProcedure(
     const HWND hWnd, const UINT uMsg, const WPARAM wParam, const LPARAM lParam)
 {
     switch (uMsg)
     {
     case WM_SIZE:
-        if (_windows.contains(hWnd))
+        if (const auto window = _windows.find(hWnd); window != _windows.end())
         {
             RECT bounds;
             GetClientRect(hWnd, &bounds);
-            _windows[hWnd]->resizeWebView(&bounds);
+            window->second->resizeWebView(&bounds);
+
+            // A minimized window reports an empty client area, which is not worth passing on
+            if (wParam != SIZE_MINIMIZED)
+            {
+                WindowEventQueue::post({
+                    window->second, WindowEventKind::Resized, 0, 0, LOWORD(lParam), HIWORD(lParam), 0
+                });
+            }
+
+            WindowEventQueue::postState(window->second,
+                                        wParam == SIZE_MINIMIZED
+                                            ? WindowState::Minimized
+                                            : wParam == SIZE_MAXIMIZED
+                                            ? WindowState::Maximized
+                                            : WindowState::Normal);
+        }
+        break;
+
+    case WM_MOVE:
+        if (const auto window = _windows.find(hWnd); window != _windows.end() && !IsIconic(hWnd))
+        {
+            RECT bounds;
+            GetWindowRect(hWnd, &bounds);
+            WindowEventQueue::post({window->second, WindowEventKind::Moved, bounds.left, bounds.top, 0, 0, 0});
         }
         break;
+
+    case WM_ACTIVATE:
+        if (const auto window = _windows.find(hWnd); window != _windows.end())
+        {
+            const auto isFocused = LOWORD(wParam) != WA_INACTIVE;
+            WindowEventQueue::post({window->second, WindowEventKind::FocusChanged, 0, 0, 0, 0, isFocused});
+        }
+
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+
+    case WM_SHOWWINDOW:
+        if (const auto window = _windows.find(hWnd); window != _windows.end())
+        {
+            const auto isVisible = wParam != FALSE;
+            WindowEventQueue::post({window->second, WindowEventKind::VisibilityChanged, 0, 0, 0, 0, isVisible});
+        }
+
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+
+    case WM_CLOSE:
+        // Only reported, the window still closes as it did before
+        if (const auto window = _windows.find(hWnd); window != _windows.end())
+        {
+            WindowEventQueue::post({window->second, WindowEventKind::CloseRequested, 0, 0, 0, 0, 0});
+        }
+
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
         
+    case WM_TIMER:
+        if (wParam == STALL_HEARTBEAT_TIMER_ID)
+        {
+            StallWatchdog::heartbeat();
+            break;
+        }
+
+        return DefWindowProc(hWnd, uMsg, wParam, lParam);
+
     case WM_USER_INVOKE:
         {
-            reinterpret_cast<Action>(wParam)();
             const auto invocation = reinterpret_cast<Invocation*>(lParam);
+            {
+                StallWatchdog::ActivityScope activity(StallActivityKind::Invoke, invocation->tag);
+                reinterpret_cast<Action>(wParam)();
+            }
+
             {
                 std::lock_guard guard(invocationLock);
                 invocation->isCompleted = true;
@@ -40,6 +250,21 @@ LRESULT CALLBACK WindowsHelper::windowProcedure(
             break;
         }
         
+    case WM_USER_BEGIN_INVOKE:
+        {
+            const std::unique_ptr<std::function<void()>> action(reinterpret_cast<std::function<void()>*>(lParam));
+            StallWatchdog::ActivityScope activity(StallActivityKind::Invoke, nullptr);
+            (*action)();
+            break;
+        }
+
+    case WM_USER_FILE_DIALOG:
+        {
+            const std::unique_ptr<FileDialogRequest> request(reinterpret_cast<FileDialogRequest*>(lParam));
+            showFileDialog(hWnd, *request);
+            break;
+        }
+
     default:
         return DefWindowProc(hWnd, uMsg, wParam, lParam);
     }
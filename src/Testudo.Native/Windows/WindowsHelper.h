@@ -6,8 +6,11 @@
 #include <windows.h>
 #include <map>
 #include <sstream>
+#include <vector>
+#include <wil/resource.h>
 
 #include "TestudoWindow.h"
+#include "../Common/FileDialogRequest.h"
 
 /** Represents an invocation on the UI thread. */
 #define WM_USER_INVOKE (WM_USER + 1)
@@ -15,6 +18,15 @@
 /** Represents a message that was sent due to an interaction with the system tray icon. */
 #define WM_USER_SYSTRAY (WM_USER + 2)
 
+/** Represents a request to show a native file dialog from the main loop. */
+#define WM_USER_FILE_DIALOG (WM_USER + 3)
+
+/** Represents an invocation on the UI thread that the caller is not waiting for. */
+#define WM_USER_BEGIN_INVOKE (WM_USER + 4)
+
+/** Identifies the timer that sends heartbeats to the stall watchdog. */
+#define STALL_HEARTBEAT_TIMER_ID 1
+
 /**
  * @brief Checks if the result contains an error code and displays a message box if so.
  * @param func The function call that produces the HRESULT.
@@ -119,6 +131,17 @@ class WindowsHelper
 private:
     /** Holds references to windows so messages can be passed to the correct window from the main program loop. */
     static std::map<HWND, TestudoWindow*> _windows;
+
+    /**
+     * @brief Shows a common item dialog and collects the selected paths.
+     * @param hWndOwner The window that owns the dialog.
+     * @param request Describes the dialog.
+     * @param paths Receives the selected paths.
+     * @return The result of the first failing call, which is ERROR_CANCELLED if the user dismissed the dialog.
+     */
+    static HRESULT runFileDialog(HWND hWndOwner,
+                                 const FileDialogRequest& request,
+                                 std::vector<wil::unique_cotaskmem_string>& paths);
 public:
     /** Used to synchronise main thread invocations. */
     static std::mutex invocationLock;
@@ -130,6 +153,13 @@ public:
      */
     static void registerWindow(HWND hWnd, TestudoWindow* window);
 
+    /**
+     * @brief Shows a native file dialog and reports the result to managed code.
+     * @param hWndOwner The window that owns the dialog.
+     * @param request Describes the dialog.
+     */
+    static void showFileDialog(HWND hWndOwner, const FileDialogRequest& request);
+
     /**
      * @brief Handles window messages for all windows in the application.
      * @param hWnd The window to which the message was sent.
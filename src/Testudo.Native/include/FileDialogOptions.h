@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Testudo.h"
+
+/**
+ * @brief The kinds of native file dialog that can be shown.
+ */
+enum class FileDialogKind : int
+{
+    /** Selects one or more existing folders. */
+    OpenFolder = 0,
+
+    /** Selects one or more existing files. */
+    OpenFile = 1,
+
+    /** Selects a file path to save to. */
+    SaveFile = 2
+};
+
+/**
+ * @brief Describes a native file dialog.
+ * @remarks The strings are copied before @ref TestudoApplication::showFileDialog returns.
+ */
+struct FileDialogOptions
+{
+    /** The kind of dialog to show. */
+    FileDialogKind kind;
+
+    /** The title of the dialog, or null for the platform default. */
+    String title;
+
+    /** The directory the dialog starts in, or null for the platform default. */
+    String initialDirectory;
+
+    /** The file name that a save dialog is pre-filled with, may be null. */
+    String defaultFileName;
+
+    /**
+     * The file type filters as alternating names and semicolon-separated patterns, separated by pipes.
+     * For example "Images|*.png;*.jpg|All files|*". May be null. Ignored for folder dialogs.
+     */
+    String filters;
+
+    /** Whether more than one item may be selected. Ignored for save dialogs. */
+    bool isMultiSelectEnabled;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * @brief Describes the outbound messages that were flushed to a web view in a single display frame.
+ */
+struct FrameStatistics
+{
+    /** The frame clock's counter for the frame. */
+    long long frameCounter;
+
+    /** The time of the frame in microseconds on the monotonic clock. */
+    long long frameTime;
+
+    /** The display's refresh interval in microseconds. */
+    long long refreshInterval;
+
+    /** The number of messages that were coalesced into this frame. */
+    int messageCount;
+
+    /** The total size of the coalesced messages in bytes. */
+    int byteCount;
+
+    /** The number of frames so far that flushed messages later than the display refresh after they were queued. */
+    int lateFrameCount;
+
+    /** Whether the oldest message in this frame waited longer than one refresh interval. */
+    bool isLate;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MemoryReport.h"
 #include "Testudo.h"
 #include "TestudoWindowConfiguration.h"
 
@@ -27,6 +28,14 @@ public:
      */
     virtual void show() = 0;
 
+    /**
+     * @brief Initializes the window's embedded web view and shows the window, without navigating to the initial URI.
+     * @param requestId The ID to report to @ref TestudoWindowConfiguration::windowCreatedHandler.
+     * @remarks The handler is called once the web view is ready, so that the caller can prepare to handle the web
+     * view's requests before navigating it.
+     */
+    virtual void showAsync(int requestId) = 0;
+
     /**
      * @brief Navigates this window's web view to the given URI.
      * @param uri The URI to navigate to.
@@ -38,4 +47,18 @@ public:
      * @param message The JavaScript to send.
      */
     virtual void sendMessage(String message) const = 0;
+
+    /**
+     * @brief Evaluates JavaScript in this window's web view without waiting for the result.
+     * @param requestId The ID that the result will be reported with.
+     * @param script The JavaScript to evaluate.
+     * @remarks The result is passed to @ref TestudoWindowConfiguration::scriptEvaluatedHandler once available.
+     */
+    virtual void executeScript(int requestId, String script) = 0;
+
+    /**
+     * @brief Reports the memory that this window is holding on to.
+     * @param report Receives the report.
+     */
+    virtual void getMemoryReport(MemoryReport* report) const = 0;
 };
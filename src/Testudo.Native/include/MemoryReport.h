@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * @brief Describes the memory that a window, or the application as a whole, is holding on to.
+ * @remarks Application totals include windows that have since been destroyed in the cumulative fields, and leave
+ * the fields that only make sense per window at zero.
+ */
+struct MemoryReport
+{
+    /** The total size of the app:// resources served so far in bytes. */
+    long long resourceBytesServed;
+
+    /** The number of app:// resources served so far. */
+    long long resourceCount;
+
+    /** The size of the resource buffers that the web view has not released yet in bytes. */
+    long long resourceBytesHeld;
+
+    /** The size of the outbound messages waiting to be flushed to the web view in bytes. */
+    long long queuedMessageBytes;
+
+    /**
+     * The resident memory of the process that hosts the web view in bytes, or -1 if it is not known.
+     * This is the web process on Linux and the browser process on Windows, either of which may be shared by several
+     * windows.
+     */
+    long long webProcessResidentBytes;
+
+    /** The number of outbound messages waiting to be flushed to the web view. */
+    int queuedMessageCount;
+
+    /** The number of script evaluations that are still in flight. */
+    int pendingScriptCount;
+
+    /** The ID of the process that hosts the web view, or 0 if it is not known yet. */
+    int webProcessId;
+};
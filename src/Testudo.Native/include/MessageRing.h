@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @brief The shared state of a single-producer, single-consumer ring of outbound messages.
+ * @remarks Managed code writes records directly into @ref data and the main loop reads them back out, so this layout
+ * is mirrored by managed code and must not change without updating it. Each record is a 4-byte length in bytes,
+ * followed by the message in the platform's @ref String encoding, padded to a multiple of 4 bytes so that lengths
+ * never wrap around the end of the ring. The offsets only ever increase and are masked by the capacity.
+ */
+struct MessageRing
+{
+    /** The total number of bytes written so far, only advanced by managed code. */
+    alignas(64) std::atomic<long long> writeOffset;
+
+    /** The total number of bytes read so far, only advanced by the main loop. */
+    alignas(64) std::atomic<long long> readOffset;
+
+    /** Set by managed code when it rings the doorbell, and cleared by the main loop before it drains the ring. */
+    alignas(64) std::atomic<int> isDrainScheduled;
+
+    /** The size of @ref data in bytes, which is a power of two. */
+    int capacity;
+
+    /** The ring's storage. */
+    unsigned char* data;
+};
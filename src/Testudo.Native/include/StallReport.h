@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Testudo.h"
+
+/**
+ * @brief The kinds of work that the main thread can be doing when it stalls.
+ */
+enum class StallActivityKind : int
+{
+    /** The main loop was stalled outside any tracked work. */
+    None = 0,
+
+    /** An action passed to @ref TestudoApplication::invoke. */
+    Invoke = 1,
+
+    /** A web resource request being served by managed code. */
+    ResourceRequest = 2,
+
+    /** A web message being handled by managed code. */
+    WebMessage = 3
+};
+
+/** The number of buckets in @ref StallReport::histogram. */
+constexpr int stallHistogramBucketCount = 8;
+
+/** The upper bound in milliseconds of each bucket in @ref StallReport::histogram, the last bucket is unbounded. */
+constexpr int stallHistogramBucketBounds[stallHistogramBucketCount - 1] = {250, 500, 1000, 2000, 5000, 10000, 30000};
+
+/**
+ * @brief Describes a period during which the main thread stopped servicing its loop.
+ */
+struct StallReport
+{
+    /** How long the main thread has been stalled for, in milliseconds. */
+    long long durationMilliseconds;
+
+    /** Whether the stall is still in progress. A final report is sent once it ends. */
+    bool isOngoing;
+
+    /** The kind of work the main thread was doing when the stall was detected. */
+    StallActivityKind activityKind;
+
+    /** Describes the work the main thread was doing when the stall was detected, may be null. */
+    String activity;
+
+    /** The number of stalls that have ended so far, bucketed by duration. */
+    int histogram[stallHistogramBucketCount];
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Testudo.h"
+
+/**
+ * @brief The phases of startup that are timed, roughly in the order they are reached.
+ */
+enum class StartupPhase : int
+{
+    /** The host and its service provider were built, stamped by managed code when the application is resolved. */
+    HostBuilt = 0,
+
+    /** The native application started initializing. */
+    ApplicationCreating = 1,
+
+    /** The UI toolkit was initialized, which is gtk_init on Linux and the message window on Windows. */
+    ToolkitInitialized = 2,
+
+    /** The native application finished initializing. */
+    ApplicationCreated = 3,
+
+    /** The first native window started being created. */
+    WindowCreating = 4,
+
+    /** The first native window was created. */
+    WindowCreated = 5,
+
+    /** The first web view was created. */
+    WebViewCreated = 6,
+
+    /** The first web view started navigating, which is when WebKit spawns its web process. */
+    NavigationStarted = 7,
+
+    /** The first app:// resource was requested. */
+    FirstResourceRequested = 8,
+
+    /** The first web view committed to the page and started loading its content. */
+    NavigationCommitted = 9,
+
+    /** The Blazor framework script was requested. */
+    FrameworkScriptRequested = 10,
+
+    /** The first web view finished loading the page. */
+    NavigationFinished = 11,
+
+    /** The first render batch was sent to the web view, stamped by managed code. */
+    FirstRenderBatchSent = 12,
+
+    /** The web view acknowledged the first render batch, stamped by managed code. */
+    FirstRenderCompleted = 13,
+
+    /** The web view painted a frame after the first render. Only reported on Linux. */
+    FirstPaint = 14
+};
+
+/** The number of values in @ref StartupPhase. */
+constexpr int startupPhaseCount = 15;
+
+/**
+ * @brief Describes how long each phase of startup took to reach.
+ */
+struct StartupReport
+{
+    /** The time from process start until each @ref StartupPhase was reached in microseconds, or -1 if it was not. */
+    long long elapsedMicroseconds[startupPhaseCount];
+};
@@ -24,8 +24,102 @@ using WebMessageReceivedDelegate = void(__cdecl *)(void* pInstance, String messa
  * @brief Represents a function pointer to a managed function that handles web requests.
  * @param pInstance Pointer to the @ref TestudoWindow instance whose web view requested the resource.
  * @param uri The URI of the requested resource.
+ * @param ifNoneMatch The entity tag of the copy that the web view already has cached, or null if it has none.
  * @param sizeBytes Will be populated with the size of the returned buffer.
  * @param contentType Will be populated with the MIME type of the resource.
- * @return Pointer to a buffer containing the data of the requested resource.
+ * @param entityTag Will be populated with the entity tag of the resource, or null if it has none.
+ * @return Pointer to a buffer containing the data of the requested resource, or null if the resource does not exist.
+ * Also null if @p ifNoneMatch is still current, in which case @p entityTag is set and the web view's copy is used.
  */
-using WebResourceRequestedDelegate = void* (__cdecl *)(void* pInstance, String uri, int* sizeBytes, String* contentType);
+using WebResourceRequestedDelegate = void* (__cdecl *)(void* pInstance,
+                                                       String uri,
+                                                       String ifNoneMatch,
+                                                       int* sizeBytes,
+                                                       String* contentType,
+                                                       String* entityTag);
+
+/**
+ * @brief Represents a function pointer to a managed function that handles completed script evaluations.
+ * @param pInstance Pointer to the @ref TestudoWindow instance whose web view evaluated the script.
+ * @param requestId The ID that was given when the evaluation was requested.
+ * @param isSuccess Whether the script was evaluated successfully.
+ * @param result The result of the evaluation as JSON, or a description of the error if the evaluation failed.
+ */
+using ScriptEvaluatedDelegate = void(__cdecl *)(void* pInstance, int requestId, bool isSuccess, String result);
+
+/**
+ * @brief Represents a function pointer to a managed function that handles binary web messages.
+ * @param pInstance Pointer to the @ref TestudoWindow instance whose web view sent the message.
+ * @param data The message that was received. Only valid for the duration of the call.
+ * @param sizeBytes The size of the message in bytes.
+ */
+using WebBinaryMessageReceivedDelegate = void(__cdecl *)(void* pInstance, const void* data, int sizeBytes);
+
+struct FrameStatistics;
+
+/**
+ * @brief Represents a function pointer to a managed function that receives per-frame message statistics.
+ * @param pInstance Pointer to the @ref TestudoWindow instance whose messages were flushed.
+ * @param statistics The statistics for the frame. Only valid for the duration of the call.
+ */
+using FrameStatisticsDelegate = void(__cdecl *)(void* pInstance, const FrameStatistics* statistics);
+
+struct StartupReport;
+
+/**
+ * @brief Represents a function pointer to a managed function that receives the startup report.
+ * @param report Describes how long each phase of startup took. Only valid for the duration of the call.
+ * @remarks Called once, on whichever thread reached the last phase of startup.
+ */
+using StartupCompletedDelegate = void(__cdecl *)(const StartupReport* report);
+
+struct StallReport;
+
+/**
+ * @brief Represents a function pointer to a managed function that is notified of main thread stalls.
+ * @param report Describes the stall. Only valid for the duration of the call.
+ * @remarks Called from the watchdog thread, not the main thread.
+ */
+using StallDetectedDelegate = void(__cdecl *)(const StallReport* report);
+
+/**
+ * @brief Represents a function pointer to a managed function that receives the result of a native file dialog.
+ * @param requestId The ID that the dialog was shown with.
+ * @param pathCount The number of selected paths, or 0 if the dialog was cancelled.
+ * @param paths The selected paths. Owned by the native library and only valid for the duration of the call.
+ */
+using FileDialogCompletedDelegate = void(__cdecl *)(int requestId, int pathCount, const String* paths);
+
+/**
+ * @brief Represents a function pointer to a managed function that is notified when a window that was created
+ * asynchronously is ready to navigate.
+ * @param requestId The ID that the window was created with.
+ * @param pInstance Pointer to the new @ref TestudoWindow instance. Must still be destroyed if creation failed.
+ * @param isSuccess Whether the window's web view was created successfully.
+ * @remarks Called on the main thread, before the web view has navigated anywhere.
+ */
+using WindowCreatedDelegate = void(__cdecl *)(int requestId, void* pInstance, bool isSuccess);
+
+struct WindowEvent;
+
+/**
+ * @brief Represents a function pointer to a managed function that receives a batch of window events.
+ * @param events The events, at most one of each kind per window. Only valid for the duration of the call.
+ * @param count The number of events.
+ * @remarks Called on the main thread, at most once per main loop iteration.
+ */
+using WindowEventsDelegate = void(__cdecl *)(const WindowEvent* events, int count);
+
+/**
+ * @brief Represents a function pointer to a managed function that is told when a window's web view falls behind on
+ * outbound messages, and when it catches up again.
+ * @param pInstance Pointer to the @ref TestudoWindow instance whose web view fell behind or caught up.
+ * @param isPaused Whether low-priority producers should pause.
+ * @param outstandingCount The number of evaluations that the web view has not finished yet.
+ * @param outstandingBytes The size of the messages in those evaluations in bytes.
+ * @remarks Called on the main thread.
+ */
+using BackPressureChangedDelegate = void(__cdecl *)(void* pInstance,
+                                                    bool isPaused,
+                                                    int outstandingCount,
+                                                    long long outstandingBytes);
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <condition_variable>
+#include <functional>
 
+#include "FileDialogOptions.h"
 #include "Testudo.h"
 #include "TestudoApplicationConfiguration.h"
 
@@ -13,6 +15,9 @@ struct Invocation
     /** The action to execute on the main thread. */
     Action action;
 
+    /** Describes the action in stall reports, may be null. */
+    String tag;
+
     /** Notifies when the callback has finished executing. */
     std::condition_variable completion;
 
@@ -45,12 +50,23 @@ public:
     /**
      * @brief Invokes the given action on the main thread.
      * @param action The action to execute on the main thread.
+     * @param tag Describes the action in stall reports, may be null.
+     */
+    static void invoke(Action action, String tag = nullptr);
+
+    /**
+     * @brief Queues the given action to run on the main thread without waiting for it.
+     * @param action The action to execute on the main thread.
+     * @remarks May be called from any thread, including the main thread before @ref run is called.
      */
-    static void invoke(Action action);
+    static void beginInvoke(std::function<void()> action);
 
     /**
-     * @brief Opens a native folder selection dialog.
-     * @return The path to the selected folder, or null if no folder was selected.
+     * @brief Shows a native file dialog without blocking the caller or the main loop.
+     * @param requestId The ID that the result will be reported with.
+     * @param options Describes the dialog. Copied before this function returns.
+     * @remarks May be called from any thread. The result is passed to
+     * @ref TestudoApplicationConfiguration::fileDialogCompletedHandler on the main thread.
      */
-    static String openFolderDialog();
+    static void showFileDialog(int requestId, const FileDialogOptions* options);
 };
@@ -11,4 +11,43 @@ struct TestudoApplicationConfiguration
 
     /** The application icon. */
     void* hIcon;
+
+    /**
+     * The directory containing the Testudo web extension shared object, or null to disable it.
+     * Only used on Linux, where it gives each web view a direct channel to the host.
+     */
+    String webExtensionDirectory;
+
+    /** How long the main loop may go unserviced before it is reported as stalled, or 0 to disable the watchdog. */
+    int stallThresholdMilliseconds;
+
+    /** The callback that is notified of main thread stalls. */
+    StallDetectedDelegate stallDetectedHandler;
+
+    /** The callback that receives the results of native file dialogs. */
+    FileDialogCompletedDelegate fileDialogCompletedHandler;
+
+    /** The callback that receives the startup report once the first window has rendered. May be null. */
+    StartupCompletedDelegate startupCompletedHandler;
+
+    /**
+     * Whether to start the web view engine as soon as the application is created, rather than with the first window.
+     * Spawns the browser process on Windows, and a web process with a warm web view for the first window on Linux.
+     */
+    bool isWebViewPrewarmEnabled;
+
+    /**
+     * Whether developer tools are available to windows that enable them. Applies to the engine that every window
+     * shares, so it cannot vary between windows.
+     */
+    bool areDevToolsEnabled;
+
+    /** The callback that receives each batch of window events. May be null. */
+    WindowEventsDelegate windowEventsHandler;
+
+    /**
+     * The directory that the web view engine keeps its data and caches in between runs, such as its HTTP, script
+     * and bytecode caches and local storage. May be null to use the engine's default.
+     */
+    String dataDirectory;
 };
@@ -42,4 +42,53 @@ struct TestudoWindowConfiguration
 
     /** The callback that handles retrieving web resources. */
     WebResourceRequestedDelegate webResourceRequestedHandler;
+
+    /** The callback that handles completed script evaluations. */
+    ScriptEvaluatedDelegate scriptEvaluatedHandler;
+
+    /** The callback that handles binary messages sent through the Linux web extension. May be null. */
+    WebBinaryMessageReceivedDelegate webBinaryMessageReceivedHandler;
+
+    /**
+     * Whether outbound messages are buffered and flushed once per display frame, just before layout.
+     * Only supported on Linux, where it is driven by the web view's GdkFrameClock.
+     */
+    bool isFrameAlignedMessagingEnabled;
+
+    /** The callback that receives statistics for each frame that flushed messages. May be null. */
+    FrameStatisticsDelegate frameStatisticsHandler;
+
+    /** The callback that is notified when a window created with TestudoWindow_CreateAsync is ready. May be null. */
+    WindowCreatedDelegate windowCreatedHandler;
+
+    /**
+     * Whether the window is never shown, for rendering components with no user present.
+     * The web view behaves as usual, but nothing is presented to the screen.
+     */
+    bool isOffscreen;
+
+    /**
+     * The size in bytes of the ring that managed code writes outbound messages into, or 0 to send each message
+     * through TestudoWindow_SendMessage instead. Rounded up to a power of two.
+     */
+    int messageRingCapacity;
+
+    /**
+     * The size in bytes of the outbound messages that the web view may have outstanding before
+     * @ref backPressureChangedHandler is told to pause, or 0 to never signal back-pressure.
+     * Only evaluated messages are counted, not those sent through the Linux web extension channel.
+     */
+    int outboundHighWaterMarkBytes;
+
+    /**
+     * The size in bytes that outstanding outbound messages must fall to before @ref backPressureChangedHandler is
+     * told to resume. Defaults to half of @ref outboundHighWaterMarkBytes.
+     */
+    int outboundLowWaterMarkBytes;
+
+    /** The callback that is told when the web view falls behind on outbound messages and catches up. May be null. */
+    BackPressureChangedDelegate backPressureChangedHandler;
+
+    /** Whether the page stamps each interaction so that managed code can report its input-to-paint latency. */
+    bool isLatencyTracingEnabled;
 };
@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @brief The kinds of change that are reported for a window.
+ */
+enum class WindowEventKind : int
+{
+    /** The window's client area changed size. Reported in @ref WindowEvent::width and @ref WindowEvent::height. */
+    Resized = 0,
+
+    /** The window moved. Reported in @ref WindowEvent::left and @ref WindowEvent::top. */
+    Moved = 1,
+
+    /** The window gained or lost focus. @ref WindowEvent::value is 1 if it has focus. */
+    FocusChanged = 2,
+
+    /** The window was shown or hidden. @ref WindowEvent::value is 1 if it is visible. */
+    VisibilityChanged = 3,
+
+    /** The window was minimized, maximized, made fullscreen or restored. @ref WindowEvent::value is a @ref WindowState. */
+    StateChanged = 4,
+
+    /** The user asked to close the window, such as with its close button. */
+    CloseRequested = 5
+};
+
+/**
+ * @brief The states that a window can be in.
+ */
+enum class WindowState : int
+{
+    /** The window is neither minimized, maximized nor fullscreen. */
+    Normal = 0,
+
+    /** The window is minimized. */
+    Minimized = 1,
+
+    /** The window is maximized. */
+    Maximized = 2,
+
+    /** The window covers the whole screen. */
+    Fullscreen = 3
+};
+
+/**
+ * @brief Describes the latest change of one kind to a window.
+ */
+struct WindowEvent
+{
+    /** Pointer to the @ref TestudoWindow instance that changed. */
+    void* pInstance;
+
+    /** The kind of change. */
+    WindowEventKind kind;
+
+    /** The position of the window's left edge on the screen, for @ref WindowEventKind::Moved. */
+    int left;
+
+    /** The position of the window's top edge on the screen, for @ref WindowEventKind::Moved. */
+    int top;
+
+    /** The width of the window's client area in pixels, for @ref WindowEventKind::Resized. */
+    int width;
+
+    /** The height of the window's client area in pixels, for @ref WindowEventKind::Resized. */
+    int height;
+
+    /** The new focus, visibility or state, depending on @ref kind. */
+    int value;
+};
@@ -2,6 +2,7 @@
 using System.Reflection;
 using Microsoft.Extensions.DependencyInjection;
 using Microsoft.Extensions.Hosting;
+using Microsoft.Extensions.Logging;
 using Testudo;
 using Testudo.Sample;
 
@@ -14,28 +15,37 @@ internal static class Program
         using var icon = new Icon(stream);
 
         var host = Host.CreateDefaultBuilder(args)
-            .UseServiceProviderFactory(new TestudoServiceProviderFactory())
+            .UseServiceProviderFactory(new TestudoServiceProviderFactory(new TestudoServiceProviderOptions
+            {
+                FreezeMode = ServiceProviderFreezeMode.InBackground
+            }))
             .ConfigureServices((_, services) => services
                 .AddTestudo(new TestudoApplicationConfiguration
                 {
                     ApplicationName = "TestudoSample",
-                    Icon = icon.Handle
+                    Icon = icon.Handle,
+                    IsWebViewPrewarmEnabled = true
                 }))
             .Build();
     
         var application = host.Services.GetRequiredService<ITestudoApplication>();
         var windowManager = host.Services.GetRequiredService<IWindowManager>();
+        var logger = host.Services.GetRequiredService<ILoggerFactory>().CreateLogger("Testudo.Sample");
+        application.StartupCompleted += report => logger.LogInformation("Startup completed: {Report}", report.ToJson());
 
+        // The window is created once the main loop is running, so it must not be waited on here
         windowManager.OpenWindowAsync<App>(new TestudoWindowConfiguration
-        {
-            Icon = icon.Handle,
-            Title = "TestudoSample",
-            InitialRelativePath = "/",
-            IsCentered = true,
-            Width = 1920,
-            Height = 1080,
-            HasWindowShell = true
-        }).ConfigureAwait(false).GetAwaiter().GetResult();
+            {
+                Icon = icon.Handle,
+                Title = "TestudoSample",
+                InitialRelativePath = "/",
+                IsCentered = true,
+                Width = 1920,
+                Height = 1080,
+                HasWindowShell = true
+            })
+            .ContinueWith(task => logger.LogError(task.Exception, "The main window could not be opened."),
+                TaskContinuationOptions.OnlyOnFaulted);
 
         application.Run();
     }
@@ -0,0 +1,109 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+
+namespace Testudo;
+
+/// <summary>
+/// Per-service resolution metrics for the <see cref="TestudoServiceProvider" />, published through
+/// <c>System.Diagnostics.Metrics</c> under the <see cref="MeterName" /> meter.
+/// </summary>
+/// <remarks>
+/// Every instrument checks whether anything is listening to it before doing any work, so these cost next to nothing
+/// unless a listener such as <c>dotnet-counters monitor --counters Testudo.DependencyInjection</c> is attached.
+/// </remarks>
+internal static class DependencyInjectionMetrics
+{
+    /// <summary>
+    /// The name of the meter that the instruments are published under.
+    /// </summary>
+    public const string MeterName = "Testudo.DependencyInjection";
+
+    private static readonly Meter Meter = new(MeterName);
+
+    private static readonly Counter<long> ServiceResolutions = Meter.CreateCounter<long>(
+        "testudo.di.service.resolutions", "{resolution}",
+        "Number of times each service type has been requested from the root provider or from a window scope.");
+
+    private static readonly Histogram<double> ServiceConstructionDuration = Meter.CreateHistogram<double>(
+        "testudo.di.service.construction.duration", "ms",
+        "Time spent in the constructor or factory of each implementation type, not counting its dependencies.");
+
+    private static readonly Histogram<double> ProviderBuildDuration = Meter.CreateHistogram<double>(
+        "testudo.di.provider.build.duration", "ms",
+        "Time taken to build the service provider, including validation.");
+
+    private static readonly Histogram<double> ScopeDuration = Meter.CreateHistogram<double>(
+        "testudo.di.scope.duration", "ms",
+        "How long each window scope was open for.");
+
+    private static readonly Histogram<int> ScopeServices = Meter.CreateHistogram<int>(
+        "testudo.di.scope.services", "{service}",
+        "Number of scoped services resolved in each window scope.");
+
+    private static readonly Histogram<int> ScopeDisposables = Meter.CreateHistogram<int>(
+        "testudo.di.scope.disposables", "{service}",
+        "Number of disposable services captured by each window scope.");
+
+    /// <summary>
+    /// Whether anything is listening for construction times.
+    /// </summary>
+    public static bool IsConstructionDurationEnabled => ServiceConstructionDuration.Enabled;
+
+    /// <summary>
+    /// Whether anything is listening for the services resolved in each scope.
+    /// </summary>
+    public static bool IsScopeServicesEnabled => ScopeServices.Enabled;
+
+    public static void ServiceResolved(Type serviceType, bool isRootScope)
+    {
+        if (ServiceResolutions.Enabled)
+        {
+            ServiceResolutions.Add(1,
+                new KeyValuePair<string, object?>("service.type", serviceType.FullName),
+                new KeyValuePair<string, object?>("scope", isRootScope ? "root" : "window"));
+        }
+    }
+
+    /// <summary>
+    /// Gets the timestamp to pass to <see cref="ConstructionFinished" />, or zero if nothing is listening.
+    /// </summary>
+    public static long ConstructionStarted() => ServiceConstructionDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+
+    public static void ConstructionFinished(Type implementationType, long startTimestamp)
+    {
+        if (startTimestamp != 0)
+        {
+            ServiceConstructionDuration.Record(Stopwatch.GetElapsedTime(startTimestamp).TotalMilliseconds,
+                new KeyValuePair<string, object?>("implementation.type", implementationType.FullName));
+        }
+    }
+
+    public static void ProviderBuilt(long startTimestamp)
+    {
+        if (ProviderBuildDuration.Enabled)
+        {
+            ProviderBuildDuration.Record(Stopwatch.GetElapsedTime(startTimestamp).TotalMilliseconds);
+        }
+    }
+
+    /// <param name="createdTimestamp">The timestamp the scope was created at.</param>
+    /// <param name="scopedServices">The number of scoped services resolved in the scope.</param>
+    /// <param name="disposableServices">The number of disposable services captured by the scope.</param>
+    public static void ScopeDisposed(long createdTimestamp, int scopedServices, int disposableServices)
+    {
+        if (ScopeDuration.Enabled)
+        {
+            ScopeDuration.Record(Stopwatch.GetElapsedTime(createdTimestamp).TotalMilliseconds);
+        }
+
+        if (ScopeServices.Enabled)
+        {
+            ScopeServices.Record(scopedServices);
+        }
+
+        if (ScopeDisposables.Enabled)
+        {
+            ScopeDisposables.Record(disposableServices);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+using System.ComponentModel;
+using System.Reflection;
+
+namespace Testudo;
+
+/// <summary>
+/// Holds the constructor activators that the Testudo source generator emits for registered services, so that
+/// <see cref="TestudoServiceProvider" /> can construct them without reflection or runtime code generation.
+/// </summary>
+/// <remarks>
+/// Populated by module initializers in the generated code, this is not intended to be called directly.
+/// </remarks>
+[EditorBrowsable(EditorBrowsableState.Never)]
+public static class GeneratedActivators
+{
+    /// <summary>
+    /// The registered activators, keyed by the type that they construct.
+    /// </summary>
+    private static readonly Dictionary<Type, List<Registration>> _activators = new();
+
+    /// <summary>
+    /// The activators that have already been looked up, keyed by constructor. Also guarded by
+    /// <see cref="_activators" />.
+    /// </summary>
+    private static readonly Dictionary<ConstructorInfo, Func<object?[], object>?> _constructors = new();
+
+    /// <summary>
+    /// Registers an activator for one of the public constructors of the given type.
+    /// </summary>
+    /// <param name="implementationType">The type that the activator constructs.</param>
+    /// <param name="parameterTypes">The parameter types of the constructor, in order.</param>
+    /// <param name="activator">Invokes the constructor with the resolved arguments.</param>
+    public static void Register(Type implementationType, Type[] parameterTypes, Func<object?[], object> activator)
+    {
+        lock (_activators)
+        {
+            if (!_activators.TryGetValue(implementationType, out var registrations))
+            {
+                registrations = new List<Registration>();
+                _activators.Add(implementationType, registrations);
+            }
+
+            registrations.Add(new Registration(parameterTypes, activator));
+
+            // A constructor that was looked up before its assembly registered may now have an activator
+            _constructors.Clear();
+        }
+    }
+
+    /// <summary>
+    /// Finds the activator for the given constructor.
+    /// </summary>
+    /// <param name="constructor">The constructor to find the activator for.</param>
+    /// <returns>The activator, or null if none was generated for the constructor.</returns>
+    internal static Func<object?[], object>? Find(ConstructorInfo constructor)
+    {
+        lock (_activators)
+        {
+            if (!_constructors.TryGetValue(constructor, out var activator))
+            {
+                activator = Match(constructor);
+                _constructors.Add(constructor, activator);
+            }
+
+            return activator;
+        }
+    }
+
+    /// <summary>
+    /// Matches the given constructor against the registered activators. Must be called while holding the lock on
+    /// <see cref="_activators" />.
+    /// </summary>
+    /// <param name="constructor">The constructor to find the activator for.</param>
+    /// <returns>The activator, or null if none was generated for the constructor.</returns>
+    private static Func<object?[], object>? Match(ConstructorInfo constructor)
+    {
+        if (constructor.DeclaringType == null
+            || !_activators.TryGetValue(constructor.DeclaringType, out var registrations))
+        {
+            return null;
+        }
+
+        var parameters = constructor.GetParameters();
+        foreach (var registration in registrations)
+        {
+            if (registration.ParameterTypes.Length != parameters.Length)
+            {
+                continue;
+            }
+
+            var isMatch = true;
+            for (var i = 0; i < parameters.Length && isMatch; i++)
+            {
+                isMatch = registration.ParameterTypes[i] == parameters[i].ParameterType;
+            }
+
+            if (isMatch)
+            {
+                return registration.Activator;
+            }
+        }
+
+        return null;
+    }
+
+    private sealed record Registration(Type[] ParameterTypes, Func<object?[], object> Activator);
+}
\ No newline at end of file
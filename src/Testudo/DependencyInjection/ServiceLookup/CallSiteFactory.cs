@@ -15,6 +15,8 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
     private readonly ConcurrentDictionary<ServiceCacheKey, ServiceCallSite> _callSiteCache = new();
     private readonly ConcurrentDictionary<ServiceIdentifier, object> _callSiteLocks = new();
     private readonly Dictionary<ServiceIdentifier, ServiceDescriptorCacheItem> _descriptorLookup = new();
+    private readonly Dictionary<ServiceCacheKey, int> _scopeIndices = new();
+    private int _scopeIndexCount;
 
     private readonly StackGuard _stackGuard;
 
@@ -29,6 +31,11 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
 
     internal ServiceDescriptor[] Descriptors { get; }
 
+    /// <summary>
+    /// The number of scope indices that have been assigned so far.
+    /// </summary>
+    internal int ScopeIndexCount => Volatile.Read(ref _scopeIndexCount);
+
     public bool IsKeyedService(Type serviceType, object? key) => IsService(new ServiceIdentifier(key, serviceType));
 
     public bool IsService(Type serviceType) => IsService(new ServiceIdentifier(null, serviceType));
@@ -374,7 +381,7 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
 
             var resultCache = cacheLocation == CallSiteResultCacheLocation.Scope ||
                               cacheLocation == CallSiteResultCacheLocation.Root
-                ? new ResultCache(cacheLocation, callSiteKey)
+                ? AssignScopeIndex(new ResultCache(cacheLocation, callSiteKey))
                 : new ResultCache(CallSiteResultCacheLocation.None, callSiteKey);
             return _callSiteCache[callSiteKey] = new IEnumerableCallSite(resultCache, itemType, callSites);
         }
@@ -384,6 +391,35 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
         }
     }
 
+    /// <summary>
+    /// Gives a scoped result cache a dense index into each scope's storage.
+    /// </summary>
+    /// <remarks>
+    /// This has been added so that scopes can store their services in an array rather than a locked dictionary.
+    /// The same cache key always gets the same index, so call sites that are rebuilt share their storage.
+    /// </remarks>
+    private ResultCache AssignScopeIndex(ResultCache cache)
+    {
+        if (cache.Location != CallSiteResultCacheLocation.Scope)
+        {
+            return cache;
+        }
+
+        lock (_scopeIndices)
+        {
+            if (!_scopeIndices.TryGetValue(cache.Key, out var index))
+            {
+                index = _scopeIndices.Count;
+                _scopeIndices.Add(cache.Key, index);
+                Volatile.Write(ref _scopeIndexCount, index + 1);
+            }
+
+            cache.ScopeIndex = index;
+        }
+
+        return cache;
+    }
+
     private static CallSiteResultCacheLocation GetCommonCacheLocation(CallSiteResultCacheLocation locationA,
         CallSiteResultCacheLocation locationB) => (CallSiteResultCacheLocation)Math.Max((int)locationA, (int)locationB);
 
@@ -399,7 +435,7 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
             }
 
             ServiceCallSite callSite;
-            var lifetime = new ResultCache(descriptor.Lifetime, serviceIdentifier, slot);
+            var lifetime = AssignScopeIndex(new ResultCache(descriptor.Lifetime, serviceIdentifier, slot));
             if (descriptor.HasImplementationInstance())
             {
                 callSite = new ConstantCallSite(descriptor.ServiceType, descriptor.GetImplementationInstance());
@@ -454,7 +490,7 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
 
             var implementationType = descriptor.GetImplementationType();
             Debug.Assert(implementationType != null, "descriptor.ImplementationType != null");
-            var lifetime = new ResultCache(descriptor.Lifetime, serviceIdentifier, slot);
+            var lifetime = AssignScopeIndex(new ResultCache(descriptor.Lifetime, serviceIdentifier, slot));
             Type closedType;
             try
             {
@@ -677,6 +713,49 @@ internal sealed class CallSiteFactory : IServiceProviderIsService, IServiceProvi
         }
     }
 
+    /// <summary>
+    /// Gets the identifiers of every service that is known before it is requested, which are the closed
+    /// registrations, the enumerables of them and the services that call sites have already been created for.
+    /// </summary>
+    /// <remarks>
+    /// This method has been added so that <see cref="TestudoServiceProvider.Freeze" /> can precompute the accessors
+    /// of every registered service. Open generics and <see cref="KeyedService.AnyKey" /> registrations are only
+    /// known once a closed type or a key is requested, so they are left out.
+    /// </remarks>
+    [UnconditionalSuppressMessage("AotAnalysis", "IL3050:RequiresDynamicCode",
+        Justification = "VerifyAotCompatibility ensures the enumerable item type is not a ValueType")]
+    internal List<ServiceIdentifier> GetKnownServiceIdentifiers()
+    {
+        var serviceIdentifiers = new List<ServiceIdentifier>(_descriptorLookup.Count * 2 + _callSiteCache.Count);
+        foreach (var serviceIdentifier in _descriptorLookup.Keys)
+        {
+            var serviceType = serviceIdentifier.ServiceType;
+            if (serviceType.IsGenericTypeDefinition || serviceIdentifier.ServiceKey == KeyedService.AnyKey)
+            {
+                continue;
+            }
+
+            serviceIdentifiers.Add(serviceIdentifier);
+
+            if (!TestudoServiceProvider.VerifyAotCompatibility || !serviceType.IsValueType)
+            {
+                serviceIdentifiers.Add(new ServiceIdentifier(serviceIdentifier.ServiceKey,
+                    typeof(IEnumerable<>).MakeGenericType(serviceType)));
+            }
+        }
+
+        // This picks up the built in services, which have no descriptors
+        foreach (var callSiteKey in _callSiteCache.Keys)
+        {
+            if (callSiteKey.Slot == DefaultSlot)
+            {
+                serviceIdentifiers.Add(callSiteKey.ServiceIdentifier);
+            }
+        }
+
+        return serviceIdentifiers;
+    }
+
     public void Add(ServiceIdentifier serviceIdentifier, ServiceCallSite serviceCallSite)
     {
         _callSiteCache[new ServiceCacheKey(serviceIdentifier, DefaultSlot)] = serviceCallSite;
@@ -30,6 +30,10 @@ internal sealed class CallSiteRuntimeResolver : CallSiteVisitor<RuntimeResolverC
     protected override object? VisitDisposeCache(ServiceCallSite transientCallSite, RuntimeResolverContext context) =>
         context.Scope.CaptureDisposable(VisitCallSiteMain(transientCallSite, context));
 
+    /// <remarks>
+    /// This method has been modified to invoke the constructor through its generated activator when there is one,
+    /// and to time the constructor for <see cref="DependencyInjectionMetrics" />.
+    /// </remarks>
     protected override object VisitConstructor(ConstructorCallSite constructorCallSite, RuntimeResolverContext context)
     {
         object?[] parameterValues;
@@ -46,6 +50,26 @@ internal sealed class CallSiteRuntimeResolver : CallSiteVisitor<RuntimeResolverC
             }
         }
 
+        // Only the constructor itself is timed, as its dependencies are timed on their own
+        var startTimestamp = DependencyInjectionMetrics.ConstructionStarted();
+        try
+        {
+            return Construct(constructorCallSite, parameterValues);
+        }
+        finally
+        {
+            DependencyInjectionMetrics.ConstructionFinished(constructorCallSite.ImplementationType!, startTimestamp);
+        }
+    }
+
+    private static object Construct(ConstructorCallSite constructorCallSite, object?[] parameterValues)
+    {
+        // Prefer the activator emitted by the source generator, which calls the constructor directly
+        if (constructorCallSite.Activator != null)
+        {
+            return constructorCallSite.Activator(parameterValues);
+        }
+
 #if NETFRAMEWORK || NETSTANDARD2_0
             try
             {
@@ -100,12 +124,21 @@ internal sealed class CallSiteRuntimeResolver : CallSiteVisitor<RuntimeResolverC
             ? VisitRootCache(callSite, context)
             : VisitCache(callSite, context, context.Scope, RuntimeResolverLock.Scope);
 
+    /// <remarks>
+    /// This method has been modified to read already resolved services from the scope's slot storage without
+    /// taking the scope's lock.
+    /// </remarks>
     private object? VisitCache(ServiceCallSite callSite, RuntimeResolverContext context,
         ServiceProviderEngineScope serviceProviderEngine, RuntimeResolverLock lockType)
     {
+        var index = callSite.Cache.ScopeIndex;
+        if (serviceProviderEngine.TryGetResolvedService(index, out var resolved))
+        {
+            return resolved;
+        }
+
         var lockTaken = false;
         var sync = serviceProviderEngine.Sync;
-        var resolvedServices = serviceProviderEngine.ResolvedServices;
         // Taking locks only once allows us to fork resolution process
         // on another thread without causing the deadlock because we
         // always know that we are going to wait the other thread to finish before
@@ -118,8 +151,8 @@ internal sealed class CallSiteRuntimeResolver : CallSiteVisitor<RuntimeResolverC
         try
         {
             // Note: This method has already taken lock by the caller for resolution and access synchronization.
-            // For scoped: takes a dictionary as both a resolution lock and a dictionary access lock.
-            if (resolvedServices.TryGetValue(callSite.Cache.Key, out var resolved))
+            // For scoped: takes the scope's lock as both a resolution lock and a storage write lock.
+            if (serviceProviderEngine.TryGetResolvedService(index, out resolved))
             {
                 return resolved;
             }
@@ -130,7 +163,7 @@ internal sealed class CallSiteRuntimeResolver : CallSiteVisitor<RuntimeResolverC
                 AcquiredLocks = context.AcquiredLocks | lockType
             });
             serviceProviderEngine.CaptureDisposable(resolved);
-            resolvedServices.Add(callSite.Cache.Key, resolved);
+            serviceProviderEngine.SetResolvedService(index, resolved);
             return resolved;
         }
         finally
@@ -173,8 +206,21 @@ internal sealed class CallSiteRuntimeResolver : CallSiteVisitor<RuntimeResolverC
         }
     }
 
-    protected override object VisitFactory(FactoryCallSite factoryCallSite, RuntimeResolverContext context) =>
-        factoryCallSite.Factory(context.Scope);
+    /// <remarks>
+    /// This method has been modified to time the factory for <see cref="DependencyInjectionMetrics" />.
+    /// </remarks>
+    protected override object VisitFactory(FactoryCallSite factoryCallSite, RuntimeResolverContext context)
+    {
+        var startTimestamp = DependencyInjectionMetrics.ConstructionStarted();
+        try
+        {
+            return factoryCallSite.Factory(context.Scope);
+        }
+        finally
+        {
+            DependencyInjectionMetrics.ConstructionFinished(factoryCallSite.ServiceType, startTimestamp);
+        }
+    }
 }
 
 internal struct RuntimeResolverContext
@@ -22,9 +22,15 @@ internal sealed class ConstructorCallSite : ServiceCallSite
         ServiceType = serviceType;
         ConstructorInfo = constructorInfo;
         ParameterCallSites = parameterCallSites;
+        Activator = GeneratedActivators.Find(constructorInfo);
     }
 
     internal ConstructorInfo ConstructorInfo { get; }
+
+    /// <summary>
+    /// The build-time generated activator for <see cref="ConstructorInfo" />, or null if there is none.
+    /// </summary>
+    internal Func<object?[], object>? Activator { get; }
     internal ServiceCallSite[] ParameterCallSites { get; }
 
     public override Type ServiceType { get; }
@@ -14,6 +14,10 @@ internal sealed class DynamicServiceProviderEngine : CompiledServiceProviderEngi
     public DynamicServiceProviderEngine(TestudoServiceProvider serviceProvider) : base(serviceProvider) =>
         _serviceProvider = serviceProvider;
 
+    /// <remarks>
+    /// This method has been modified to hold off compiling while construction times are being listened to, as
+    /// only the runtime resolver can time each constructor.
+    /// </remarks>
     public override Func<ServiceProviderEngineScope, object?> RealizeService(ServiceCallSite callSite)
     {
         var callCount = 0;
@@ -23,6 +27,11 @@ internal sealed class DynamicServiceProviderEngine : CompiledServiceProviderEngi
             // won't cause any side effects during the compilation of the resolve function.
             var result = CallSiteRuntimeResolver.Instance.Resolve(callSite, scope);
 
+            if (DependencyInjectionMetrics.IsConstructionDurationEnabled)
+            {
+                return result;
+            }
+
             if (Interlocked.Increment(ref callCount) == 2)
             {
                 // Don't capture the ExecutionContext when forking to build the compiled version of the
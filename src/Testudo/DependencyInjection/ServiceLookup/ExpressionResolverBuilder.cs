@@ -14,19 +14,9 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
     private static readonly ParameterExpression ScopeParameter =
         Expression.Parameter(typeof(ServiceProviderEngineScope));
 
-    private static readonly ParameterExpression ResolvedServices =
-        Expression.Variable(typeof(IDictionary<ServiceCacheKey, object>), ScopeParameter.Name + "resolvedServices");
-
     private static readonly ParameterExpression
         Sync = Expression.Variable(typeof(object), ScopeParameter.Name + "sync");
 
-    private static readonly BinaryExpression ResolvedServicesVariableAssignment =
-        Expression.Assign(ResolvedServices,
-            Expression.Property(
-                ScopeParameter,
-                typeof(ServiceProviderEngineScope).GetProperty(nameof(ServiceProviderEngineScope.ResolvedServices),
-                    BindingFlags.Instance | BindingFlags.NonPublic)!));
-
     private static readonly BinaryExpression SyncVariableAssignment =
         Expression.Assign(Sync,
             Expression.Property(
@@ -88,8 +78,7 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
         {
             return Expression.Lambda<Func<ServiceProviderEngineScope, object>>(
                 Expression.Block(
-                    new[] {ResolvedServices, Sync},
-                    ResolvedServicesVariableAssignment,
+                    new[] {Sync},
                     SyncVariableAssignment,
                     BuildScopedExpression(callSite)),
                 ScopeParameter);
@@ -213,6 +202,10 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
     }
 
     // Move off the main stack
+    /// <remarks>
+    /// This method has been modified to read already resolved services from the scope's slot storage before
+    /// taking the scope's lock.
+    /// </remarks>
     private ConditionalExpression BuildScopedExpression(ServiceCallSite callSite)
     {
         var callSiteExpression = Expression.Constant(
@@ -228,18 +221,16 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
             callSiteExpression,
             ScopeParameter);
 
-        var keyExpression = Expression.Constant(
-            callSite.Cache.Key,
-            typeof(ServiceCacheKey));
+        var indexExpression = Expression.Constant(
+            callSite.Cache.ScopeIndex,
+            typeof(int));
 
         var resolvedVariable = Expression.Variable(typeof(object), "resolved");
 
-        var resolvedServices = ResolvedServices;
-
         var tryGetValueExpression = Expression.Call(
-            resolvedServices,
-            ServiceLookupHelpers.TryGetValueMethodInfo,
-            keyExpression,
+            ScopeParameter,
+            ServiceLookupHelpers.TryGetResolvedServiceMethodInfo,
+            indexExpression,
             resolvedVariable);
 
         var captureDisposible = TryCaptureDisposable(callSite, ScopeParameter, VisitCallSiteMain(callSite, null));
@@ -249,24 +240,16 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
             captureDisposible);
 
         var addValueExpression = Expression.Call(
-            resolvedServices,
-            ServiceLookupHelpers.AddMethodInfo,
-            keyExpression,
-            resolvedVariable);
-
-        var blockExpression = Expression.Block(
-            typeof(object),
-            new[]
-            {
-                resolvedVariable
-            },
-            Expression.IfThen(
-                Expression.Not(tryGetValueExpression),
-                Expression.Block(
-                    assignExpression,
-                    addValueExpression)),
+            ScopeParameter,
+            ServiceLookupHelpers.SetResolvedServiceMethodInfo,
+            indexExpression,
             resolvedVariable);
 
+        var blockExpression = Expression.IfThen(
+            Expression.Not(tryGetValueExpression),
+            Expression.Block(
+                assignExpression,
+                addValueExpression));
 
         // The C# compiler would copy the lock object to guard against mutation.
         // We don't, since we know the lock object is readonly.
@@ -279,6 +262,11 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
         var tryBody = Expression.Block(monitorEnter, blockExpression);
         var finallyBody = Expression.IfThen(lockWasTaken, monitorExit);
 
+        // Only take the lock when the service has not been resolved in this scope yet
+        var lockedExpression = Expression.IfThen(
+            Expression.Not(tryGetValueExpression),
+            Expression.TryFinally(tryBody, finallyBody));
+
         return Expression.Condition(
             Expression.Property(
                 ScopeParameter,
@@ -288,8 +276,9 @@ internal sealed class ExpressionResolverBuilder : CallSiteVisitor<object?, Expre
             resolveRootScopeExpression,
             Expression.Block(
                 typeof(object),
-                new[] {lockWasTaken},
-                Expression.TryFinally(tryBody, finallyBody))
+                new[] {resolvedVariable, lockWasTaken},
+                lockedExpression,
+                resolvedVariable)
         );
     }
 
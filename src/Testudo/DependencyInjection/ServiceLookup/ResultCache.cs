@@ -43,4 +43,13 @@ internal struct ResultCache
     public CallSiteResultCacheLocation Location { get; set; }
 
     public ServiceCacheKey Key { get; set; }
+
+    /// <summary>
+    /// The index of the call site's instance in each scope's storage.
+    /// Only meaningful when <see cref="Location" /> is <see cref="CallSiteResultCacheLocation.Scope" />.
+    /// </summary>
+    /// <remarks>
+    /// This has been added so that scopes can store their services in an array rather than a locked dictionary.
+    /// </remarks>
+    public int ScopeIndex { get; set; }
 }
\ No newline at end of file
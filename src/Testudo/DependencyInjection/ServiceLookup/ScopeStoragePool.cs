@@ -0,0 +1,50 @@
+using System.Collections.Concurrent;
+
+namespace Testudo;
+
+/// <summary>
+/// Recycles the arrays that <see cref="ServiceProviderEngineScope" /> stores its scoped services in, so that
+/// opening and closing windows does not allocate a new one each time.
+/// </summary>
+/// <remarks>
+/// The scopes themselves are not pooled, so that a reference to a disposed scope can never resolve services from a
+/// scope that has taken its place.
+/// </remarks>
+internal sealed class ScopeStoragePool
+{
+    /// <summary>
+    /// The most arrays that will be kept for reuse, which comfortably covers the number of windows an application
+    /// would have open at once.
+    /// </summary>
+    private const int MaxPooledCount = 16;
+
+    private readonly ConcurrentQueue<object?[]> _pool = new();
+
+    /// <summary>
+    /// Gets an empty array with room for at least the given number of services.
+    /// </summary>
+    public object?[] Rent(int minimumLength)
+    {
+        if (_pool.TryDequeue(out var storage) && storage.Length >= minimumLength)
+        {
+            return storage;
+        }
+
+        // Arrays that are too small are dropped, as new scoped call sites are only ever added
+        return minimumLength == 0 ? Array.Empty<object?>() : new object?[minimumLength];
+    }
+
+    /// <summary>
+    /// Clears the given array and keeps it for reuse.
+    /// </summary>
+    public void Return(object?[] storage)
+    {
+        if (storage.Length == 0 || _pool.Count >= MaxPooledCount)
+        {
+            return;
+        }
+
+        Array.Clear(storage);
+        _pool.Enqueue(storage);
+    }
+}
\ No newline at end of file
@@ -17,14 +17,14 @@ internal static class ServiceLookupHelpers
     internal static readonly MethodInfo CaptureDisposableMethodInfo = typeof(ServiceProviderEngineScope)
         .GetMethod(nameof(ServiceProviderEngineScope.CaptureDisposable), LookupFlags)!;
 
-    internal static readonly MethodInfo TryGetValueMethodInfo = typeof(IDictionary<ServiceCacheKey, object>)
-        .GetMethod(nameof(IDictionary<ServiceCacheKey, object>.TryGetValue), LookupFlags)!;
+    internal static readonly MethodInfo TryGetResolvedServiceMethodInfo = typeof(ServiceProviderEngineScope)
+        .GetMethod(nameof(ServiceProviderEngineScope.TryGetResolvedService), LookupFlags)!;
 
     internal static readonly MethodInfo ResolveCallSiteAndScopeMethodInfo = typeof(CallSiteRuntimeResolver)
         .GetMethod(nameof(CallSiteRuntimeResolver.Resolve), LookupFlags)!;
 
-    internal static readonly MethodInfo AddMethodInfo = typeof(IDictionary<ServiceCacheKey, object>)
-        .GetMethod(nameof(IDictionary<ServiceCacheKey, object>.Add), LookupFlags)!;
+    internal static readonly MethodInfo SetResolvedServiceMethodInfo = typeof(ServiceProviderEngineScope)
+        .GetMethod(nameof(ServiceProviderEngineScope.SetResolvedService), LookupFlags)!;
 
     internal static readonly MethodInfo MonitorEnterMethodInfo = typeof(Monitor)
         .GetMethod(nameof(Monitor.Enter), BindingFlags.Public | BindingFlags.Static, null,
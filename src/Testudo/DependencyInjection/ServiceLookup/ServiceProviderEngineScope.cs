@@ -22,11 +22,33 @@ namespace Testudo;
 internal sealed class ServiceProviderEngineScope : IServiceScope, IServiceProvider, IKeyedServiceProvider,
     IAsyncDisposable, IServiceScopeFactory
 {
+    /// <summary>
+    /// Stands in for a scoped service that resolved to null, so that null can mean "not resolved yet".
+    /// </summary>
+    private static readonly object NullService = new();
+
+    private readonly object _sync = new();
+
     private List<object>? _disposables;
 
+    private volatile bool _disposed;
+
+    private readonly long _createdTimestamp = Stopwatch.GetTimestamp();
+
+    /// <summary>
+    /// The scoped services resolved in this scope, indexed by <see cref="ResultCache.ScopeIndex" />.
+    /// </summary>
+    private object?[] _resolvedServices;
+
+    /// <remarks>
+    /// This constructor has been modified to rent the scoped service storage from the provider's pool.
+    /// </remarks>
     public ServiceProviderEngineScope(TestudoServiceProvider provider, bool isRootScope)
     {
-        ResolvedServices = new Dictionary<ServiceCacheKey, object?>();
+        // The root scope caches its services on the call sites, and is created before the call site factory exists
+        _resolvedServices = isRootScope
+            ? Array.Empty<object?>()
+            : provider.ScopeStoragePool.Rent(provider.CallSiteFactory.ScopeIndexCount);
         RootProvider = provider;
         IsRootScope = isRootScope;
     }
@@ -34,14 +56,12 @@ internal sealed class ServiceProviderEngineScope : IServiceScope, IServiceProvid
     // For testing and debugging only
     internal IList<object> Disposables => _disposables ?? (IList<object>)Array.Empty<object>();
 
-    internal Dictionary<ServiceCacheKey, object?> ResolvedServices { get; }
-
-    internal bool Disposed { get; private set; }
+    internal bool Disposed => _disposed;
 
     // This lock protects state on the scope, in particular, for the root scope, it protects
     // the list of disposable entries only, since ResolvedServices are cached on CallSites
     // For other scopes, it protects ResolvedServices and the list of disposables
-    internal object Sync => ResolvedServices;
+    internal object Sync => _sync;
 
     public bool IsRootScope { get; }
 
@@ -180,6 +200,56 @@ internal sealed class ServiceProviderEngineScope : IServiceScope, IServiceProvid
         return this;
     }
 
+    /// <summary>
+    /// Gets a scoped service that has already been resolved in this scope, without taking <see cref="Sync" />.
+    /// </summary>
+    /// <param name="index">The <see cref="ResultCache.ScopeIndex" /> of the service's call site.</param>
+    /// <param name="service">The resolved service.</param>
+    /// <returns>Whether the service had already been resolved.</returns>
+    /// <remarks>
+    /// This has been added to replace the locked dictionary lookup, as Blazor components resolve the same scoped
+    /// services repeatedly while rendering.
+    /// </remarks>
+    internal bool TryGetResolvedService(int index, out object? service)
+    {
+        var resolvedServices = Volatile.Read(ref _resolvedServices);
+        if ((uint)index < (uint)resolvedServices.Length && Volatile.Read(ref resolvedServices[index]) is { } resolved)
+        {
+            // The storage is pooled, so make sure it was not handed to another scope after this one was disposed
+            if (_disposed)
+            {
+                ThrowHelper.ThrowObjectDisposedException();
+            }
+
+            service = ReferenceEquals(resolved, NullService) ? null : resolved;
+            return true;
+        }
+
+        service = null;
+        return false;
+    }
+
+    /// <summary>
+    /// Stores a scoped service that was resolved in this scope. Must be called while holding <see cref="Sync" />.
+    /// </summary>
+    /// <param name="index">The <see cref="ResultCache.ScopeIndex" /> of the service's call site.</param>
+    /// <param name="service">The resolved service.</param>
+    internal void SetResolvedService(int index, object? service)
+    {
+        var resolvedServices = _resolvedServices;
+        if (index < resolvedServices.Length)
+        {
+            Volatile.Write(ref resolvedServices[index], service ?? NullService);
+            return;
+        }
+
+        // Call sites that were created after this scope need more room
+        var grown = new object?[Math.Max(index + 1, RootProvider.CallSiteFactory.ScopeIndexCount)];
+        Array.Copy(resolvedServices, grown, resolvedServices.Length);
+        grown[index] = service ?? NullService;
+        Volatile.Write(ref _resolvedServices, grown);
+    }
+
     [return: NotNullIfNotNull(nameof(service))]
     internal object? CaptureDisposable(object? service)
     {
@@ -223,8 +293,13 @@ internal sealed class ServiceProviderEngineScope : IServiceScope, IServiceProvid
         return service;
     }
 
+    /// <remarks>
+    /// This method has been modified to return the scoped service storage to the provider's pool, and to report
+    /// the scope's lifetime to <see cref="DependencyInjectionMetrics" />.
+    /// </remarks>
     private List<object>? BeginDispose()
     {
+        object?[] resolvedServices;
         lock (Sync)
         {
             if (Disposed)
@@ -233,15 +308,37 @@ internal sealed class ServiceProviderEngineScope : IServiceScope, IServiceProvid
             }
 
             // Track statistics about the scope (number of disposable objects and number of disposed services)
-            DependencyInjectionEventSource.Log.ScopeDisposed(RootProvider.GetHashCode(), ResolvedServices.Count,
-                _disposables?.Count ?? 0);
+            resolvedServices = _resolvedServices;
+            var disposableCount = _disposables?.Count ?? 0;
+
+            // Counting means walking the storage, so only do it when something is listening
+            var eventSourceEnabled = DependencyInjectionEventSource.Log.IsEnabled();
+            var resolvedCount = eventSourceEnabled || DependencyInjectionMetrics.IsScopeServicesEnabled
+                ? resolvedServices.Count(s => s != null)
+                : 0;
+
+            if (eventSourceEnabled)
+            {
+                DependencyInjectionEventSource.Log.ScopeDisposed(RootProvider.GetHashCode(), resolvedCount,
+                    disposableCount);
+            }
+
+            if (!IsRootScope)
+            {
+                DependencyInjectionMetrics.ScopeDisposed(_createdTimestamp, resolvedCount, disposableCount);
+            }
 
             // We've transitioned to the disposed state, so future calls to
             // CaptureDisposable will immediately dispose the object.
             // No further changes to _state.Disposables, are allowed.
-            Disposed = true;
+            _disposed = true;
+            _resolvedServices = Array.Empty<object?>();
         }
 
+        // Lock-free readers that still hold the old storage will see the disposed flag before they see
+        // anything that the next scope puts in it
+        RootProvider.ScopeStoragePool.Return(resolvedServices);
+
         if (IsRootScope && !RootProvider.IsDisposed())
         {
             // If this ServiceProviderEngineScope instance is a root scope, disposing this instance will need to dispose the RootProvider too.
@@ -0,0 +1,98 @@
+namespace Testudo;
+
+/// <summary>
+/// Creates a set of singletons ahead of time, dependencies first, so that they are not created on the
+/// UI-critical path of the first render.
+/// </summary>
+internal static class SingletonWarmer
+{
+    /// <summary>
+    /// Creates the given singletons and every singleton they depend on. Singletons that do not depend on each other
+    /// are created in parallel.
+    /// </summary>
+    /// <param name="provider">The service provider to create the singletons in.</param>
+    /// <param name="serviceTypes">The service types of the singletons to create.</param>
+    /// <remarks>
+    /// Call sites are created through the provider so that they are validated exactly as they are when resolved,
+    /// and a singleton that captures a scoped service is never created from here.
+    /// Failures are reported through <see cref="DependencyInjectionEventSource" /> and otherwise ignored, so that
+    /// they are thrown from the first resolution of the service as they would have been without warming up.
+    /// </remarks>
+    public static void Run(TestudoServiceProvider provider, IEnumerable<Type> serviceTypes)
+    {
+        // The level of a call site is how many singletons deep its dependency graph is
+        var levels = new Dictionary<ServiceCallSite, int>(ReferenceEqualityComparer.Instance);
+        foreach (var serviceType in serviceTypes)
+        {
+            try
+            {
+                var callSite = provider.CreateCallSite(ServiceIdentifier.FromServiceType(serviceType));
+
+                if (callSite != null)
+                {
+                    GetLevel(callSite, levels);
+                }
+            }
+            catch (Exception ex)
+            {
+                DependencyInjectionEventSource.Log.ServiceRealizationFailed(ex, provider.GetHashCode());
+            }
+        }
+
+        var singletonsByLevel = levels
+            .Where(pair => pair.Key.Cache.Location == CallSiteResultCacheLocation.Root)
+            .GroupBy(pair => pair.Value, pair => pair.Key)
+            .OrderBy(group => group.Key);
+
+        foreach (var singletons in singletonsByLevel)
+        {
+            if (provider.IsDisposed())
+            {
+                return;
+            }
+
+            Parallel.ForEach(singletons, callSite =>
+            {
+                try
+                {
+                    CallSiteRuntimeResolver.Instance.Resolve(callSite, provider.Root);
+                }
+                catch (Exception ex)
+                {
+                    DependencyInjectionEventSource.Log.ServiceRealizationFailed(ex, provider.GetHashCode());
+                }
+            });
+        }
+    }
+
+    private static int GetLevel(ServiceCallSite callSite, Dictionary<ServiceCallSite, int> levels)
+    {
+        if (levels.TryGetValue(callSite, out var level))
+        {
+            return level;
+        }
+
+        var dependencies = callSite switch
+        {
+            ConstructorCallSite constructorCallSite => constructorCallSite.ParameterCallSites,
+            IEnumerableCallSite enumerableCallSite => enumerableCallSite.ServiceCallSites,
+            _ => Array.Empty<ServiceCallSite>()
+        };
+
+        // Call sites have already been checked for circular dependencies when they were created
+        level = 0;
+        foreach (var dependency in dependencies)
+        {
+            var dependencyLevel = GetLevel(dependency, levels);
+            if (dependency.Cache.Location == CallSiteResultCacheLocation.Root)
+            {
+                dependencyLevel++;
+            }
+
+            level = Math.Max(level, dependencyLevel);
+        }
+
+        levels[callSite] = level;
+        return level;
+    }
+}
\ No newline at end of file
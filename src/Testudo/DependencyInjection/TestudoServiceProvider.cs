@@ -2,6 +2,7 @@
 // The .NET Foundation licenses this file to you under the MIT license.
 
 using System.Collections.Concurrent;
+using System.Collections.Frozen;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
 using System.Runtime.CompilerServices;
@@ -26,19 +27,30 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
 
     private readonly Func<ServiceIdentifier, ServiceAccessor> _createServiceAccessor;
 
+    private readonly Func<ServiceIdentifier, ServiceAccessor> _createFrozenServiceAccessor;
+
     private readonly ConcurrentDictionary<ServiceIdentifier, ServiceAccessor> _serviceAccessors;
 
     private bool _disposed;
 
+    private FrozenDictionary<ServiceIdentifier, ServiceAccessor>? _frozenServiceAccessors;
+
     // Internal for testing
     internal ServiceProviderEngine _engine;
 
+    /// <remarks>
+    /// This constructor has been modified to support the startup options on <see cref="TestudoServiceProviderOptions" />
+    /// and to report the build time to <see cref="DependencyInjectionMetrics" />.
+    /// </remarks>
     internal TestudoServiceProvider(ICollection<ServiceDescriptor> serviceDescriptors, ServiceProviderOptions options)
     {
+        var buildTimestamp = Stopwatch.GetTimestamp();
+
         // note that Root needs to be set before calling GetEngine(), because the engine may need to access Root
         Root = new ServiceProviderEngineScope(this, true);
         _engine = GetEngine();
-        _createServiceAccessor = CreateServiceAccessor;
+        _createServiceAccessor = serviceIdentifier => CreateServiceAccessor(serviceIdentifier, true);
+        _createFrozenServiceAccessor = serviceIdentifier => CreateServiceAccessor(serviceIdentifier, false);
         _serviceAccessors = new ConcurrentDictionary<ServiceIdentifier, ServiceAccessor>();
 
         CallSiteFactory = new CallSiteFactory(serviceDescriptors);
@@ -57,7 +69,13 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
             _callSiteValidator = new CallSiteValidator();
         }
 
-        if (options.ValidateOnBuild)
+        var testudoOptions = options as TestudoServiceProviderOptions;
+
+        if (options.ValidateOnBuild && testudoOptions?.ValidateInParallel == true)
+        {
+            ValidateServicesInParallel();
+        }
+        else if (options.ValidateOnBuild)
         {
             List<Exception>? exceptions = null;
             foreach (var serviceDescriptor in serviceDescriptors)
@@ -80,12 +98,36 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
         }
 
         DependencyInjectionEventSource.Log.ServiceProviderBuilt(this);
+        DependencyInjectionMetrics.ProviderBuilt(buildTimestamp);
+
+        if (testudoOptions?.WarmUpSingletons.Count > 0)
+        {
+            var warmUpSingletons = testudoOptions.WarmUpSingletons.ToArray();
+            Task.Run(() => SingletonWarmer.Run(this, warmUpSingletons)).ContinueWith(
+                task => DependencyInjectionEventSource.Log.ServiceRealizationFailed(task.Exception!, GetHashCode()),
+                TaskContinuationOptions.OnlyOnFaulted | TaskContinuationOptions.ExecuteSynchronously);
+        }
+
+        switch (testudoOptions?.FreezeMode)
+        {
+            case ServiceProviderFreezeMode.OnBuild:
+                Freeze();
+                break;
+            case ServiceProviderFreezeMode.InBackground:
+                _ = Task.Run(Freeze);
+                break;
+        }
     }
 
     internal CallSiteFactory CallSiteFactory { get; }
 
     internal ServiceProviderEngineScope Root { get; }
 
+    /// <summary>
+    /// Recycles the scoped service storage of disposed scopes, as a scope is created for every window.
+    /// </summary>
+    internal ScopeStoragePool ScopeStoragePool { get; } = new();
+
     internal static bool VerifyOpenGenericServiceTrimmability { get; } =
         AppContext.TryGetSwitch("Microsoft.Extensions.DependencyInjection.VerifyOpenGenericServiceTrimmability",
             out var verifyOpenGenerics)
@@ -161,6 +203,49 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
         return service;
     }
 
+    /// <summary>
+    /// Precomputes the call site and accessor of every registered service, including enumerables, keyed services
+    /// and the built in services, and stores them in a frozen lookup table so that resolving them never takes a
+    /// lock. This only needs to be called once, and can be called from a background thread.
+    /// </summary>
+    /// <remarks>
+    /// Singletons are not created by this method, they are still created the first time they are resolved.
+    /// Open generics and services registered with <see cref="KeyedService.AnyKey" /> cannot be known ahead of time,
+    /// so they are still resolved through the concurrent lookup.
+    /// </remarks>
+    public void Freeze()
+    {
+        if (_disposed)
+        {
+            ThrowHelper.ThrowObjectDisposedException();
+        }
+
+        if (Volatile.Read(ref _frozenServiceAccessors) != null)
+        {
+            return;
+        }
+
+        foreach (var serviceIdentifier in CallSiteFactory.GetKnownServiceIdentifiers())
+        {
+            if (_disposed)
+            {
+                return;
+            }
+
+            try
+            {
+                _serviceAccessors.GetOrAdd(serviceIdentifier, _createFrozenServiceAccessor);
+            }
+            catch (Exception ex)
+            {
+                // Services that cannot be constructed are left out, so they throw when they are resolved as usual
+                DependencyInjectionEventSource.Log.ServiceRealizationFailed(ex, GetHashCode());
+            }
+        }
+
+        Volatile.Write(ref _frozenServiceAccessors, _serviceAccessors.ToFrozenDictionary());
+    }
+
     internal bool IsDisposed() => _disposed;
 
     private void DisposeCore()
@@ -182,6 +267,10 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
         }
     }
 
+    /// <remarks>
+    /// This method has been modified to look the service accessor up in the frozen lookup table first, once
+    /// <see cref="Freeze" /> has finished.
+    /// </remarks>
     internal object? GetService(ServiceIdentifier serviceIdentifier,
         ServiceProviderEngineScope serviceProviderEngineScope)
     {
@@ -190,14 +279,77 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
             throw new ObjectDisposedException(GetType().Name);
         }
 
-        var serviceAccessor = _serviceAccessors.GetOrAdd(serviceIdentifier, _createServiceAccessor);
+        var frozenServiceAccessors = Volatile.Read(ref _frozenServiceAccessors);
+        if (frozenServiceAccessors == null ||
+            !frozenServiceAccessors.TryGetValue(serviceIdentifier, out var serviceAccessor))
+        {
+            serviceAccessor = _serviceAccessors.GetOrAdd(serviceIdentifier, _createServiceAccessor);
+        }
+
         OnResolve(serviceAccessor.CallSite, serviceProviderEngineScope);
         DependencyInjectionEventSource.Log.ServiceResolved(this, serviceIdentifier.ServiceType);
+        DependencyInjectionMetrics.ServiceResolved(serviceIdentifier.ServiceType,
+            serviceProviderEngineScope.IsRootScope);
         var result = serviceAccessor.RealizedService?.Invoke(serviceProviderEngineScope);
         Debug.Assert(result is null || CallSiteFactory.IsService(serviceIdentifier));
         return result;
     }
 
+    /// <summary>
+    /// Validates every service descriptor like the <see cref="ServiceProviderOptions.ValidateOnBuild" /> loop in the
+    /// constructor does, but spreads the work across all cores.
+    /// </summary>
+    /// <remarks>
+    /// This method has been added so that applications that validate in production do not pay for it serially
+    /// on every launch. Call sites are still created serially, as the call site factory locks each service while
+    /// creating it, and two threads walking a circular dependency from opposite ends would deadlock instead of
+    /// reporting it. Only the scope validation walk over the finished call sites runs in parallel.
+    /// </remarks>
+    private void ValidateServicesInParallel()
+    {
+        var descriptors = CallSiteFactory.Descriptors;
+        var exceptions = new Exception?[descriptors.Length];
+        var callSites = new ServiceCallSite?[descriptors.Length];
+        for (var i = 0; i < descriptors.Length; i++)
+        {
+            try
+            {
+                callSites[i] = CreateCallSiteForValidation(descriptors[i]);
+            }
+            catch (Exception e)
+            {
+                exceptions[i] = e;
+            }
+        }
+
+        if (_callSiteValidator != null)
+        {
+            Parallel.For(0, descriptors.Length, i =>
+            {
+                if (callSites[i] is not { } callSite)
+                {
+                    return;
+                }
+
+                try
+                {
+                    OnCreate(callSite);
+                }
+                catch (Exception e)
+                {
+                    exceptions[i] = CreateValidationException(descriptors[i], e);
+                }
+            });
+        }
+
+        // Keep the exceptions in registration order, as they would be when validating serially
+        if (Array.Exists(exceptions, e => e != null))
+        {
+            throw new AggregateException("Some services are not able to be constructed",
+                exceptions.OfType<Exception>());
+        }
+    }
+
     private void ValidateService(ServiceDescriptor descriptor)
     {
         if (descriptor.ServiceType.IsGenericType && !descriptor.ServiceType.IsConstructedGenericType)
@@ -215,12 +367,56 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
         }
         catch (Exception e)
         {
-            throw new InvalidOperationException(
-                $"Error while validating the service descriptor '{descriptor}': {e.Message}", e);
+            throw CreateValidationException(descriptor, e);
+        }
+    }
+
+    /// <summary>
+    /// Creates the call site for a service descriptor like <see cref="ValidateService" /> does, without validating
+    /// its scopes.
+    /// </summary>
+    /// <returns>The call site, or null if the descriptor is an open generic or could not be resolved.</returns>
+    private ServiceCallSite? CreateCallSiteForValidation(ServiceDescriptor descriptor)
+    {
+        if (descriptor.ServiceType.IsGenericType && !descriptor.ServiceType.IsConstructedGenericType)
+        {
+            return null;
+        }
+
+        try
+        {
+            return CallSiteFactory.GetCallSite(descriptor, new CallSiteChain());
+        }
+        catch (Exception e)
+        {
+            throw CreateValidationException(descriptor, e);
         }
     }
 
-    private ServiceAccessor CreateServiceAccessor(ServiceIdentifier serviceIdentifier)
+    private static InvalidOperationException CreateValidationException(ServiceDescriptor descriptor, Exception e) =>
+        new($"Error while validating the service descriptor '{descriptor}': {e.Message}", e);
+
+    /// <summary>
+    /// Creates the call site for a service the same way that resolving it does, including scope validation.
+    /// </summary>
+    /// <param name="serviceIdentifier">The service to create the call site for.</param>
+    /// <returns>The call site, or null if the service is not registered.</returns>
+    internal ServiceCallSite? CreateCallSite(ServiceIdentifier serviceIdentifier)
+    {
+        var callSite = CallSiteFactory.GetCallSite(serviceIdentifier, new CallSiteChain());
+        if (callSite != null)
+        {
+            OnCreate(callSite);
+        }
+
+        return callSite;
+    }
+
+    /// <remarks>
+    /// This method has been modified to leave singletons unresolved when <paramref name="resolveSingletons" /> is
+    /// false so that <see cref="Freeze" /> has no side effects.
+    /// </remarks>
+    private ServiceAccessor CreateServiceAccessor(ServiceIdentifier serviceIdentifier, bool resolveSingletons)
     {
         var callSite = CallSiteFactory.GetCallSite(serviceIdentifier, new CallSiteChain());
         if (callSite != null)
@@ -231,20 +427,44 @@ public sealed class TestudoServiceProvider : IServiceProvider, IKeyedServiceProv
             // Optimize singleton case
             if (callSite.Cache.Location == CallSiteResultCacheLocation.Root)
             {
+                if (!resolveSingletons)
+                {
+                    // The resolver returns the value cached on the call site without locking once it has been created
+                    return new ServiceAccessor
+                    {
+                        CallSite = callSite,
+                        RealizedService = _ => CallSiteRuntimeResolver.Instance.Resolve(callSite, Root)
+                    };
+                }
+
                 var value = CallSiteRuntimeResolver.Instance.Resolve(callSite, Root);
                 return new ServiceAccessor {CallSite = callSite, RealizedService = scope => value};
             }
 
-            var realizedService = _engine.RealizeService(callSite);
-            return new ServiceAccessor {CallSite = callSite, RealizedService = realizedService};
+            // The first resolutions walk the call site, using generated activators where there are any, until the
+            // engine has compiled it in the background
+            return new ServiceAccessor {CallSite = callSite, RealizedService = _engine.RealizeService(callSite)};
         }
 
         return new ServiceAccessor {CallSite = callSite, RealizedService = _ => null};
     }
 
+    /// <remarks>
+    /// This method has been modified to update accessors in place once they are in the frozen lookup table.
+    /// </remarks>
     internal void ReplaceServiceAccessor(ServiceCallSite callSite, Func<ServiceProviderEngineScope, object?> accessor)
     {
-        _serviceAccessors[new ServiceIdentifier(callSite.Key, callSite.ServiceType)] = new ServiceAccessor
+        var serviceIdentifier = new ServiceIdentifier(callSite.Key, callSite.ServiceType);
+
+        // The frozen lookup table shares its accessors with the concurrent one, so this updates both
+        if (Volatile.Read(ref _frozenServiceAccessors) is { } frozenServiceAccessors &&
+            frozenServiceAccessors.TryGetValue(serviceIdentifier, out var frozenServiceAccessor))
+        {
+            frozenServiceAccessor.RealizedService = accessor;
+            return;
+        }
+
+        _serviceAccessors[serviceIdentifier] = new ServiceAccessor
         {
             CallSite = callSite,
             RealizedService = accessor
@@ -0,0 +1,54 @@
+using Microsoft.Extensions.DependencyInjection;
+
+namespace Testudo;
+
+/// <summary>
+/// Determines when <see cref="TestudoServiceProvider.Freeze" /> is called for a newly built service provider.
+/// </summary>
+public enum ServiceProviderFreezeMode
+{
+    /// <summary>
+    /// The service provider is not frozen unless <see cref="TestudoServiceProvider.Freeze" /> is called manually.
+    /// </summary>
+    None,
+
+    /// <summary>
+    /// The service provider is frozen before it is returned, which makes building it slower.
+    /// </summary>
+    OnBuild,
+
+    /// <summary>
+    /// The service provider is frozen on a background thread, so that it happens while the first window is being
+    /// created. Services resolved before it finishes are resolved as they would be without freezing.
+    /// </summary>
+    InBackground
+}
+
+/// <summary>
+/// Options for configuring various behaviors of the <see cref="TestudoServiceProvider" />.
+/// </summary>
+public class TestudoServiceProviderOptions : ServiceProviderOptions
+{
+    /// <summary>
+    /// When the service provider precomputes the accessors of every registered service.
+    /// Defaults to <see cref="ServiceProviderFreezeMode.None" />.
+    /// </summary>
+    public ServiceProviderFreezeMode FreezeMode { get; set; }
+
+    /// <summary>
+    /// Whether <see cref="ServiceProviderOptions.ValidateOnBuild" /> validates the registered services in parallel
+    /// across all cores rather than one after another. Defaults to false.
+    /// </summary>
+    public bool ValidateInParallel { get; set; }
+
+    /// <summary>
+    /// The service types of singletons to create on the thread pool as soon as the service provider is built, so that
+    /// they are ready by the time the first window needs them. Their dependencies are created first, in parallel
+    /// where possible.
+    /// </summary>
+    /// <remarks>
+    /// Services that must be created on the main thread, such as <see cref="ITestudoApplication" />, should not be
+    /// added here.
+    /// </remarks>
+    public ICollection<Type> WarmUpSingletons { get; } = new List<Type>();
+}
\ No newline at end of file
@@ -24,10 +24,28 @@ public static class Extensions
         .AddSingleton<Dispatcher, TestudoDispatcher>()
         .AddSingleton<IWindowManager, WindowManager>()
         .AddSingleton<JSComponentConfigurationStore>()
+        .AddSingleton<ResourcePrefetcher>()
         .AddEmbeddedFileProvider(Assembly.GetCallingAssembly())
         .AddScoped<IScopeContext, ScopeContext>()
         .AddBlazorWebView();
 
+    /// <summary>
+    /// Serves web files straight from the given directory instead of the embedded ones, and refreshes them in every
+    /// open window as they change, without restarting the application.
+    /// </summary>
+    /// <param name="services">The service collection to add the live web root to.</param>
+    /// <param name="webRootDirectory">The <c>wwwroot</c> directory in the project's source.</param>
+    /// <returns>The same service collection that was passed in.</returns>
+    /// <remarks>
+    /// Intended for development. Must be called after <see cref="AddTestudo" />.
+    /// Changed stylesheets are swapped in place, and any other change reloads the page.
+    /// </remarks>
+    public static IServiceCollection AddLiveWebRoot(this IServiceCollection services, string webRootDirectory) =>
+        services
+            .AddSingleton<IFileProvider>(_ => new PhysicalFileProvider(Path.GetFullPath(webRootDirectory)))
+            .AddSingleton(provider =>
+                new WebRootWatcher(webRootDirectory, provider.GetRequiredService<ResourcePrefetcher>()));
+
     /// <summary>
     /// Sets the application up to use embedded web files.
     /// </summary>
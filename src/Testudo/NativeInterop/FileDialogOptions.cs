@@ -0,0 +1,113 @@
+using System.Runtime.InteropServices;
+
+namespace Testudo;
+
+/// <summary>
+/// The kinds of native file dialog that can be shown.
+/// </summary>
+public enum FileDialogKind
+{
+    /// <summary>
+    /// Selects one or more existing folders.
+    /// </summary>
+    OpenFolder = 0,
+
+    /// <summary>
+    /// Selects one or more existing files.
+    /// </summary>
+    OpenFile = 1,
+
+    /// <summary>
+    /// Selects a file path to save to.
+    /// </summary>
+    SaveFile = 2
+}
+
+/// <summary>
+/// A file type filter for a native file dialog.
+/// </summary>
+/// <param name="Name">The display name of the filter, which must not contain <c>|</c>.</param>
+/// <param name="Patterns">The glob patterns that the filter matches, such as <c>*.png</c>.</param>
+public sealed record FileDialogFilter(string Name, params string[] Patterns);
+
+/// <summary>
+/// Describes a native file dialog.
+/// </summary>
+public sealed class FileDialogOptions
+{
+    /// <summary>
+    /// The kind of dialog to show.
+    /// </summary>
+    public FileDialogKind Kind { get; init; } = FileDialogKind.OpenFile;
+
+    /// <summary>
+    /// The title of the dialog, or null for the platform default.
+    /// </summary>
+    public string? Title { get; init; }
+
+    /// <summary>
+    /// The directory the dialog starts in, or null for the platform default.
+    /// </summary>
+    public string? InitialDirectory { get; init; }
+
+    /// <summary>
+    /// The file name that a save dialog is pre-filled with.
+    /// </summary>
+    public string? DefaultFileName { get; init; }
+
+    /// <summary>
+    /// The file type filters, in the order they are offered. Ignored for folder dialogs.
+    /// </summary>
+    public IReadOnlyList<FileDialogFilter> Filters { get; init; } = [];
+
+    /// <summary>
+    /// Whether more than one item may be selected. Ignored for save dialogs.
+    /// </summary>
+    public bool IsMultiSelectEnabled { get; init; }
+}
+
+/// <summary>
+/// The native layout of <see cref="FileDialogOptions" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeFileDialogOptions : IDisposable
+{
+    public FileDialogKind Kind;
+
+    public IntPtr Title;
+
+    public IntPtr InitialDirectory;
+
+    public IntPtr DefaultFileName;
+
+    public IntPtr Filters;
+
+    [MarshalAs(UnmanagedType.U1)]
+    public bool IsMultiSelectEnabled;
+
+    /// <summary>
+    /// Copies the given options into native memory.
+    /// </summary>
+    public NativeFileDialogOptions(FileDialogOptions options)
+    {
+        Kind = options.Kind;
+        Title = ToHGlobal(options.Title);
+        InitialDirectory = ToHGlobal(options.InitialDirectory);
+        DefaultFileName = ToHGlobal(options.DefaultFileName);
+        Filters = ToHGlobal(options.Filters.Count == 0
+            ? null
+            : string.Join('|', options.Filters.Select(f => $"{f.Name}|{string.Join(';', f.Patterns)}")));
+        IsMultiSelectEnabled = options.IsMultiSelectEnabled;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        Marshal.FreeHGlobal(Title);
+        Marshal.FreeHGlobal(InitialDirectory);
+        Marshal.FreeHGlobal(DefaultFileName);
+        Marshal.FreeHGlobal(Filters);
+    }
+
+    private static IntPtr ToHGlobal(string? value) => value == null ? IntPtr.Zero : Marshal.StringToHGlobalAuto(value);
+}
\ No newline at end of file
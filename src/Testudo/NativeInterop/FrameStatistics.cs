@@ -0,0 +1,48 @@
+using System.Runtime.InteropServices;
+
+namespace Testudo;
+
+/// <summary>
+/// Describes the outbound messages that were flushed to a web view in a single display frame.
+/// </summary>
+/// <remarks>
+/// Only reported when <see cref="TestudoWindowConfiguration.IsFrameAlignedMessagingEnabled" /> is set.
+/// </remarks>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct FrameStatistics
+{
+    /// <summary>
+    /// The frame clock's counter for the frame.
+    /// </summary>
+    public readonly long FrameCounter;
+
+    /// <summary>
+    /// The time of the frame in microseconds on the monotonic clock.
+    /// </summary>
+    public readonly long FrameTime;
+
+    /// <summary>
+    /// The display's refresh interval in microseconds.
+    /// </summary>
+    public readonly long RefreshInterval;
+
+    /// <summary>
+    /// The number of messages that were coalesced into this frame.
+    /// </summary>
+    public readonly int MessageCount;
+
+    /// <summary>
+    /// The total size of the coalesced messages in bytes.
+    /// </summary>
+    public readonly int ByteCount;
+
+    /// <summary>
+    /// The number of frames so far that flushed messages later than the display refresh after they were queued.
+    /// </summary>
+    public readonly int LateFrameCount;
+
+    /// <summary>
+    /// Whether the oldest message in this frame waited longer than one refresh interval.
+    /// </summary>
+    public readonly bool IsLate;
+}
\ No newline at end of file
@@ -13,6 +13,32 @@ public interface ITestudoApplication : IDisposable
     /// </summary>
     int MainThreadId { get; }
 
+    /// <summary>
+    /// Raised when the main thread stops servicing its loop for longer than
+    /// <see cref="TestudoApplicationConfiguration.StallThresholdMilliseconds" />, and again when the stall ends.
+    /// </summary>
+    /// <remarks>
+    /// Raised on the watchdog thread, as the main thread is busy by definition.
+    /// </remarks>
+    event Action<StallReport>? StallDetected;
+
+    /// <summary>
+    /// Raised once the first window has rendered, with a breakdown of how long each phase of startup took.
+    /// </summary>
+    /// <remarks>
+    /// Raised once, on whichever thread reached the last phase. Subscribe before opening the first window.
+    /// </remarks>
+    event Action<StartupReport>? StartupCompleted;
+
+    /// <summary>
+    /// Raised with the latest geometry, focus, visibility, state and close requests of every window.
+    /// </summary>
+    /// <remarks>
+    /// Raised on the UI thread, at most once per main loop iteration. Each batch holds at most one event of each kind
+    /// per window, so a window that is dragged or resized only reports where it ended up.
+    /// </remarks>
+    event Action<IReadOnlyList<WindowEvent>>? WindowEventsReceived;
+
     /// <summary>
     /// Runs the main application loop until this class is disposed.
     /// </summary>
@@ -25,8 +51,53 @@ public interface ITestudoApplication : IDisposable
     /// Invokes the given action on the UI thread.
     /// </summary>
     /// <param name="action">The action to execute on the main thread.</param>
-    void Invoke(Action action);
+    /// <param name="origin">
+    /// The delegate that <paramref name="action" /> ultimately runs, used to describe it in stall reports.
+    /// Defaults to <paramref name="action" /> itself.
+    /// </param>
+    void Invoke(Action action, Delegate? origin = null);
+
+    /// <summary>
+    /// Shows a native file dialog without blocking the calling thread or the main loop.
+    /// </summary>
+    /// <param name="options">Describes the dialog.</param>
+    /// <returns>The selected paths, or an empty list if the dialog was cancelled.</returns>
+    Task<IReadOnlyList<string>> ShowFileDialogAsync(FileDialogOptions options);
 
-    /// <inheritdoc cref="TestudoApplication.TestudoApplication_OpenFolderDialog"/>
-    string? OpenFolderDialog();
+    /// <summary>
+    /// Shows a native folder selection dialog without blocking the calling thread or the main loop.
+    /// </summary>
+    /// <returns>The path to the selected folder, or null if no folder was selected.</returns>
+    Task<string?> OpenFolderDialogAsync();
+
+    /// <summary>
+    /// Sends the same JavaScript message to several windows' web views.
+    /// </summary>
+    /// <param name="message">The JavaScript message to send and evaluate.</param>
+    /// <param name="windows">The windows to send the message to, or null to send it to every open window.</param>
+    /// <remarks>
+    /// The message crosses into native code, and is escaped and formatted, once rather than once per window.
+    /// Messages still in a window's message ring are delivered first. When called from another thread, this waits
+    /// for the message to be handed to every web view on the UI thread.
+    /// </remarks>
+    void Broadcast(string message, IEnumerable<ITestudoWindow>? windows = null);
+
+    /// <summary>
+    /// Sends the same JavaScript message to the web view of every window that has joined the given channel.
+    /// </summary>
+    /// <param name="channel">The name of the channel, see <see cref="ITestudoWindow.JoinChannel" />.</param>
+    /// <param name="message">The JavaScript message to send and evaluate.</param>
+    /// <remarks>
+    /// See <see cref="Broadcast" />.
+    /// </remarks>
+    void BroadcastToChannel(string channel, string message);
+
+    /// <summary>
+    /// Reports the memory held by every window in the application.
+    /// </summary>
+    /// <remarks>
+    /// The served resource totals include windows that have since been closed. The fields that only make sense for
+    /// a single window, such as <see cref="MemoryReport.WebProcessId" />, are left empty.
+    /// </remarks>
+    MemoryReport GetMemoryReport();
 }
\ No newline at end of file
@@ -5,11 +5,67 @@ namespace Testudo;
 /// </summary>
 public interface ITestudoWindow : IAsyncDisposable
 {
+    /// <summary>
+    /// Raised when the web view sends a binary message, such as an <c>ArrayBuffer</c> passed to
+    /// <c>testudo.send</c> when the Linux web extension is enabled.
+    /// </summary>
+    /// <remarks>
+    /// Raised on the UI thread.
+    /// </remarks>
+    event Action<byte[]>? BinaryMessageReceived;
+
+    /// <summary>
+    /// Raised after each display frame that flushed outbound messages, when
+    /// <see cref="TestudoWindowConfiguration.IsFrameAlignedMessagingEnabled" /> is set.
+    /// </summary>
+    /// <remarks>
+    /// Raised on the UI thread.
+    /// </remarks>
+    event Action<FrameStatistics>? FrameStatisticsReported;
+
+    /// <summary>
+    /// Raised when the web view falls behind on outbound messages, and again when it catches up, as set by
+    /// <see cref="TestudoWindowConfiguration.OutboundHighWaterMarkBytes" />.
+    /// </summary>
+    /// <remarks>
+    /// Raised on the UI thread, with the new value of <see cref="IsBackPressured" />.
+    /// </remarks>
+    event Action<bool>? BackPressureChanged;
+
+    /// <summary>
+    /// Raised once the page has painted the result of an interaction, when
+    /// <see cref="TestudoWindowConfiguration.IsLatencyTracingEnabled" /> is set.
+    /// </summary>
+    /// <remarks>
+    /// Raised on the UI thread.
+    /// </remarks>
+    event Action<InteractionLatencyReport>? InteractionTraced;
+
+    /// <summary>
+    /// Whether the web view has fallen behind on outbound messages, in which case low-priority producers should
+    /// pause until it catches up.
+    /// </summary>
+    /// <remarks>
+    /// Messages can still be sent while this is set, they are simply queued behind the ones that are outstanding.
+    /// </remarks>
+    bool IsBackPressured { get; }
+
     /// <summary>
     /// Adds the root Razor component to this window's web view.
     /// </summary>
     /// <typeparam name="TComponent">The type of the Razor component to add.</typeparam>
-    void AddRootComponent<TComponent>();
+    /// <remarks>
+    /// If the page has not signalled that it is ready yet, the component is attached once it does.
+    /// </remarks>
+    Task AddRootComponentAsync<TComponent>();
+
+    /// <summary>
+    /// Restores this window if it is minimized, and brings it to the front with focus.
+    /// </summary>
+    /// <remarks>
+    /// The window manager may only flash the window instead, if the application is not in the foreground.
+    /// </remarks>
+    void Activate();
 
     /// <summary>
     /// Navigates this window's web view to the given URI.
@@ -21,5 +77,64 @@ public interface ITestudoWindow : IAsyncDisposable
     /// Sends a JavaScript message to this window's web view for evaluation.
     /// </summary>
     /// <param name="message">The JavaScript message to send and evaluate.</param>
+    /// <remarks>
+    /// When <see cref="TestudoWindowConfiguration.MessageRingCapacity" /> is set, this waits for space if the ring
+    /// is full.
+    /// </remarks>
     void SendMessage(string message);
+
+    /// <summary>
+    /// Sends a JavaScript message to this window's web view for evaluation, unless its message ring is full.
+    /// </summary>
+    /// <param name="message">The JavaScript message to send and evaluate.</param>
+    /// <returns>
+    /// Whether the message was sent, which it always is if
+    /// <see cref="TestudoWindowConfiguration.MessageRingCapacity" /> is not set.
+    /// </returns>
+    bool TrySendMessage(string message);
+
+    /// <summary>
+    /// Subscribes this window to messages sent with <see cref="ITestudoApplication.BroadcastToChannel" />.
+    /// </summary>
+    /// <param name="channel">The name of the channel.</param>
+    void JoinChannel(string channel);
+
+    /// <summary>
+    /// Unsubscribes this window from messages sent with <see cref="ITestudoApplication.BroadcastToChannel" />.
+    /// </summary>
+    /// <param name="channel">The name of the channel.</param>
+    void LeaveChannel(string channel);
+
+    /// <summary>
+    /// Waits until the web view is not behind on outbound messages, for producers that can wait their turn.
+    /// </summary>
+    /// <param name="cancellationToken">Stops waiting.</param>
+    /// <returns>A task that completes once <see cref="IsBackPressured" /> is false.</returns>
+    /// <remarks>
+    /// Completes immediately if the web view is keeping up. Must not be awaited synchronously on the UI thread, as
+    /// the web view reports its progress there.
+    /// </remarks>
+    Task WaitForCapacityAsync(CancellationToken cancellationToken = default);
+
+    /// <summary>
+    /// Evaluates JavaScript in this window's web view without blocking the caller or the UI thread.
+    /// </summary>
+    /// <param name="script">The JavaScript to evaluate.</param>
+    /// <returns>The result of the evaluation serialized as JSON.</returns>
+    /// <remarks>
+    /// Any number of evaluations can be in flight at once. The returned task faults with a
+    /// <see cref="Microsoft.JSInterop.JSException" /> if the evaluation fails, including when the script throws. On
+    /// Windows, WebView2 runtimes older than version 114 cannot report a thrown exception, and the task completes with
+    /// <c>null</c> instead.
+    /// </remarks>
+    Task<string> ExecuteScriptAsync(string script);
+
+    /// <summary>
+    /// Reports the memory that this window is holding on to, such as resource buffers and queued messages.
+    /// </summary>
+    /// <remarks>
+    /// Reads counters that are updated as the window works, so this can be called from any thread.
+    /// Returns an empty report until the window's web view has been created.
+    /// </remarks>
+    MemoryReport GetMemoryReport();
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+using System.Diagnostics.Metrics;
+
+namespace Testudo;
+
+/// <summary>
+/// Per-window memory metrics, published through <c>System.Diagnostics.Metrics</c> under the
+/// <see cref="MeterName" /> meter.
+/// </summary>
+/// <remarks>
+/// The instruments are observable, so the native counters are only read when a listener such as
+/// <c>dotnet-counters monitor --counters Testudo.Memory</c> collects them. Per-window measurements are tagged with
+/// the window's title.
+/// </remarks>
+internal static class MemoryMetrics
+{
+    /// <summary>
+    /// The name of the meter that the instruments are published under.
+    /// </summary>
+    public const string MeterName = "Testudo.Memory";
+
+    private static readonly Meter Meter = new(MeterName);
+
+    private static int _isInitialized;
+
+    /// <summary>
+    /// Creates the instruments, unless they have already been created.
+    /// </summary>
+    public static void Initialize()
+    {
+        if (Interlocked.Exchange(ref _isInitialized, 1) == 1)
+        {
+            return;
+        }
+
+        Meter.CreateObservableCounter("testudo.window.resource.served",
+            () => ObserveWindows(report => report.ResourceBytesServed), "By",
+            "Total size of the app:// resources each window has served.");
+
+        Meter.CreateObservableUpDownCounter("testudo.window.resource.held",
+            () => ObserveWindows(report => report.ResourceBytesHeld), "By",
+            "Size of the resource buffers each window's web view has not released yet.");
+
+        Meter.CreateObservableUpDownCounter("testudo.window.message_queue.size",
+            () => ObserveWindows(report => report.QueuedMessageBytes), "By",
+            "Size of the outbound messages waiting to be flushed to each window's web view.");
+
+        Meter.CreateObservableUpDownCounter("testudo.window.script.pending",
+            () => ObserveWindows(report => report.PendingScriptCount), "{script}",
+            "Number of script evaluations still in flight in each window.");
+
+        Meter.CreateObservableGauge("testudo.window.web_process.memory",
+            () => ObserveWindows(report => report.WebProcessResidentBytes, report => report.WebProcessId != 0), "By",
+            "Resident memory of the process hosting each window's web view, which may be shared between windows.");
+
+        Meter.CreateObservableCounter("testudo.resource.served",
+            () => TestudoApplication.GetMemoryTotals().ResourceBytesServed, "By",
+            "Total size of the app:// resources served by every window, including closed ones.");
+
+        Meter.CreateObservableUpDownCounter("testudo.resource.held",
+            () => TestudoApplication.GetMemoryTotals().ResourceBytesHeld, "By",
+            "Size of the resource buffers across every window that have not been released yet.");
+
+        Meter.CreateObservableUpDownCounter("testudo.message_queue.size",
+            () => TestudoApplication.GetMemoryTotals().QueuedMessageBytes, "By",
+            "Size of the outbound messages waiting to be flushed across every window.");
+    }
+
+    private static IEnumerable<Measurement<long>> ObserveWindows(Func<MemoryReport, long> selector,
+        Func<MemoryReport, bool>? filter = null)
+    {
+        foreach (var (title, report) in TestudoWindow.GetOpenWindowMemoryReports())
+        {
+            if (filter == null || filter(report))
+            {
+                yield return new Measurement<long>(selector(report),
+                    new KeyValuePair<string, object?>("window.title", title));
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+using System.Runtime.InteropServices;
+
+namespace Testudo;
+
+/// <summary>
+/// Describes the memory that a window, or the application as a whole, is holding on to.
+/// </summary>
+/// <remarks>
+/// Returned by <see cref="ITestudoWindow.GetMemoryReport" /> and <see cref="ITestudoApplication.GetMemoryReport" />,
+/// and published as metrics under the <see cref="MemoryMetrics.MeterName" /> meter.
+/// </remarks>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct MemoryReport
+{
+    /// <summary>
+    /// The total size of the <c>app://</c> resources served so far in bytes.
+    /// </summary>
+    public readonly long ResourceBytesServed;
+
+    /// <summary>
+    /// The number of <c>app://</c> resources served so far.
+    /// </summary>
+    public readonly long ResourceCount;
+
+    /// <summary>
+    /// The size of the resource buffers that the web view has not released yet in bytes.
+    /// </summary>
+    /// <remarks>
+    /// Always zero on Windows, where buffers are copied into the response and freed straight away.
+    /// </remarks>
+    public readonly long ResourceBytesHeld;
+
+    /// <summary>
+    /// The size of the outbound messages waiting to be flushed to the web view in bytes.
+    /// </summary>
+    /// <remarks>
+    /// Only messages held back by <see cref="TestudoWindowConfiguration.IsFrameAlignedMessagingEnabled" /> are queued.
+    /// </remarks>
+    public readonly long QueuedMessageBytes;
+
+    /// <summary>
+    /// The resident memory of the process that hosts the web view in bytes, or -1 if it is not known.
+    /// </summary>
+    /// <remarks>
+    /// This is the web process on Linux and the browser process on Windows, either of which may be shared by several
+    /// windows.
+    /// </remarks>
+    public readonly long WebProcessResidentBytes;
+
+    /// <summary>
+    /// The number of outbound messages waiting to be flushed to the web view.
+    /// </summary>
+    public readonly int QueuedMessageCount;
+
+    /// <summary>
+    /// The number of script evaluations that are still in flight.
+    /// </summary>
+    public readonly int PendingScriptCount;
+
+    /// <summary>
+    /// The ID of the process that hosts the web view, or 0 if it is not known yet.
+    /// </summary>
+    /// <remarks>
+    /// Only known on Linux when the web extension is enabled, as it is read from the extension's connection.
+    /// </remarks>
+    public readonly int WebProcessId;
+}
\ No newline at end of file
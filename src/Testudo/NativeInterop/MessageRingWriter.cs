@@ -0,0 +1,110 @@
+using System.Buffers;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Testudo;
+
+/// <summary>
+/// Writes outbound messages into a window's native message ring, so that sending a message does not have to call
+/// into native code.
+/// </summary>
+/// <remarks>
+/// The ring has a single producer, so callers must not write from more than one thread at a time. The doorbell is
+/// only rung when the ring goes from drained to not, so a burst of messages costs a single native call.
+/// </remarks>
+internal sealed unsafe class MessageRingWriter
+{
+    /// <summary>
+    /// The size of the length that precedes each message in the ring.
+    /// </summary>
+    private const int LengthPrefixSize = sizeof(int);
+
+    /// <summary>
+    /// The encoding of <see cref="TestudoWindowConfiguration" /> strings on the current platform, which the ring
+    /// uses so that native code can pass messages straight on.
+    /// </summary>
+    private static readonly Encoding NativeEncoding = OperatingSystem.IsWindows() ? Encoding.Unicode : Encoding.UTF8;
+
+    private readonly NativeMessageRing* _ring;
+
+    /// <summary>
+    /// Queues the ring to be drained on the main thread.
+    /// </summary>
+    private readonly Action _ringDoorbell;
+
+    /// <summary>
+    /// Creates a writer for the given ring.
+    /// </summary>
+    /// <param name="ring">Pointer to the native ring, which must outlive this writer.</param>
+    /// <param name="ringDoorbell">Queues the ring to be drained on the main thread.</param>
+    public MessageRingWriter(IntPtr ring, Action ringDoorbell)
+    {
+        _ring = (NativeMessageRing*)ring;
+        _ringDoorbell = ringDoorbell;
+    }
+
+    /// <summary>
+    /// Whether every message written so far has been read by the main thread.
+    /// </summary>
+    public bool IsEmpty => Volatile.Read(ref _ring->ReadOffset) == _ring->WriteOffset;
+
+    /// <summary>
+    /// Writes a message into the ring.
+    /// </summary>
+    /// <param name="message">The message to write.</param>
+    /// <param name="isTooLarge">Whether the message could never fit, even if the ring was empty.</param>
+    /// <returns>Whether the message was written, which it is not if there is not enough free space.</returns>
+    public bool TryWrite(string message, out bool isTooLarge)
+    {
+        var capacity = _ring->Capacity;
+        var sizeBytes = NativeEncoding.GetByteCount(message);
+        var recordSize = LengthPrefixSize + ((sizeBytes + 3) & ~3);
+        isTooLarge = recordSize > capacity;
+
+        var writeOffset = _ring->WriteOffset;
+        if (isTooLarge || recordSize > capacity - (writeOffset - Volatile.Read(ref _ring->ReadOffset)))
+        {
+            return false;
+        }
+
+        // Records are aligned to the length prefix, so only the message itself can wrap around the end of the ring
+        var mask = capacity - 1;
+        *(int*)(_ring->Data + (writeOffset & mask)) = sizeBytes;
+        var start = (int)((writeOffset + LengthPrefixSize) & mask);
+        if (start + sizeBytes <= capacity)
+        {
+            NativeEncoding.GetBytes(message, new Span<byte>(_ring->Data + start, sizeBytes));
+        }
+        else
+        {
+            var buffer = ArrayPool<byte>.Shared.Rent(sizeBytes);
+            NativeEncoding.GetBytes(message, buffer);
+            var firstPart = capacity - start;
+            buffer.AsSpan(0, firstPart).CopyTo(new Span<byte>(_ring->Data + start, firstPart));
+            buffer.AsSpan(firstPart, sizeBytes - firstPart).CopyTo(new Span<byte>(_ring->Data, sizeBytes - firstPart));
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+
+        // Publish the record before checking the doorbell, which the main thread clears before it reads the offset
+        Volatile.Write(ref _ring->WriteOffset, writeOffset + recordSize);
+        if (Interlocked.Exchange(ref _ring->IsDrainScheduled, 1) == 0)
+        {
+            _ringDoorbell();
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Mirrors the native <c>MessageRing</c>, whose fields are each aligned to their own cache line.
+    /// </summary>
+    [StructLayout(LayoutKind.Explicit)]
+    private struct NativeMessageRing
+    {
+        [FieldOffset(0)] public long WriteOffset;
+        [FieldOffset(64)] public long ReadOffset;
+        [FieldOffset(128)] public int IsDrainScheduled;
+        [FieldOffset(132)] public int Capacity;
+        [FieldOffset(136)] public byte* Data;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+using System.Runtime.InteropServices;
+
+namespace Testudo;
+
+/// <summary>
+/// The kinds of work that the main thread can be doing when it stalls.
+/// </summary>
+public enum StallActivityKind
+{
+    /// <summary>
+    /// The main loop was stalled outside any tracked work.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// An action passed to <see cref="ITestudoApplication.Invoke" />.
+    /// </summary>
+    Invoke = 1,
+
+    /// <summary>
+    /// A web resource request being served by <see cref="TestudoWebViewManager" />.
+    /// </summary>
+    ResourceRequest = 2,
+
+    /// <summary>
+    /// A web message being handled by <see cref="TestudoWebViewManager" />.
+    /// </summary>
+    WebMessage = 3
+}
+
+/// <summary>
+/// Describes a period during which the main thread stopped servicing its loop.
+/// </summary>
+/// <remarks>
+/// Only reported when <see cref="TestudoApplicationConfiguration.StallThresholdMilliseconds" /> is set.
+/// </remarks>
+public sealed class StallReport
+{
+    /// <summary>
+    /// The upper bound of each bucket in <see cref="Histogram" />, the last bucket is unbounded.
+    /// </summary>
+    public static IReadOnlyList<TimeSpan> HistogramBucketBounds { get; } =
+    [
+        TimeSpan.FromMilliseconds(250),
+        TimeSpan.FromMilliseconds(500),
+        TimeSpan.FromSeconds(1),
+        TimeSpan.FromSeconds(2),
+        TimeSpan.FromSeconds(5),
+        TimeSpan.FromSeconds(10),
+        TimeSpan.FromSeconds(30)
+    ];
+
+    /// <summary>
+    /// How long the main thread has been stalled for.
+    /// </summary>
+    public required TimeSpan Duration { get; init; }
+
+    /// <summary>
+    /// Whether the stall is still in progress. A final report is raised once it ends.
+    /// </summary>
+    public required bool IsOngoing { get; init; }
+
+    /// <summary>
+    /// The kind of work the main thread was doing when the stall was detected.
+    /// </summary>
+    public required StallActivityKind ActivityKind { get; init; }
+
+    /// <summary>
+    /// Describes the work the main thread was doing when the stall was detected, such as the invoked method,
+    /// the requested URI, or the start of the web message.
+    /// </summary>
+    public required string? Activity { get; init; }
+
+    /// <summary>
+    /// The number of stalls that have ended so far, bucketed by <see cref="HistogramBucketBounds" />.
+    /// </summary>
+    public required IReadOnlyList<int> Histogram { get; init; }
+
+    /// <inheritdoc />
+    public override string ToString() => IsOngoing
+        ? $"Main thread stalled for {Duration.TotalMilliseconds:0}ms so far in {ActivityKind} {Activity}"
+        : $"Main thread stalled for {Duration.TotalMilliseconds:0}ms in {ActivityKind} {Activity}";
+}
+
+/// <summary>
+/// The native layout of <see cref="StallReport" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct NativeStallReport
+{
+    /// <summary>
+    /// The number of buckets in <see cref="Histogram" />.
+    /// </summary>
+    public const int HistogramBucketCount = 8;
+
+    public long DurationMilliseconds;
+
+    [MarshalAs(UnmanagedType.U1)]
+    public bool IsOngoing;
+
+    public StallActivityKind ActivityKind;
+
+    public IntPtr Activity;
+
+    public fixed int Histogram[HistogramBucketCount];
+
+    /// <summary>
+    /// Copies this report into managed memory.
+    /// </summary>
+    public StallReport ToStallReport()
+    {
+        var histogram = new int[HistogramBucketCount];
+        for (var i = 0; i < HistogramBucketCount; i++)
+        {
+            histogram[i] = Histogram[i];
+        }
+
+        return new StallReport
+        {
+            Duration = TimeSpan.FromMilliseconds(DurationMilliseconds),
+            IsOngoing = IsOngoing,
+            ActivityKind = ActivityKind,
+            Activity = Marshal.PtrToStringAuto(Activity),
+            Histogram = histogram
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Text.Json;
+
+namespace Testudo;
+
+/// <summary>
+/// The phases of startup that are timed, roughly in the order they are reached.
+/// </summary>
+public enum StartupPhase
+{
+    /// <summary>
+    /// The host and its service provider were built, which is when <see cref="ITestudoApplication" /> is resolved.
+    /// </summary>
+    HostBuilt = 0,
+
+    /// <summary>
+    /// The native application started initializing.
+    /// </summary>
+    ApplicationCreating = 1,
+
+    /// <summary>
+    /// The UI toolkit was initialized, which is <c>gtk_init</c> on Linux and the message window on Windows.
+    /// </summary>
+    ToolkitInitialized = 2,
+
+    /// <summary>
+    /// The native application finished initializing.
+    /// </summary>
+    ApplicationCreated = 3,
+
+    /// <summary>
+    /// The first native window started being created.
+    /// </summary>
+    WindowCreating = 4,
+
+    /// <summary>
+    /// The first native window was created.
+    /// </summary>
+    WindowCreated = 5,
+
+    /// <summary>
+    /// The first web view was created.
+    /// </summary>
+    WebViewCreated = 6,
+
+    /// <summary>
+    /// The first web view started navigating, which is when WebKit spawns its web process.
+    /// </summary>
+    NavigationStarted = 7,
+
+    /// <summary>
+    /// The first web resource was requested.
+    /// </summary>
+    FirstResourceRequested = 8,
+
+    /// <summary>
+    /// The first web view committed to the page and started loading its content.
+    /// </summary>
+    NavigationCommitted = 9,
+
+    /// <summary>
+    /// <c>blazor.webview.js</c> was requested.
+    /// </summary>
+    FrameworkScriptRequested = 10,
+
+    /// <summary>
+    /// The first web view finished loading the page.
+    /// </summary>
+    NavigationFinished = 11,
+
+    /// <summary>
+    /// The first render batch was sent to the web view.
+    /// </summary>
+    FirstRenderBatchSent = 12,
+
+    /// <summary>
+    /// The web view acknowledged the first render batch, meaning it has been applied to the page.
+    /// </summary>
+    FirstRenderCompleted = 13,
+
+    /// <summary>
+    /// The web view painted a frame after the first render. Only reported on Linux.
+    /// </summary>
+    FirstPaint = 14
+}
+
+/// <summary>
+/// Describes when a phase of startup was reached.
+/// </summary>
+/// <param name="Phase">The phase that was reached.</param>
+/// <param name="Elapsed">The time from process start until the phase was reached.</param>
+public readonly record struct StartupPhaseTiming(StartupPhase Phase, TimeSpan Elapsed);
+
+/// <summary>
+/// Describes how long each phase of startup took, from process start to the first Blazor render.
+/// </summary>
+/// <remarks>
+/// Raised once through <see cref="ITestudoApplication.StartupCompleted" />.
+/// </remarks>
+public sealed class StartupReport
+{
+    /// <summary>
+    /// The phases that were reached, in the order they were reached.
+    /// </summary>
+    public required IReadOnlyList<StartupPhaseTiming> Phases { get; init; }
+
+    /// <summary>
+    /// The time from process start until the last phase was reached.
+    /// </summary>
+    public TimeSpan Total => Phases.Count > 0 ? Phases[^1].Elapsed : TimeSpan.Zero;
+
+    /// <summary>
+    /// Serializes this report to JSON, with each phase's time since process start and since the previous phase.
+    /// </summary>
+    public string ToJson()
+    {
+        using var stream = new MemoryStream();
+        using (var writer = new Utf8JsonWriter(stream, new JsonWriterOptions {Indented = true}))
+        {
+            writer.WriteStartObject();
+            writer.WriteNumber("totalMilliseconds", Total.TotalMilliseconds);
+            writer.WriteStartArray("phases");
+
+            var previous = TimeSpan.Zero;
+            foreach (var (phase, elapsed) in Phases)
+            {
+                writer.WriteStartObject();
+                writer.WriteString("phase", phase.ToString());
+                writer.WriteNumber("elapsedMilliseconds", elapsed.TotalMilliseconds);
+                writer.WriteNumber("deltaMilliseconds", (elapsed - previous).TotalMilliseconds);
+                writer.WriteEndObject();
+                previous = elapsed;
+            }
+
+            writer.WriteEndArray();
+            writer.WriteEndObject();
+        }
+
+        return Encoding.UTF8.GetString(stream.ToArray());
+    }
+
+    /// <inheritdoc />
+    public override string ToString()
+    {
+        var builder = new StringBuilder($"Startup took {Total.TotalMilliseconds:0}ms:");
+        var previous = TimeSpan.Zero;
+        foreach (var (phase, elapsed) in Phases)
+        {
+            builder.Append($" {phase} +{(elapsed - previous).TotalMilliseconds:0}ms,");
+            previous = elapsed;
+        }
+
+        return builder.ToString().TrimEnd(',');
+    }
+}
+
+/// <summary>
+/// The native layout of <see cref="StartupReport" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct NativeStartupReport
+{
+    /// <summary>
+    /// The number of values in <see cref="StartupPhase" />.
+    /// </summary>
+    public const int PhaseCount = 15;
+
+    public fixed long ElapsedMicroseconds[PhaseCount];
+
+    /// <summary>
+    /// Copies this report into managed memory.
+    /// </summary>
+    public StartupReport ToStartupReport()
+    {
+        var phases = new List<StartupPhaseTiming>(PhaseCount);
+        for (var i = 0; i < PhaseCount; i++)
+        {
+            // Phases that were never reached are reported as -1
+            if (ElapsedMicroseconds[i] >= 0)
+            {
+                phases.Add(new StartupPhaseTiming((StartupPhase)i,
+                    TimeSpan.FromTicks(ElapsedMicroseconds[i] * TimeSpan.TicksPerMicrosecond)));
+            }
+        }
+
+        phases.Sort((a, b) => a.Elapsed.CompareTo(b.Elapsed));
+        return new StartupReport {Phases = phases};
+    }
+}
\ No newline at end of file
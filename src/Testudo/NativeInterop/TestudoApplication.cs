@@ -1,3 +1,6 @@
+using System.Collections.Concurrent;
+using System.Reflection;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 
 namespace Testudo;
@@ -15,23 +18,111 @@ public partial class TestudoApplication : ITestudoApplication
     /// </summary>
     private GCHandle _configurationHandle;
 
+    /// <summary>
+    /// The application that stall reports are raised on, as the native watchdog is not tied to an instance.
+    /// </summary>
+    private static TestudoApplication? _stallReportReceiver;
+
+    /// <summary>
+    /// The application that the startup report is raised on, as the native profiler is not tied to an instance.
+    /// </summary>
+    private static TestudoApplication? _startupReportReceiver;
+
+    /// <summary>
+    /// The application that window events are raised on, as the native queue is shared by every window.
+    /// </summary>
+    private static TestudoApplication? _windowEventsReceiver;
+
+    /// <summary>
+    /// The file dialogs that are still open, keyed by request ID.
+    /// </summary>
+    private static readonly ConcurrentDictionary<int, TaskCompletionSource<IReadOnlyList<string>>> _fileDialogs = new();
+
+    /// <summary>
+    /// The ID of the most recently shown file dialog.
+    /// </summary>
+    private static int _lastFileDialogRequestId;
+
+    /// <summary>
+    /// Whether invocations should be tagged for the stall watchdog.
+    /// </summary>
+    private readonly bool _isStallWatchdogEnabled;
+
+    /// <summary>
+    /// The stall watchdog tags of the methods that have been invoked so far, so each is only formatted once.
+    /// </summary>
+    private static readonly ConditionalWeakTable<MethodInfo, string> _invokeTags = new();
+
     /// <summary>
     /// Creates a new native application.
     /// </summary>
     /// <param name="configuration">The application configuration.</param>
     public TestudoApplication(TestudoApplicationConfigurationWrapper configuration)
     {
-        _configurationHandle = GCHandle.Alloc(configuration.Configuration, GCHandleType.Pinned);
+        // This is resolved once the host has been built, so this is as close as the library gets to that point
+        MarkStartupPhase(StartupPhase.HostBuilt);
+        MemoryMetrics.Initialize();
+
+        var nativeConfiguration = configuration.Configuration;
+        if (nativeConfiguration.StallThresholdMilliseconds > 0)
+        {
+            _isStallWatchdogEnabled = true;
+            _stallReportReceiver = this;
+            var pStallDetectedHandler = typeof(TestudoApplication)
+                .GetMethod(nameof(StallDetectedHandler), BindingFlags.Static | BindingFlags.Public)!
+                .MethodHandle.GetFunctionPointer();
+            nativeConfiguration.SetStallDetectedHandler(pStallDetectedHandler);
+        }
+
+        var pFileDialogCompletedHandler = typeof(TestudoApplication)
+            .GetMethod(nameof(FileDialogCompletedHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        nativeConfiguration.SetFileDialogCompletedHandler(pFileDialogCompletedHandler);
+
+        _startupReportReceiver = this;
+        var pStartupCompletedHandler = typeof(TestudoApplication)
+            .GetMethod(nameof(StartupCompletedHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        nativeConfiguration.SetStartupCompletedHandler(pStartupCompletedHandler);
+
+        _windowEventsReceiver = this;
+        var pWindowEventsHandler = typeof(TestudoApplication)
+            .GetMethod(nameof(WindowEventsHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        nativeConfiguration.SetWindowEventsHandler(pWindowEventsHandler);
+
+        _configurationHandle = GCHandle.Alloc(nativeConfiguration, GCHandleType.Pinned);
         _instance = TestudoApplication_Construct(_configurationHandle.AddrOfPinnedObject());
     }
 
     /// <inheritdoc />
     public int MainThreadId { get; } = Environment.CurrentManagedThreadId;
 
+    /// <inheritdoc />
+    public event Action<StallReport>? StallDetected;
+
+    /// <inheritdoc />
+    public event Action<StartupReport>? StartupCompleted;
+
+    /// <inheritdoc />
+    public event Action<IReadOnlyList<WindowEvent>>? WindowEventsReceived;
+
     /// <inheritdoc />
     public void Dispose()
     {
         TestudoApplication_Destroy(_instance);
+        Interlocked.CompareExchange(ref _stallReportReceiver, null, this);
+        Interlocked.CompareExchange(ref _startupReportReceiver, null, this);
+        Interlocked.CompareExchange(ref _windowEventsReceiver, null, this);
+
+        // Dialogs that were still open when the main loop ended will never complete
+        foreach (var requestId in _fileDialogs.Keys)
+        {
+            if (_fileDialogs.TryRemove(requestId, out var completion))
+            {
+                completion.TrySetCanceled();
+            }
+        }
 
         if (_configurationHandle.IsAllocated)
         {
@@ -48,13 +139,19 @@ public partial class TestudoApplication : ITestudoApplication
     }
 
     /// <inheritdoc />
-    public void Invoke(Action action)
+    public void Invoke(Action action, Delegate? origin = null)
     {
         if (Environment.CurrentManagedThreadId == MainThreadId)
         {
             // Already on the UI thread, no point dispatching
             action();
         }
+        else if (_isStallWatchdogEnabled)
+        {
+            var tag = _invokeTags.GetValue((origin ?? action).Method,
+                static method => $"{method.DeclaringType?.FullName}.{method.Name}");
+            TestudoApplication_InvokeTagged(action.Invoke, tag);
+        }
         else
         {
             TestudoApplication_Invoke(action.Invoke);
@@ -62,5 +159,140 @@ public partial class TestudoApplication : ITestudoApplication
     }
 
     /// <inheritdoc />
-    public string? OpenFolderDialog() => TestudoApplication_OpenFolderDialog();
+    public Task<IReadOnlyList<string>> ShowFileDialogAsync(FileDialogOptions options)
+    {
+        var requestId = Interlocked.Increment(ref _lastFileDialogRequestId);
+        var completion =
+            new TaskCompletionSource<IReadOnlyList<string>>(TaskCreationOptions.RunContinuationsAsynchronously);
+        _fileDialogs[requestId] = completion;
+
+        // The native library copies the options, so they can be freed as soon as the call returns
+        var nativeOptions = new NativeFileDialogOptions(options);
+        try
+        {
+            TestudoApplication_ShowFileDialog(requestId, ref nativeOptions);
+        }
+        finally
+        {
+            nativeOptions.Dispose();
+        }
+
+        return completion.Task;
+    }
+
+    /// <inheritdoc />
+    public async Task<string?> OpenFolderDialogAsync()
+    {
+        var paths = await ShowFileDialogAsync(new FileDialogOptions {Kind = FileDialogKind.OpenFolder});
+        return paths.Count > 0 ? paths[0] : null;
+    }
+
+    /// <inheritdoc />
+    public void Broadcast(string message, IEnumerable<ITestudoWindow>? windows = null)
+    {
+        if (windows == null)
+        {
+            TestudoWindow.Broadcast(this, message, _ => true);
+            return;
+        }
+
+        var targets = windows.ToHashSet();
+        TestudoWindow.Broadcast(this, message, targets.Contains);
+    }
+
+    /// <inheritdoc />
+    public void BroadcastToChannel(string channel, string message) =>
+        TestudoWindow.Broadcast(this, message, window => window.IsInChannel(channel));
+
+    /// <inheritdoc />
+    public MemoryReport GetMemoryReport() => GetMemoryTotals();
+
+    /// <inheritdoc cref="GetMemoryReport" />
+    internal static MemoryReport GetMemoryTotals()
+    {
+        TestudoApplication_GetMemoryReport(out var report);
+        return report;
+    }
+
+    /// <summary>
+    /// Stamps a phase of startup that is only observable from managed code.
+    /// </summary>
+    /// <param name="phase">The phase that was reached. Ignored if it has already been reached.</param>
+    internal static void MarkStartupPhase(StartupPhase phase) => TestudoApplication_MarkStartupPhase(phase);
+
+    /// <summary>
+    /// Gets when the native window received the web message that is being handled on the main thread.
+    /// </summary>
+    /// <returns>The time in microseconds on the <see cref="System.Diagnostics.Stopwatch" /> clock.</returns>
+    internal static long GetLastMessageReceivedTime() => TestudoApplication_GetLastMessageReceivedTime();
+
+    /// <summary>
+    /// Completes the task returned by <see cref="ShowFileDialogAsync" />.
+    /// </summary>
+    /// <param name="requestId">The ID that the dialog was shown with.</param>
+    /// <param name="pathCount">The number of selected paths, or 0 if the dialog was cancelled.</param>
+    /// <param name="pPaths">Pointer to the selected paths, which are only valid for the duration of the call.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe void FileDialogCompletedHandler(int requestId, int pathCount, IntPtr pPaths)
+    {
+        var paths = new string[pathCount];
+        for (var i = 0; i < pathCount; i++)
+        {
+            paths[i] = Marshal.PtrToStringAuto(((IntPtr*)pPaths)[i])!;
+        }
+
+        if (_fileDialogs.TryRemove(requestId, out var completion))
+        {
+            completion.SetResult(paths);
+        }
+    }
+
+    /// <summary>
+    /// Raises <see cref="StallDetected" />.
+    /// </summary>
+    /// <param name="pReport">Pointer to the report, which is only valid for the duration of the call.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe void StallDetectedHandler(IntPtr pReport)
+    {
+        _stallReportReceiver?.StallDetected?.Invoke(((NativeStallReport*)pReport)->ToStallReport());
+    }
+
+    /// <summary>
+    /// Raises <see cref="StartupCompleted" />.
+    /// </summary>
+    /// <param name="pReport">Pointer to the report, which is only valid for the duration of the call.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe void StartupCompletedHandler(IntPtr pReport)
+    {
+        _startupReportReceiver?.StartupCompleted?.Invoke(((NativeStartupReport*)pReport)->ToStartupReport());
+    }
+
+    /// <summary>
+    /// Raises <see cref="WindowEventsReceived" />.
+    /// </summary>
+    /// <param name="pEvents">Pointer to the events, which are only valid for the duration of the call.</param>
+    /// <param name="count">The number of events.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe void WindowEventsHandler(IntPtr pEvents, int count)
+    {
+        if (_windowEventsReceiver?.WindowEventsReceived is not { } handler)
+        {
+            return;
+        }
+
+        var events = new List<WindowEvent>(count);
+        foreach (var nativeEvent in new ReadOnlySpan<NativeWindowEvent>((void*)pEvents, count))
+        {
+            // Windows that are not registered yet, or are being disposed, have nothing to raise the event for
+            if (TestudoWindow.TryGetWindow(nativeEvent.Instance, out var window))
+            {
+                events.Add(nativeEvent.ToWindowEvent(window));
+            }
+        }
+
+        if (events.Count > 0)
+        {
+            handler(events);
+        }
+    }
 }
\ No newline at end of file
@@ -18,16 +18,116 @@ public struct TestudoApplicationConfiguration : IDisposable
     /// </summary>
     public IntPtr Icon;
 
+    /// <summary>
+    /// The directory containing the Testudo web extension shared object.
+    /// </summary>
+    private IntPtr _webExtensionDirectory;
+
+    /// <summary>
+    /// How long the main loop may go unserviced before it is reported through
+    /// <see cref="ITestudoApplication.StallDetected" />, in milliseconds.
+    /// </summary>
+    /// <remarks>
+    /// Leave at 0 to disable the watchdog. Long-running invocations, resource requests and web messages are reported
+    /// even if they spin a nested loop that keeps the heartbeat alive.
+    /// </remarks>
+    public int StallThresholdMilliseconds;
+
+    /// <summary>
+    /// A delegate that receives stall reports.
+    /// </summary>
+    private IntPtr StallDetectedHandler;
+
+    /// <summary>
+    /// A delegate that receives the results of native file dialogs.
+    /// </summary>
+    private IntPtr FileDialogCompletedHandler;
+
+    /// <summary>
+    /// A delegate that receives the startup report.
+    /// </summary>
+    private IntPtr StartupCompletedHandler;
+
+    /// <summary>
+    /// Whether to start the web view engine as soon as the application is created, rather than with the first window.
+    /// </summary>
+    /// <remarks>
+    /// Spawning the browser or web process is the longest step in showing the first window, so this lets it overlap
+    /// with the rest of startup. On Linux, a web view is also loaded ahead of time for the first window to adopt.
+    /// Leave disabled for background applications that may never show a window.
+    /// </remarks>
+    [MarshalAs(UnmanagedType.U1)]
+    public bool IsWebViewPrewarmEnabled;
+
+    /// <summary>
+    /// Whether developer tools are available to windows that set
+    /// <see cref="TestudoWindowConfiguration.AreDevToolsEnabled" />.
+    /// </summary>
+    /// <remarks>
+    /// Every window shares the same web view engine, so this applies to all of them.
+    /// </remarks>
+    [MarshalAs(UnmanagedType.U1)]
+    public bool AreDevToolsEnabled;
+
+    /// <summary>
+    /// A delegate that receives each batch of window events.
+    /// </summary>
+    private IntPtr WindowEventsHandler;
+
+    /// <summary>
+    /// The directory that the web view engine keeps its data and caches in between runs.
+    /// </summary>
+    private IntPtr _dataDirectory;
+
     /// <inheritdoc cref="_applicationName"/>
     public required string ApplicationName
     {
+        internal get => Marshal.PtrToStringAuto(_applicationName)!;
         set => _applicationName = Marshal.StringToHGlobalAuto(value);
     }
 
+    /// <inheritdoc cref="_webExtensionDirectory"/>
+    /// <remarks>
+    /// Only used on Linux. When set, each web process loads the extension, which exposes a <c>testudo</c> object
+    /// to JavaScript and exchanges messages with the host over a dedicated socket rather than through the script
+    /// message handler and script evaluation. Leave unset to disable the extension.
+    /// </remarks>
+    public string? WebExtensionDirectory
+    {
+        set => _webExtensionDirectory = value == null ? IntPtr.Zero : Marshal.StringToHGlobalAuto(value);
+    }
+
+    /// <inheritdoc cref="_dataDirectory"/>
+    /// <remarks>
+    /// Holds the engine's HTTP, script and bytecode caches along with local storage, so that a warm start can reuse
+    /// what earlier runs compiled and cached. <c>app://</c> responses are tagged with a hash of their content, so
+    /// after an update only the resources that actually changed are sent to the web view again. Resource profiles
+    /// are kept here as well. Leave unset to use the engine's default location.
+    /// </remarks>
+    public string? DataDirectory
+    {
+        internal get => Marshal.PtrToStringAuto(_dataDirectory);
+        set => _dataDirectory = value == null ? IntPtr.Zero : Marshal.StringToHGlobalAuto(Path.GetFullPath(value));
+    }
+
+    /// <inheritdoc cref="StallDetectedHandler" />
+    public void SetStallDetectedHandler(IntPtr handler) => StallDetectedHandler = handler;
+
+    /// <inheritdoc cref="FileDialogCompletedHandler" />
+    public void SetFileDialogCompletedHandler(IntPtr handler) => FileDialogCompletedHandler = handler;
+
+    /// <inheritdoc cref="StartupCompletedHandler" />
+    public void SetStartupCompletedHandler(IntPtr handler) => StartupCompletedHandler = handler;
+
+    /// <inheritdoc cref="WindowEventsHandler" />
+    public void SetWindowEventsHandler(IntPtr handler) => WindowEventsHandler = handler;
+
     /// <inheritdoc />
     public void Dispose()
     {
         Marshal.FreeHGlobal(_applicationName);
+        Marshal.FreeHGlobal(_webExtensionDirectory);
+        Marshal.FreeHGlobal(_dataDirectory);
     }
 }
 
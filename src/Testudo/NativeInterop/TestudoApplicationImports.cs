@@ -41,11 +41,41 @@ public partial class TestudoApplication
     private static extern void TestudoApplication_Invoke(InvokeAction action);
 
     /// <summary>
-    /// Opens a native folder selection dialog.
+    /// Invokes the given action on the main thread, attributing any stall it causes to the given tag.
     /// </summary>
-    /// <returns>The path to the selected folder, or null if no folder was selected.</returns>
+    /// <param name="action">The action to execute on the main thread.</param>
+    /// <param name="tag">Describes the action in stall reports.</param>
     [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true, CharSet = CharSet.Auto)]
-    private static extern string? TestudoApplication_OpenFolderDialog();
+    private static extern void TestudoApplication_InvokeTagged(InvokeAction action, string tag);
+
+    /// <summary>
+    /// Shows a native file dialog without blocking the caller or the main loop.
+    /// </summary>
+    /// <param name="requestId">The ID that the result will be reported with.</param>
+    /// <param name="options">Describes the dialog. Copied before this method returns.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern void TestudoApplication_ShowFileDialog(int requestId, ref NativeFileDialogOptions options);
+
+    /// <summary>
+    /// Stamps a phase of startup that is only observable from managed code.
+    /// </summary>
+    /// <param name="phase">The phase that was reached. Ignored if it has already been reached.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern void TestudoApplication_MarkStartupPhase(StartupPhase phase);
+
+    /// <summary>
+    /// Gets when the web message that is being handled was received, for the latency tracer.
+    /// </summary>
+    /// <returns>The time in microseconds on the steady clock.</returns>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern long TestudoApplication_GetLastMessageReceivedTime();
+
+    /// <summary>
+    /// Reports the memory held by every window in the application, including those already destroyed.
+    /// </summary>
+    /// <param name="report">Receives the report.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern void TestudoApplication_GetMemoryReport(out MemoryReport report);
 
     /// <summary>
     /// A delegate representing an <see cref="Action" /> to invoke on the main thread.
@@ -1,4 +1,5 @@
 using System.Collections.Concurrent;
+using System.Diagnostics.CodeAnalysis;
 using System.Reflection;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
@@ -7,6 +8,7 @@ using Microsoft.AspNetCore.Components.Web;
 using Microsoft.AspNetCore.Components.WebView;
 using Microsoft.Extensions.DependencyInjection;
 using Microsoft.Extensions.FileProviders;
+using Microsoft.JSInterop;
 
 namespace Testudo;
 
@@ -29,21 +31,80 @@ public partial class TestudoWindow : ITestudoWindow
     private static readonly ConcurrentDictionary<IntPtr, TestudoWebViewManager.WebResourceRequestedDelegate>
         _webResourceRequestedHandlers = [];
 
+    /// <summary>
+    /// Holds references to the script evaluated delegates for each <see cref="TestudoWindow" /> instance.<br />
+    /// <b>Key</b> — Pointer to the native instance that this class wraps.<br />
+    /// <b>Value</b> — The delegate associated with this instance.
+    /// </summary>
+    private static readonly ConcurrentDictionary<IntPtr, Action<int, bool, string>> _scriptEvaluatedHandlers = [];
+
+    /// <summary>
+    /// Holds references to each <see cref="TestudoWindow" /> instance so native events can be raised on them.<br />
+    /// <b>Key</b> — Pointer to the native instance that the window wraps.<br />
+    /// <b>Value</b> — The window associated with this instance.
+    /// </summary>
+    private static readonly ConcurrentDictionary<IntPtr, TestudoWindow> _windows = [];
+
+    /// <summary>
+    /// The ID of the most recently requested script evaluation across all windows.
+    /// </summary>
+    private static int _lastScriptRequestId;
+
+    /// <summary>
+    /// The ID of the most recently requested window creation.
+    /// </summary>
+    private static int _lastCreateRequestId;
+
+    /// <summary>
+    /// Holds the completion sources of window creations that are still in flight.<br />
+    /// <b>Key</b> — The ID of the creation request.<br />
+    /// <b>Value</b> — The completion source that receives the native instance and whether its web view was created.
+    /// </summary>
+    private static readonly ConcurrentDictionary<int, TaskCompletionSource<(IntPtr Instance, bool IsSuccess)>>
+        _pendingCreations = [];
+
+    /// <summary>
+    /// Holds the completion sources of script evaluations that are still in flight.<br />
+    /// <b>Key</b> — The ID of the evaluation request.<br />
+    /// <b>Value</b> — The completion source that receives the JSON result.
+    /// </summary>
+    private readonly ConcurrentDictionary<int, TaskCompletionSource<string>> _pendingScripts = [];
+
     /// <summary>
     /// Holds a reference to the configuration's dispose method so it can be called when this class disposes.
     /// </summary>
     private readonly Action _configurationFinalizer;
 
     /// <summary>
-    /// A pointer to the native TestudoWindow instance that this class wraps.
+    /// The URI that the web view navigates to once it has been created.
     /// </summary>
-    private readonly IntPtr _instance;
+    private readonly string? _initialUri;
+
+    /// <summary>
+    /// The title of the window, used to tell windows apart in metrics.
+    /// </summary>
+    private readonly string _title;
+
+    /// <summary>
+    /// Completes with the native instance once its web view has been created.
+    /// </summary>
+    private readonly Task<(IntPtr Instance, bool IsSuccess)> _creation;
 
     /// <summary>
     /// Holds a reference to the web view manager for the lifetime of this window to avoid it being disposed early.
     /// </summary>
     private readonly WebViewManager _webViewManager;
 
+    /// <summary>
+    /// The web view manager's web message received delegate, registered once the native instance exists.
+    /// </summary>
+    private readonly TestudoWebViewManager.WebMessageReceivedDelegate _webMessageReceivedHandler;
+
+    /// <summary>
+    /// The web view manager's web resource requested delegate, registered once the native instance exists.
+    /// </summary>
+    private readonly TestudoWebViewManager.WebResourceRequestedDelegate _webResourceRequestedHandler;
+
     /// <summary>
     /// Holds a reference to the application service.
     /// </summary>
@@ -54,14 +115,56 @@ public partial class TestudoWindow : ITestudoWindow
     /// </summary>
     private GCHandle _configurationHandle;
 
+    /// <summary>
+    /// A pointer to the native TestudoWindow instance that this class wraps.
+    /// </summary>
+    private IntPtr _instance;
+
+    /// <summary>
+    /// Writes outbound messages into the native window's message ring, or null if it was not configured with one.
+    /// </summary>
+    private MessageRingWriter? _messageRing;
+
+    /// <summary>
+    /// Makes sure only one thread writes into <see cref="_messageRing" /> at a time, and that nothing does once
+    /// disposal has started.
+    /// </summary>
+    private readonly object _messageRingLock = new();
+
     private bool _isDisposing;
 
     /// <summary>
-    /// Creates a new native window containing a web view and immediately shows it.
+    /// The channels that this window has joined, see <see cref="JoinChannel" />.
+    /// </summary>
+    private readonly ConcurrentDictionary<string, byte> _channels = new();
+
+    /// <summary>
+    /// Completed while the web view is keeping up with outbound messages, and replaced with a pending task while it
+    /// is behind.
+    /// </summary>
+    private TaskCompletionSource _capacity = CreateCapacity(true);
+
+    /// <inheritdoc />
+    public event Action<byte[]>? BinaryMessageReceived;
+
+    /// <inheritdoc />
+    public event Action<FrameStatistics>? FrameStatisticsReported;
+
+    /// <inheritdoc />
+    public event Action<bool>? BackPressureChanged;
+
+    /// <inheritdoc />
+    public event Action<InteractionLatencyReport>? InteractionTraced;
+
+    /// <inheritdoc />
+    public bool IsBackPressured => !Volatile.Read(ref _capacity).Task.IsCompleted;
+
+    /// <summary>
+    /// Starts creating a new native window containing a web view, and prepares to serve its content meanwhile.
     /// </summary>
     /// <param name="provider">The service provider associated with this window's scope.</param>
     /// <param name="configuration">The window's configuration.</param>
-    public TestudoWindow(IServiceProvider provider, TestudoWindowConfiguration configuration)
+    private TestudoWindow(IServiceProvider provider, TestudoWindowConfiguration configuration)
     {
         // Pass in pointers to the web view manager callbacks
         var pWebMessageReceivedHandler = typeof(TestudoWindow)
@@ -72,39 +175,120 @@ public partial class TestudoWindow : ITestudoWindow
             .GetMethod(nameof(WebResourceRequestedHandler), BindingFlags.Static | BindingFlags.Public)!
             .MethodHandle.GetFunctionPointer();
         configuration.SetWebResourceRequestedHandler(pWebResourceRequestedHandler);
+        var pScriptEvaluatedHandler = typeof(TestudoWindow)
+            .GetMethod(nameof(ScriptEvaluatedHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        configuration.SetScriptEvaluatedHandler(pScriptEvaluatedHandler);
+        var pWebBinaryMessageReceivedHandler = typeof(TestudoWindow)
+            .GetMethod(nameof(WebBinaryMessageReceivedHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        configuration.SetWebBinaryMessageReceivedHandler(pWebBinaryMessageReceivedHandler);
+        var pFrameStatisticsHandler = typeof(TestudoWindow)
+            .GetMethod(nameof(FrameStatisticsHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        configuration.SetFrameStatisticsHandler(pFrameStatisticsHandler);
+        var pWindowCreatedHandler = typeof(TestudoWindow)
+            .GetMethod(nameof(WindowCreatedHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        configuration.SetWindowCreatedHandler(pWindowCreatedHandler);
+        var pBackPressureChangedHandler = typeof(TestudoWindow)
+            .GetMethod(nameof(BackPressureChangedHandler), BindingFlags.Static | BindingFlags.Public)!
+            .MethodHandle.GetFunctionPointer();
+        configuration.SetBackPressureChangedHandler(pBackPressureChangedHandler);
 
-        // Create a web view manager for this window
+        _configurationHandle = GCHandle.Alloc(configuration, GCHandleType.Pinned);
+        _configurationFinalizer = configuration.Dispose;
+        _initialUri = configuration.InitialUri;
+        _title = configuration.Title;
+        _application = provider.GetRequiredService<ITestudoApplication>();
+
+        // Queue the native window to be created on the main thread without waiting for it
+        var requestId = Interlocked.Increment(ref _lastCreateRequestId);
+        var completion = new TaskCompletionSource<(IntPtr Instance, bool IsSuccess)>(
+            TaskCreationOptions.RunContinuationsAsynchronously);
+        _pendingCreations[requestId] = completion;
+        _creation = completion.Task;
+        TestudoWindow_CreateAsync(_configurationHandle.AddrOfPinnedObject(), requestId);
+
+        // Create a web view manager for this window while the native window and web view are being created
         _webViewManager = new TestudoWebViewManager(this, provider,
             provider.GetRequiredService<Dispatcher>(),
             provider.GetRequiredService<IFileProvider>(),
             provider.GetRequiredService<JSComponentConfigurationStore>(),
-            out var webMessageReceivedHandler,
-            out var webResourceRequestedHandler);
+            provider.GetRequiredService<ResourcePrefetcher>(),
+            configuration.IsLatencyTracingEnabled ? report => InteractionTraced?.Invoke(report) : null,
+            out _webMessageReceivedHandler,
+            out _webResourceRequestedHandler);
+    }
 
-        // Create the native window
-        _configurationHandle = GCHandle.Alloc(configuration, GCHandleType.Pinned);
-        _configurationFinalizer = configuration.Dispose;
+    /// <summary>
+    /// Creates a new native window containing a web view, shows it, and navigates it to its initial page.
+    /// </summary>
+    /// <param name="provider">The service provider associated with this window's scope.</param>
+    /// <param name="configuration">The window's configuration.</param>
+    /// <returns>The new window, once its web view is navigating to the initial page.</returns>
+    /// <exception cref="InvalidOperationException">Thrown if the window's web view could not be created.</exception>
+    /// <remarks>
+    /// The native work happens on the main thread, so the returned task will not complete until
+    /// <see cref="ITestudoApplication.Run" /> has been called.
+    /// </remarks>
+    public static async Task<TestudoWindow> CreateAsync(IServiceProvider provider,
+        TestudoWindowConfiguration configuration)
+    {
+        var window = new TestudoWindow(provider, configuration);
+        await window.InitializeAsync();
+        return window;
+    }
 
-        // Instantiate window on main thread
-        _application = provider.GetRequiredService<ITestudoApplication>();
-        var instance = IntPtr.Zero;
-        _application.Invoke(() => instance = TestudoWindow_Construct(_configurationHandle.AddrOfPinnedObject()));
-        _instance = instance;
+    /// <summary>
+    /// Waits for the native window to be created, then connects it to this class and navigates it.
+    /// </summary>
+    private async Task InitializeAsync()
+    {
+        var (instance, isSuccess) = await _creation;
+        if (!isSuccess)
+        {
+            _application.Invoke(() => TestudoWindow_Destroy(instance));
+            await _webViewManager.DisposeAsync();
+            _configurationHandle.Free();
+            _configurationFinalizer();
+            throw new InvalidOperationException("The window's web view could not be created.");
+        }
 
         // Store the web view callbacks
-        _webMessageReceivedHandlers[_instance] = webMessageReceivedHandler;
-        _webResourceRequestedHandlers[_instance] = webResourceRequestedHandler;
+        _instance = instance;
+        _webMessageReceivedHandlers[_instance] = _webMessageReceivedHandler;
+        _webResourceRequestedHandlers[_instance] = _webResourceRequestedHandler;
+        _scriptEvaluatedHandlers[_instance] = OnScriptEvaluated;
+        _windows[_instance] = this;
 
-        // Initialize the web view and show the window
-        _application.Invoke(() => TestudoWindow_Show(_instance));
+        var messageRing = TestudoWindow_GetMessageRing(_instance);
+        if (messageRing != IntPtr.Zero)
+        {
+            _messageRing = new MessageRingWriter(messageRing, () => TestudoWindow_RingMessageDoorbell(instance));
+        }
+
+        // The web view was left blank until now so that it cannot request anything this class is not ready to serve
+        if (_initialUri != null)
+        {
+            _application.Invoke(() => TestudoWindow_Navigate(_instance, _initialUri));
+        }
     }
 
     /// <inheritdoc />
     public async ValueTask DisposeAsync()
     {
-        _isDisposing = true;
+        // Anything still in the message ring is dropped along with the native window
+        lock (_messageRingLock)
+        {
+            _isDisposing = true;
+        }
         
+        // Destroying the native window fails any script evaluations that are still in flight
         _application.Invoke(() => TestudoWindow_Destroy(_instance));
+        _scriptEvaluatedHandlers.TryRemove(_instance, out _);
+        _windows.TryRemove(_instance, out _);
+        Volatile.Read(ref _capacity).TrySetResult();
         await _webViewManager.DisposeAsync();
 
         if (_configurationHandle.IsAllocated)
@@ -117,10 +301,23 @@ public partial class TestudoWindow : ITestudoWindow
     }
 
     /// <inheritdoc />
-    public void AddRootComponent<TComponent>()
+    public Task AddRootComponentAsync<TComponent>() =>
+        _webViewManager.AddRootComponentAsync(typeof(TComponent), "app", ParameterView.Empty);
+
+    /// <inheritdoc />
+    public void Activate()
     {
-        _webViewManager.AddRootComponentAsync(typeof(TComponent), "app", ParameterView.Empty)
-            .ConfigureAwait(false).GetAwaiter().GetResult();
+        // Checked on the main thread too, as the window may be destroyed before the invocation runs
+        if (!_isDisposing)
+        {
+            _application.Invoke(() =>
+            {
+                if (!_isDisposing)
+                {
+                    TestudoWindow_Activate(_instance);
+                }
+            });
+        }
     }
 
     /// <inheritdoc />
@@ -135,9 +332,235 @@ public partial class TestudoWindow : ITestudoWindow
     /// <inheritdoc />
     public void SendMessage(string message)
     {
-        if (!_isDisposing)
+        if (_messageRing == null)
+        {
+            if (!_isDisposing)
+            {
+                TestudoWindow_SendMessage(_instance, message);
+            }
+
+            return;
+        }
+
+        var spinner = new SpinWait();
+        while (!TrySendMessage(message))
+        {
+            // The ring is drained on the main thread, so waiting for it there would never finish
+            if (Environment.CurrentManagedThreadId == _application.MainThreadId)
+            {
+                TestudoWindow_DrainMessages(_instance);
+            }
+            else
+            {
+                spinner.SpinOnce();
+            }
+        }
+    }
+
+    /// <inheritdoc />
+    public bool TrySendMessage(string message)
+    {
+        if (_messageRing == null)
+        {
+            SendMessage(message);
+            return true;
+        }
+
+        lock (_messageRingLock)
+        {
+            if (_isDisposing)
+            {
+                return true;
+            }
+
+            if (_messageRing.TryWrite(message, out var isTooLarge))
+            {
+                return true;
+            }
+
+            // Messages that can never fit are sent directly, once everything ahead of them has been delivered
+            if (isTooLarge && _messageRing.IsEmpty)
+            {
+                TestudoWindow_SendMessage(_instance, message);
+                return true;
+            }
+
+            return false;
+        }
+    }
+
+    /// <inheritdoc />
+    public void JoinChannel(string channel) => _channels.TryAdd(channel, 0);
+
+    /// <inheritdoc />
+    public void LeaveChannel(string channel) => _channels.TryRemove(channel, out _);
+
+    /// <summary>
+    /// Whether this window has joined the given channel.
+    /// </summary>
+    /// <param name="channel">The name of the channel.</param>
+    internal bool IsInChannel(string channel) => _channels.ContainsKey(channel);
+
+    /// <summary>
+    /// Sends the same message to every open window that matches the given filter, in a single native call.
+    /// </summary>
+    /// <param name="application">The application, used to reach the UI thread.</param>
+    /// <param name="message">The JavaScript message to send and evaluate.</param>
+    /// <param name="isTarget">Whether a window should receive the message.</param>
+    internal static void Broadcast(ITestudoApplication application, string message, Func<TestudoWindow, bool> isTarget)
+    {
+        // The targets are chosen on the UI thread, where windows are destroyed, so none can go away mid-broadcast
+        void Send()
+        {
+            var instances = new List<IntPtr>();
+            foreach (var window in _windows.Values)
+            {
+                if (!window._isDisposing && isTarget(window))
+                {
+                    instances.Add(window._instance);
+                }
+            }
+
+            if (instances.Count > 0)
+            {
+                TestudoWindow_Broadcast(instances.ToArray(), instances.Count, message);
+            }
+        }
+
+        if (Environment.CurrentManagedThreadId == application.MainThreadId)
+        {
+            Send();
+        }
+        else
+        {
+            application.Invoke(Send);
+        }
+    }
+
+    /// <inheritdoc />
+    public Task WaitForCapacityAsync(CancellationToken cancellationToken = default) =>
+        Volatile.Read(ref _capacity).Task.WaitAsync(cancellationToken);
+
+    /// <summary>
+    /// Creates the task that <see cref="WaitForCapacityAsync" /> waits on.
+    /// </summary>
+    /// <param name="hasCapacity">Whether the web view is keeping up, in which case the task is already complete.</param>
+    private static TaskCompletionSource CreateCapacity(bool hasCapacity)
+    {
+        // Continuations must not run inline as back-pressure is reported on the UI thread
+        var capacity = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        if (hasCapacity)
+        {
+            capacity.SetResult();
+        }
+
+        return capacity;
+    }
+
+    /// <inheritdoc />
+    public Task<string> ExecuteScriptAsync(string script)
+    {
+        if (_isDisposing)
+        {
+            return Task.FromException<string>(new ObjectDisposedException(nameof(TestudoWindow)));
+        }
+
+        // Continuations must not run inline as the result is reported on the UI thread
+        var requestId = Interlocked.Increment(ref _lastScriptRequestId);
+        var completion = new TaskCompletionSource<string>(TaskCreationOptions.RunContinuationsAsynchronously);
+        _pendingScripts[requestId] = completion;
+
+        // This only blocks until the evaluation has been started, not until it completes. The native window is
+        // destroyed on the main thread after the flag is set, so checking it there means the instance is still valid
+        _application.Invoke(() =>
+        {
+            if (_isDisposing)
+            {
+                if (_pendingScripts.TryRemove(requestId, out var pending))
+                {
+                    pending.SetException(new ObjectDisposedException(nameof(TestudoWindow)));
+                }
+
+                return;
+            }
+
+            TestudoWindow_ExecuteScript(_instance, requestId, script);
+        });
+        return completion.Task;
+    }
+
+    /// <inheritdoc />
+    public MemoryReport GetMemoryReport()
+    {
+        var report = default(MemoryReport);
+
+        // Holding the lock stops disposal from starting, and so the native window from being destroyed, meanwhile
+        lock (_messageRingLock)
+        {
+            if (!_isDisposing && _instance != IntPtr.Zero)
+            {
+                TestudoWindow_GetMemoryReport(_instance, out report);
+            }
+        }
+
+        return report;
+    }
+
+    /// <summary>
+    /// Finds the open window that wraps the given native window.
+    /// </summary>
+    /// <param name="instance">Pointer to the native window.</param>
+    /// <param name="window">The window, if it is open.</param>
+    internal static bool TryGetWindow(IntPtr instance, [NotNullWhen(true)] out TestudoWindow? window) =>
+        _windows.TryGetValue(instance, out window);
+
+    /// <summary>
+    /// Reports the memory held by each open window, along with its title.
+    /// </summary>
+    internal static IEnumerable<(string Title, MemoryReport Report)> GetOpenWindowMemoryReports()
+    {
+        foreach (var window in _windows.Values)
         {
-            TestudoWindow_SendMessage(_instance, message);
+            yield return (window._title, window.GetMemoryReport());
+        }
+    }
+
+    /// <summary>
+    /// Completes the pending script evaluation with the given ID.
+    /// </summary>
+    /// <param name="requestId">The ID of the evaluation request.</param>
+    /// <param name="isSuccess">Whether the script was evaluated successfully.</param>
+    /// <param name="result">The result as JSON, or a description of the error.</param>
+    private void OnScriptEvaluated(int requestId, bool isSuccess, string result)
+    {
+        if (_pendingScripts.TryRemove(requestId, out var completion))
+        {
+            if (isSuccess)
+            {
+                completion.SetResult(result);
+            }
+            else
+            {
+                completion.SetException(new JSException(result));
+            }
+        }
+    }
+
+    /// <summary>
+    /// Completes the pending window creation with the given ID.
+    /// </summary>
+    /// <param name="requestId">The ID of the creation request.</param>
+    /// <param name="instance">The native instance that was created.</param>
+    /// <param name="isSuccess">Whether the instance's web view was created successfully.</param>
+    /// <remarks>
+    /// Called on the main thread, so the instance is destroyed by the awaiting code if creation failed.
+    /// </remarks>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static void WindowCreatedHandler(int requestId, IntPtr instance, byte isSuccess)
+    {
+        if (_pendingCreations.TryRemove(requestId, out var completion))
+        {
+            completion.SetResult((instance, isSuccess != 0));
         }
     }
 
@@ -161,17 +584,99 @@ public partial class TestudoWindow : ITestudoWindow
     /// </summary>
     /// <param name="instance">The native instance that called this method.</param>
     /// <param name="pUri">Pointer to the URI <c>string</c>.</param>
+    /// <param name="pIfNoneMatch">Pointer to the entity tag of the web view's cached copy, or null.</param>
     /// <param name="outSizeBytes">The size of the response buffer in bytes.</param>
     /// <param name="outContentType">Pointer to the content type <c>string</c>.</param>
+    /// <param name="outEntityTag">Pointer to the entity tag <c>string</c>, or null.</param>
     /// <returns>Pointer to the response buffer.</returns>
     [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
-    public static unsafe IntPtr WebResourceRequestedHandler(IntPtr instance, IntPtr pUri,
-        int* outSizeBytes, IntPtr* outContentType)
+    public static unsafe IntPtr WebResourceRequestedHandler(IntPtr instance, IntPtr pUri, IntPtr pIfNoneMatch,
+        int* outSizeBytes, IntPtr* outContentType, IntPtr* outEntityTag)
     {
         var uri = Marshal.PtrToStringAuto(pUri)!;
-        var result = _webResourceRequestedHandlers[instance](uri, out var sizeBytes, out var contentType);
+        var ifNoneMatch = Marshal.PtrToStringAuto(pIfNoneMatch);
+        var result = _webResourceRequestedHandlers[instance](uri, ifNoneMatch, out var sizeBytes,
+            out var contentType, out var entityTag);
         *outSizeBytes = sizeBytes;
         *outContentType = Marshal.StringToHGlobalAuto(contentType);
+        *outEntityTag = entityTag == null ? IntPtr.Zero : Marshal.StringToHGlobalAuto(entityTag);
         return result;
     }
+
+    /// <summary>
+    /// Raises <see cref="BinaryMessageReceived" /> on the appropriate window.
+    /// </summary>
+    /// <param name="instance">The native instance that called this method.</param>
+    /// <param name="pData">Pointer to the message, which is only valid for the duration of the call.</param>
+    /// <param name="sizeBytes">The size of the message in bytes.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static void WebBinaryMessageReceivedHandler(IntPtr instance, IntPtr pData, int sizeBytes)
+    {
+        if (_windows.TryGetValue(instance, out var window) && window.BinaryMessageReceived != null)
+        {
+            var message = new byte[sizeBytes];
+            Marshal.Copy(pData, message, 0, sizeBytes);
+            window.BinaryMessageReceived(message);
+        }
+    }
+
+    /// <summary>
+    /// Raises <see cref="FrameStatisticsReported" /> on the appropriate window.
+    /// </summary>
+    /// <param name="instance">The native instance that called this method.</param>
+    /// <param name="pStatistics">Pointer to the statistics, which are only valid for the duration of the call.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static unsafe void FrameStatisticsHandler(IntPtr instance, FrameStatistics* pStatistics)
+    {
+        if (_windows.TryGetValue(instance, out var window))
+        {
+            window.FrameStatisticsReported?.Invoke(*pStatistics);
+        }
+    }
+
+    /// <summary>
+    /// Pauses or resumes the producers that are waiting on <see cref="WaitForCapacityAsync" />, then raises
+    /// <see cref="BackPressureChanged" />.
+    /// </summary>
+    /// <param name="instance">The native instance that called this method.</param>
+    /// <param name="isPaused">Whether low-priority producers should pause.</param>
+    /// <param name="outstandingCount">The number of evaluations that the web view has not finished yet.</param>
+    /// <param name="outstandingBytes">The size of the messages in those evaluations in bytes.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static void BackPressureChangedHandler(IntPtr instance, byte isPaused, int outstandingCount,
+        long outstandingBytes)
+    {
+        if (!_windows.TryGetValue(instance, out var window))
+        {
+            return;
+        }
+
+        if (isPaused != 0)
+        {
+            Volatile.Write(ref window._capacity, CreateCapacity(false));
+        }
+        else
+        {
+            Volatile.Read(ref window._capacity).TrySetResult();
+        }
+
+        window.BackPressureChanged?.Invoke(isPaused != 0);
+    }
+
+    /// <summary>
+    /// Calls the appropriate script evaluated delegate.
+    /// </summary>
+    /// <param name="instance">The native instance that called this method.</param>
+    /// <param name="requestId">The ID of the evaluation request.</param>
+    /// <param name="isSuccess">Whether the script was evaluated successfully.</param>
+    /// <param name="pResult">Pointer to the JSON result or error message <c>string</c>.</param>
+    [UnmanagedCallersOnly(CallConvs = [typeof(CallConvCdecl)])]
+    public static void ScriptEvaluatedHandler(IntPtr instance, int requestId, byte isSuccess, IntPtr pResult)
+    {
+        var result = Marshal.PtrToStringAuto(pResult) ?? "null";
+        if (_scriptEvaluatedHandlers.TryGetValue(instance, out var handler))
+        {
+            handler(requestId, isSuccess != 0, result);
+        }
+    }
 }
\ No newline at end of file
@@ -59,6 +59,9 @@ public struct TestudoWindowConfiguration : IDisposable
     /// <summary>
     /// Whether developer tools are enabled for this window.
     /// </summary>
+    /// <remarks>
+    /// <see cref="TestudoApplicationConfiguration.AreDevToolsEnabled" /> must also be set on Windows.
+    /// </remarks>
     [MarshalAs(UnmanagedType.U1)]
     public bool AreDevToolsEnabled;
 
@@ -72,9 +75,98 @@ public struct TestudoWindowConfiguration : IDisposable
     /// </summary>
     private IntPtr WebResourceRequestedHandler;
 
+    /// <summary>
+    /// A delegate that handles completed script evaluations.
+    /// </summary>
+    private IntPtr ScriptEvaluatedHandler;
+
+    /// <summary>
+    /// A delegate that handles binary messages sent through the Linux web extension.
+    /// </summary>
+    private IntPtr WebBinaryMessageReceivedHandler;
+
+    /// <summary>
+    /// Whether outbound messages are buffered and flushed once per display frame, just before layout.
+    /// </summary>
+    /// <remarks>
+    /// Only supported on Linux, where it is driven by the web view's frame clock. Useful for views that send
+    /// updates faster than the display refreshes, as intermediate states are never rendered.
+    /// Statistics for each frame are reported through <see cref="ITestudoWindow.FrameStatisticsReported" />.
+    /// Ignored for offscreen windows, which never present a frame.
+    /// </remarks>
+    [MarshalAs(UnmanagedType.U1)]
+    public bool IsFrameAlignedMessagingEnabled;
+
+    /// <summary>
+    /// A delegate that receives statistics for each frame that flushed messages.
+    /// </summary>
+    private IntPtr FrameStatisticsHandler;
+
+    /// <summary>
+    /// A delegate that is notified when a window that was created asynchronously is ready to navigate.
+    /// </summary>
+    private IntPtr WindowCreatedHandler;
+
+    /// <summary>
+    /// Whether the window is never shown, for rendering components with no user present.
+    /// </summary>
+    /// <remarks>
+    /// The web view still runs scripts, serves <c>app://</c> resources and exchanges messages as usual, but nothing
+    /// is presented to the screen. On Linux the window is a <c>GtkOffscreenWindow</c>, and on Windows the web view
+    /// is hidden inside a window that is never shown, which stops it from rendering and compositing.
+    /// Useful for throughput benchmarks and batch jobs.
+    /// </remarks>
+    [MarshalAs(UnmanagedType.U1)]
+    public bool IsOffscreen;
+
+    /// <summary>
+    /// The size in bytes of a ring that outbound messages are written into, or 0 to send each message to native
+    /// code as it is sent.
+    /// </summary>
+    /// <remarks>
+    /// The ring is drained on the main loop, which is only woken for the first message written after the last drain,
+    /// so views that send many small messages avoid a native call per message. Rounded up to a power of two.
+    /// <see cref="ITestudoWindow.SendMessage" /> waits for space when the ring is full, whereas
+    /// <see cref="ITestudoWindow.TrySendMessage" /> returns false.
+    /// </remarks>
+    public int MessageRingCapacity;
+
+    /// <summary>
+    /// The size in bytes of the outbound messages that the web view may have outstanding before the window reports
+    /// back-pressure, or 0 to never report it.
+    /// </summary>
+    /// <remarks>
+    /// Only supported on Linux, where messages are delivered by evaluating script and the web view reports when each
+    /// evaluation has finished. Messages that go through the web extension channel are not counted, as they are
+    /// never evaluated. See <see cref="ITestudoWindow.IsBackPressured" />.
+    /// </remarks>
+    public int OutboundHighWaterMarkBytes;
+
+    /// <summary>
+    /// The size in bytes that outstanding outbound messages must fall to before back-pressure ends.
+    /// Defaults to half of <see cref="OutboundHighWaterMarkBytes" />.
+    /// </summary>
+    public int OutboundLowWaterMarkBytes;
+
+    /// <summary>
+    /// A delegate that is told when the web view falls behind on outbound messages and catches up.
+    /// </summary>
+    private IntPtr BackPressureChangedHandler;
+
+    /// <summary>
+    /// Whether each interaction with the page is traced from the browser event to the paint that shows its result.
+    /// </summary>
+    /// <remarks>
+    /// Reports are raised through <see cref="ITestudoWindow.InteractionTraced" />. Adds a small amount of work to
+    /// every browser event and render batch, so it is meant for diagnosing slow interactions rather than production.
+    /// </remarks>
+    [MarshalAs(UnmanagedType.U1)]
+    public bool IsLatencyTracingEnabled;
+
     /// <inheritdoc cref="_title" />
     public required string Title
     {
+        internal get => Marshal.PtrToStringAuto(_title)!;
         set => _title = Marshal.StringToHGlobalAuto(value);
     }
 
@@ -87,12 +179,32 @@ public struct TestudoWindowConfiguration : IDisposable
         set => _initialUri = Marshal.StringToHGlobalAuto(TestudoWebViewManager.CreateUri(value));
     }
 
+    /// <summary>
+    /// The URI that the window's web view will navigate to on startup.
+    /// </summary>
+    internal readonly string? InitialUri => Marshal.PtrToStringAuto(_initialUri);
+
     /// <inheritdoc cref="WebMessageReceivedHandler" />
     public void SetWebMessageReceivedHandler(IntPtr handler) => WebMessageReceivedHandler = handler;
 
     /// <inheritdoc cref="WebResourceRequestedHandler" />
     public void SetWebResourceRequestedHandler(IntPtr handler) => WebResourceRequestedHandler = handler;
 
+    /// <inheritdoc cref="ScriptEvaluatedHandler" />
+    public void SetScriptEvaluatedHandler(IntPtr handler) => ScriptEvaluatedHandler = handler;
+
+    /// <inheritdoc cref="WebBinaryMessageReceivedHandler" />
+    public void SetWebBinaryMessageReceivedHandler(IntPtr handler) => WebBinaryMessageReceivedHandler = handler;
+
+    /// <inheritdoc cref="FrameStatisticsHandler" />
+    public void SetFrameStatisticsHandler(IntPtr handler) => FrameStatisticsHandler = handler;
+
+    /// <inheritdoc cref="WindowCreatedHandler" />
+    public void SetWindowCreatedHandler(IntPtr handler) => WindowCreatedHandler = handler;
+
+    /// <inheritdoc cref="BackPressureChangedHandler" />
+    public void SetBackPressureChangedHandler(IntPtr handler) => BackPressureChangedHandler = handler;
+
     /// <inheritdoc />
     public void Dispose()
     {
@@ -8,12 +8,15 @@ public partial class TestudoWindow
     private const string LibraryName = TestudoApplication.LibraryName;
 
     /// <summary>
-    /// Creates a new native window.
+    /// Creates and shows a new native window on the main thread without waiting for it.
     /// </summary>
     /// <param name="configuration">The window's configuration.</param>
-    /// <returns>A pointer to the newly created instance.</returns>
+    /// <param name="requestId">The ID that the new window will be reported to <see cref="WindowCreatedHandler" /> with.</param>
+    /// <remarks>
+    /// The window's web view does not navigate anywhere until it is told to.
+    /// </remarks>
     [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
-    private static extern IntPtr TestudoWindow_Construct(IntPtr configuration);
+    private static extern void TestudoWindow_CreateAsync(IntPtr configuration, int requestId);
 
     /// <summary>
     /// Closes and cleans up a web view window without terminating the application.
@@ -23,11 +26,11 @@ public partial class TestudoWindow
     private static extern void TestudoWindow_Destroy(IntPtr instance);
 
     /// <summary>
-    /// Initializes the window's embedded web view, then shows the window.
+    /// Restores the given window if it is minimized, and brings it to the front with focus.
     /// </summary>
-    /// <param name="instance">A pointer to the native instance to show.</param>
+    /// <param name="instance">A pointer to the native window instance to activate.</param>
     [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
-    private static extern void TestudoWindow_Show(IntPtr instance);
+    private static extern void TestudoWindow_Activate(IntPtr instance);
 
     /// <summary>
     /// Navigates the given window's web view to the given URI.
@@ -46,4 +49,55 @@ public partial class TestudoWindow
     /// <param name="message">The JavaScript message to send and evaluate.</param>
     [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true, CharSet = CharSet.Auto)]
     private static extern void TestudoWindow_SendMessage(IntPtr instance, string message);
+
+    /// <summary>
+    /// Sends the same JavaScript message to several windows' web views for evaluation, marshaling, escaping and
+    /// formatting it once for all of them. Must be called on the main thread.
+    /// </summary>
+    /// <param name="instances">Pointers to the native window instances whose web views should receive the message.</param>
+    /// <param name="count">The number of windows.</param>
+    /// <param name="message">The JavaScript message to send and evaluate.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true, CharSet = CharSet.Auto)]
+    private static extern void TestudoWindow_Broadcast(IntPtr[] instances, int count, string message);
+
+    /// <summary>
+    /// Evaluates JavaScript in the given window's web view without waiting for the result.
+    /// </summary>
+    /// <param name="instance">
+    /// A pointer to the native window instance whose web view should evaluate the JavaScript.
+    /// </param>
+    /// <param name="requestId">The ID that the result will be reported with.</param>
+    /// <param name="script">The JavaScript to evaluate.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true, CharSet = CharSet.Auto)]
+    private static extern void TestudoWindow_ExecuteScript(IntPtr instance, int requestId, string script);
+
+    /// <summary>
+    /// Reports the memory that the given window is holding on to.
+    /// </summary>
+    /// <param name="instance">A pointer to the native window instance to report on.</param>
+    /// <param name="report">Receives the report.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern void TestudoWindow_GetMemoryReport(IntPtr instance, out MemoryReport report);
+
+    /// <summary>
+    /// Gets the ring that managed code writes the given window's outbound messages into.
+    /// </summary>
+    /// <param name="instance">A pointer to the native window instance that owns the ring.</param>
+    /// <returns>The ring, or <see cref="IntPtr.Zero" /> if the window was not configured with one.</returns>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern IntPtr TestudoWindow_GetMessageRing(IntPtr instance);
+
+    /// <summary>
+    /// Queues the given window's message ring to be drained on the main thread, without waiting for it.
+    /// </summary>
+    /// <param name="instance">A pointer to the native window instance that owns the ring.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern void TestudoWindow_RingMessageDoorbell(IntPtr instance);
+
+    /// <summary>
+    /// Sends every message in the given window's message ring to its web view. Must be called on the main thread.
+    /// </summary>
+    /// <param name="instance">A pointer to the native window instance that owns the ring.</param>
+    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, SetLastError = true)]
+    private static extern void TestudoWindow_DrainMessages(IntPtr instance);
 }
\ No newline at end of file
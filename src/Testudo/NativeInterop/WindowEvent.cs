@@ -0,0 +1,156 @@
+using System.Runtime.InteropServices;
+
+namespace Testudo;
+
+/// <summary>
+/// The kinds of change that are reported for a window.
+/// </summary>
+public enum WindowEventKind
+{
+    /// <summary>
+    /// The window's client area changed size, see <see cref="WindowEvent.Width" /> and
+    /// <see cref="WindowEvent.Height" />.
+    /// </summary>
+    Resized = 0,
+
+    /// <summary>
+    /// The window moved, see <see cref="WindowEvent.Left" /> and <see cref="WindowEvent.Top" />.
+    /// </summary>
+    Moved = 1,
+
+    /// <summary>
+    /// The window gained or lost focus, see <see cref="WindowEvent.IsFocused" />.
+    /// </summary>
+    FocusChanged = 2,
+
+    /// <summary>
+    /// The window was shown or hidden, see <see cref="WindowEvent.IsVisible" />.
+    /// </summary>
+    VisibilityChanged = 3,
+
+    /// <summary>
+    /// The window was minimized, maximized, made fullscreen or restored, see <see cref="WindowEvent.State" />.
+    /// </summary>
+    StateChanged = 4,
+
+    /// <summary>
+    /// The user asked to close the window, such as with its close button.
+    /// </summary>
+    /// <remarks>
+    /// This is only a notification, the window still closes.
+    /// </remarks>
+    CloseRequested = 5
+}
+
+/// <summary>
+/// The states that a window can be in.
+/// </summary>
+public enum WindowState
+{
+    /// <summary>
+    /// The window is neither minimized, maximized nor fullscreen.
+    /// </summary>
+    Normal = 0,
+
+    /// <summary>
+    /// The window is minimized.
+    /// </summary>
+    Minimized = 1,
+
+    /// <summary>
+    /// The window is maximized.
+    /// </summary>
+    Maximized = 2,
+
+    /// <summary>
+    /// The window covers the whole screen.
+    /// </summary>
+    Fullscreen = 3
+}
+
+/// <summary>
+/// Describes the latest change of one kind to a window.
+/// </summary>
+/// <remarks>
+/// Raised in batches through <see cref="ITestudoApplication.WindowEventsReceived" />. Only the members that relate to
+/// <see cref="Kind" /> are set.
+/// </remarks>
+public readonly record struct WindowEvent
+{
+    /// <summary>
+    /// The window that changed.
+    /// </summary>
+    public required ITestudoWindow Window { get; init; }
+
+    /// <summary>
+    /// The kind of change.
+    /// </summary>
+    public required WindowEventKind Kind { get; init; }
+
+    /// <summary>
+    /// The position of the window's left edge on the screen.
+    /// </summary>
+    public int Left { get; init; }
+
+    /// <summary>
+    /// The position of the window's top edge on the screen.
+    /// </summary>
+    public int Top { get; init; }
+
+    /// <summary>
+    /// The width of the window's client area in pixels.
+    /// </summary>
+    public int Width { get; init; }
+
+    /// <summary>
+    /// The height of the window's client area in pixels.
+    /// </summary>
+    public int Height { get; init; }
+
+    /// <summary>
+    /// Whether the window has focus.
+    /// </summary>
+    public bool IsFocused { get; init; }
+
+    /// <summary>
+    /// Whether the window is visible.
+    /// </summary>
+    public bool IsVisible { get; init; }
+
+    /// <summary>
+    /// The window's new state.
+    /// </summary>
+    public WindowState State { get; init; }
+}
+
+/// <summary>
+/// The native layout of <see cref="WindowEvent" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeWindowEvent
+{
+    public IntPtr Instance;
+    public WindowEventKind Kind;
+    public int Left;
+    public int Top;
+    public int Width;
+    public int Height;
+    public int Value;
+
+    /// <summary>
+    /// Converts this event into its managed form.
+    /// </summary>
+    /// <param name="window">The window that <see cref="Instance" /> points to.</param>
+    public WindowEvent ToWindowEvent(ITestudoWindow window) => new()
+    {
+        Window = window,
+        Kind = Kind,
+        Left = Left,
+        Top = Top,
+        Width = Width,
+        Height = Height,
+        IsFocused = Kind == WindowEventKind.FocusChanged && Value != 0,
+        IsVisible = Kind == WindowEventKind.VisibilityChanged && Value != 0,
+        State = Kind == WindowEventKind.StateChanged ? (WindowState)Value : WindowState.Normal
+    };
+}
\ No newline at end of file
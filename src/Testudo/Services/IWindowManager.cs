@@ -10,6 +10,11 @@ public interface IWindowManager : IAsyncDisposable
     /// </summary>
     /// <param name="configuration">The configuration of the window.</param>
     /// <typeparam name="TComponent">The type of the Razor Component to host in the window.</typeparam>
+    /// <remarks>
+    /// The window is created on the main thread, so the returned task will not complete until
+    /// <see cref="ITestudoApplication.Run" /> has been called. Do not wait on it from the main thread before then.
+    /// Several windows can be opened at once, and their creation will overlap.
+    /// </remarks>
     Task OpenWindowAsync<TComponent>(TestudoWindowConfiguration configuration);
 
     /// <summary>
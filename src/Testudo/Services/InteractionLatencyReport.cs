@@ -0,0 +1,142 @@
+using System.Text;
+
+namespace Testudo;
+
+/// <summary>
+/// The stages that an interaction passes through on its way from input to paint, in the order they are reached.
+/// </summary>
+public enum InteractionStage
+{
+    /// <summary>
+    /// The browser event was raised in the page, according to the event's own timestamp.
+    /// </summary>
+    Input = 0,
+
+    /// <summary>
+    /// The interop script posted the event to the native window.
+    /// </summary>
+    Sent = 1,
+
+    /// <summary>
+    /// The native window received the event's web message.
+    /// </summary>
+    NativeReceived = 2,
+
+    /// <summary>
+    /// <see cref="TestudoWebViewManager" /> started handling the event's web message.
+    /// </summary>
+    ManagedReceived = 3,
+
+    /// <summary>
+    /// The event's work was queued on <see cref="TestudoDispatcher" />.
+    /// </summary>
+    DispatcherQueued = 4,
+
+    /// <summary>
+    /// The event's work started running on the main thread.
+    /// </summary>
+    MainThreadInvoked = 5,
+
+    /// <summary>
+    /// The render batch that the event caused was sent to the web view.
+    /// </summary>
+    RenderBatchSent = 6,
+
+    /// <summary>
+    /// The page received the render batch.
+    /// </summary>
+    RenderBatchReceived = 7,
+
+    /// <summary>
+    /// The page finished applying the render batch to the DOM.
+    /// </summary>
+    RenderBatchApplied = 8,
+
+    /// <summary>
+    /// The page painted the frame that followed the render batch.
+    /// </summary>
+    Painted = 9
+}
+
+/// <summary>
+/// Describes when an interaction reached one of its stages.
+/// </summary>
+/// <param name="Stage">The stage that was reached.</param>
+/// <param name="Elapsed">The time from input until the stage was reached.</param>
+public readonly record struct InteractionStageTiming(InteractionStage Stage, TimeSpan Elapsed);
+
+/// <summary>
+/// Describes where the time went between a browser event and the paint that showed its result.
+/// </summary>
+/// <remarks>
+/// Only reported when <see cref="TestudoWindowConfiguration.IsLatencyTracingEnabled" /> is set, through
+/// <see cref="ITestudoWindow.InteractionTraced" />. Events that do not cause a render are not reported.
+/// The page stamps its stages with its own clock, so the boundaries between page and native stages are only as
+/// accurate as the two clocks agree, which is usually within a millisecond.
+/// </remarks>
+public sealed class InteractionLatencyReport
+{
+    /// <summary>
+    /// The upper bound of each bucket in <see cref="Histogram" /> and <see cref="StageHistograms" />, the last
+    /// bucket is unbounded.
+    /// </summary>
+    public static IReadOnlyList<TimeSpan> HistogramBucketBounds { get; } =
+    [
+        TimeSpan.FromMilliseconds(1),
+        TimeSpan.FromMilliseconds(4),
+        TimeSpan.FromMilliseconds(16),
+        TimeSpan.FromMilliseconds(33),
+        TimeSpan.FromMilliseconds(50),
+        TimeSpan.FromMilliseconds(100),
+        TimeSpan.FromMilliseconds(200),
+        TimeSpan.FromMilliseconds(500)
+    ];
+
+    /// <summary>
+    /// Identifies the interaction within its page.
+    /// </summary>
+    public required long Id { get; init; }
+
+    /// <summary>
+    /// The type of the browser event, such as <c>click</c>, if the page could tell.
+    /// </summary>
+    public required string? EventType { get; init; }
+
+    /// <summary>
+    /// The stages that were reached, in order.
+    /// </summary>
+    public required IReadOnlyList<InteractionStageTiming> Stages { get; init; }
+
+    /// <summary>
+    /// The number of interactions so far in this window, bucketed by their <see cref="Total" /> according to
+    /// <see cref="HistogramBucketBounds" />.
+    /// </summary>
+    public required IReadOnlyList<int> Histogram { get; init; }
+
+    /// <summary>
+    /// The number of interactions so far in this window, bucketed by the time each stage took according to
+    /// <see cref="HistogramBucketBounds" />. The time a stage took is measured from the stage reached before it.
+    /// </summary>
+    public required IReadOnlyDictionary<InteractionStage, IReadOnlyList<int>> StageHistograms { get; init; }
+
+    /// <summary>
+    /// The time from input until the last stage was reached.
+    /// </summary>
+    public TimeSpan Total => Stages.Count > 0 ? Stages[^1].Elapsed : TimeSpan.Zero;
+
+    /// <inheritdoc />
+    public override string ToString()
+    {
+        var builder = new StringBuilder();
+        builder.Append($"Interaction {Id} ({EventType ?? "unknown"}) took {Total.TotalMilliseconds:0.0}ms:");
+
+        var previous = TimeSpan.Zero;
+        foreach (var (stage, elapsed) in Stages)
+        {
+            builder.Append($" {stage} +{(elapsed - previous).TotalMilliseconds:0.0}ms");
+            previous = elapsed;
+        }
+
+        return builder.ToString();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,357 @@
+using System.Diagnostics;
+using System.Globalization;
+using System.Text.Json;
+
+namespace Testudo;
+
+/// <summary>
+/// Correlates the stamps of each interaction in a web view, from the browser event to the paint that follows its
+/// render batch, and reports them once the page has painted.
+/// </summary>
+/// <remarks>
+/// The page sends a trace message just before each browser event, and another once it has painted each render batch.
+/// Managed code attributes work to an interaction through <see cref="InteractionTrace.Current" />, and the first render
+/// batch sent while it is current, or after it was received if it is not, is taken to be the one that shows its
+/// result. All times are in microseconds on the <see cref="Stopwatch" /> clock.
+/// </remarks>
+/// <param name="handler">Receives a report for each interaction once it has painted.</param>
+internal sealed class LatencyTracer(Action<InteractionLatencyReport> handler)
+{
+    /// <summary>
+    /// The prefix of the web messages sent by the page's half of the tracer, which are not passed on to Blazor.
+    /// </summary>
+    private const string TraceMessagePrefix = "__testudo:trace:";
+
+    /// <summary>
+    /// The prefix of the IPC message that carries a browser event from the web view.
+    /// </summary>
+    private const string DispatchBrowserEventMessagePrefix = "__bwv:[\"DispatchBrowserEvent\"";
+
+    /// <summary>
+    /// The prefix of the IPC message that carries a render batch to the web view.
+    /// </summary>
+    private const string RenderBatchMessagePrefix = "__bwv:[\"RenderBatch\"";
+
+    /// <summary>
+    /// Render batches that the page has not reported painting are forgotten past this many, such as when it reloads.
+    /// </summary>
+    private const int MaxOutstandingBatches = 64;
+
+    /// <summary>
+    /// The difference between the Unix epoch and the start of the <see cref="Stopwatch" /> clock in microseconds,
+    /// used to move the page's timestamps onto the same clock as the native and managed ones.
+    /// </summary>
+    private readonly double _epochOffset = (DateTime.UtcNow - DateTime.UnixEpoch).TotalMicroseconds - Now();
+
+    private readonly object _lock = new();
+
+    /// <summary>
+    /// The interaction the page has announced, whose browser event message has not been received yet.
+    /// </summary>
+    private InteractionTrace? _pendingEvent;
+
+    /// <summary>
+    /// The most recent interaction that has not sent a render batch yet.
+    /// </summary>
+    private InteractionTrace? _awaitingRender;
+
+    /// <summary>
+    /// Holds the interactions whose render batches have been sent but not painted.<br />
+    /// <b>Key</b> — The ID of the render batch.<br />
+    /// <b>Value</b> — The interaction that caused it.
+    /// </summary>
+    private readonly Dictionary<long, InteractionTrace> _batches = [];
+
+    /// <summary>
+    /// The number of interactions so far, bucketed by <see cref="InteractionLatencyReport.HistogramBucketBounds" />.
+    /// </summary>
+    private readonly int[] _histogram = new int[InteractionLatencyReport.HistogramBucketBounds.Count + 1];
+
+    /// <summary>
+    /// The number of interactions so far, bucketed by the time each stage took.
+    /// </summary>
+    private readonly int[][] _stageHistograms = Enumerable.Range(0, InteractionTrace.StageCount)
+        .Select(_ => new int[InteractionLatencyReport.HistogramBucketBounds.Count + 1])
+        .ToArray();
+
+    /// <summary>
+    /// Gets the current time in microseconds on the <see cref="Stopwatch" /> clock.
+    /// </summary>
+    public static long Now() => (long)(Stopwatch.GetTimestamp() * (1_000_000.0 / Stopwatch.Frequency));
+
+    /// <summary>
+    /// Handles a web message if it was sent by the page's half of the tracer.
+    /// </summary>
+    /// <param name="message">The web message that was received.</param>
+    /// <returns>Whether the message was a trace message, in which case it should not be passed on.</returns>
+    public bool TryHandleMessage(string message)
+    {
+        if (!message.StartsWith(TraceMessagePrefix, StringComparison.Ordinal))
+        {
+            return false;
+        }
+
+        InteractionLatencyReport report;
+        try
+        {
+            using var document = JsonDocument.Parse(message.AsMemory(TraceMessagePrefix.Length));
+            var root = document.RootElement;
+            if (root.TryGetProperty("id", out var id))
+            {
+                // Announces the browser event message that the page is about to send
+                var eventType = root.TryGetProperty("type", out var type) ? type.GetString() : null;
+                var trace = new InteractionTrace(id.GetInt64(), eventType);
+                trace.Stamp(InteractionStage.Input, FromPageTime(root.GetProperty("input")));
+                trace.Stamp(InteractionStage.Sent, FromPageTime(root.GetProperty("sent")));
+                lock (_lock)
+                {
+                    _pendingEvent = trace;
+                }
+
+                return true;
+            }
+
+            // Reports that a render batch has been painted, which completes the interaction that caused it
+            var batchId = root.GetProperty("batch").GetInt64();
+            var received = FromPageTime(root.GetProperty("received"));
+            var applied = FromPageTime(root.GetProperty("applied"));
+            var painted = FromPageTime(root.GetProperty("painted"));
+            lock (_lock)
+            {
+                if (!_batches.Remove(batchId, out var trace))
+                {
+                    return true;
+                }
+
+                trace.Stamp(InteractionStage.RenderBatchReceived, received);
+                trace.Stamp(InteractionStage.RenderBatchApplied, applied);
+                trace.Stamp(InteractionStage.Painted, painted);
+                report = CreateReport(trace);
+            }
+        }
+        catch (Exception exception) when (exception is JsonException or KeyNotFoundException
+                                              or InvalidOperationException or FormatException)
+        {
+            // The message comes from the page, so drop it rather than let it throw back into native code
+            return true;
+        }
+
+        handler(report);
+        return true;
+    }
+
+    /// <summary>
+    /// Starts tracing a web message through managed code if it is the browser event that the page announced.
+    /// </summary>
+    /// <param name="message">The web message that was received.</param>
+    /// <returns>The interaction to make current while the message is handled, or null if it is not one.</returns>
+    public InteractionTrace? BeginMessage(string message)
+    {
+        if (!message.StartsWith(DispatchBrowserEventMessagePrefix, StringComparison.Ordinal))
+        {
+            return null;
+        }
+
+        lock (_lock)
+        {
+            var trace = _pendingEvent;
+            if (trace == null)
+            {
+                return null;
+            }
+
+            _pendingEvent = null;
+            _awaitingRender = trace;
+            trace.Stamp(InteractionStage.NativeReceived, TestudoApplication.GetLastMessageReceivedTime());
+            trace.Stamp(InteractionStage.ManagedReceived);
+            return trace;
+        }
+    }
+
+    /// <summary>
+    /// Attributes an outbound render batch to the interaction that caused it.
+    /// </summary>
+    /// <param name="message">The message that is being sent to the web view.</param>
+    public void RenderBatchSent(string message)
+    {
+        if (!message.StartsWith(RenderBatchMessagePrefix, StringComparison.Ordinal))
+        {
+            return;
+        }
+
+        lock (_lock)
+        {
+            // Only the first render batch of an interaction is traced
+            var trace = InteractionTrace.Current ?? _awaitingRender;
+            if (trace == null || trace.IsStamped(InteractionStage.RenderBatchSent) ||
+                !TryParseBatchId(message, out var batchId))
+            {
+                return;
+            }
+
+            if (_batches.Count >= MaxOutstandingBatches)
+            {
+                _batches.Clear();
+            }
+
+            trace.Stamp(InteractionStage.RenderBatchSent);
+            _batches[batchId] = trace;
+            if (_awaitingRender == trace)
+            {
+                _awaitingRender = null;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Adds a completed interaction to the histograms and builds its report. Must be called while holding the lock.
+    /// </summary>
+    /// <param name="trace">The interaction that completed.</param>
+    /// <returns>The report, which should be passed to the handler once the lock has been released.</returns>
+    private InteractionLatencyReport CreateReport(InteractionTrace trace)
+    {
+        var start = trace[InteractionStage.Input];
+        var previous = TimeSpan.Zero;
+        var stages = new List<InteractionStageTiming>(InteractionTrace.StageCount);
+        for (var stage = InteractionStage.Input; stage <= InteractionStage.Painted; stage++)
+        {
+            if (!trace.IsStamped(stage))
+            {
+                continue;
+            }
+
+            // The page's clock can disagree with this one slightly, so never let a stage appear to end before the last
+            var elapsed = TimeSpan.FromMicroseconds(trace[stage] - start);
+            if (elapsed < previous)
+            {
+                elapsed = previous;
+            }
+
+            _stageHistograms[(int)stage][GetBucket(elapsed - previous)]++;
+            stages.Add(new InteractionStageTiming(stage, elapsed));
+            previous = elapsed;
+        }
+
+        _histogram[GetBucket(previous)]++;
+        var stageHistograms = new Dictionary<InteractionStage, IReadOnlyList<int>>(InteractionTrace.StageCount);
+        for (var stage = 0; stage < InteractionTrace.StageCount; stage++)
+        {
+            stageHistograms[(InteractionStage)stage] = (int[])_stageHistograms[stage].Clone();
+        }
+
+        return new InteractionLatencyReport
+        {
+            Id = trace.Id,
+            EventType = trace.EventType,
+            Stages = stages,
+            Histogram = (int[])_histogram.Clone(),
+            StageHistograms = stageHistograms
+        };
+    }
+
+    /// <summary>
+    /// Converts a timestamp from the page, in milliseconds since the Unix epoch, to microseconds on this clock.
+    /// </summary>
+    private long FromPageTime(JsonElement element) => (long)(element.GetDouble() * 1000 - _epochOffset);
+
+    /// <summary>
+    /// Gets the index of the histogram bucket that the given duration falls into.
+    /// </summary>
+    private static int GetBucket(TimeSpan duration)
+    {
+        var bounds = InteractionLatencyReport.HistogramBucketBounds;
+        for (var i = 0; i < bounds.Count; i++)
+        {
+            if (duration <= bounds[i])
+            {
+                return i;
+            }
+        }
+
+        return bounds.Count;
+    }
+
+    /// <summary>
+    /// Reads the batch ID that follows the message type in a render batch message.
+    /// </summary>
+    private static bool TryParseBatchId(string message, out long batchId)
+    {
+        var arguments = message.AsSpan(RenderBatchMessagePrefix.Length + 1);
+        var end = arguments.IndexOf(',');
+        return long.TryParse(end < 0 ? arguments : arguments[..end], NumberStyles.None, CultureInfo.InvariantCulture,
+            out batchId);
+    }
+}
+
+/// <summary>
+/// The stamps of a single interaction, see <see cref="LatencyTracer" />.
+/// </summary>
+/// <param name="id">Identifies the interaction within its page.</param>
+/// <param name="eventType">The type of the browser event, if the page could tell.</param>
+internal sealed class InteractionTrace(long id, string? eventType)
+{
+    /// <summary>
+    /// The number of values in <see cref="InteractionStage" />.
+    /// </summary>
+    public const int StageCount = (int)InteractionStage.Painted + 1;
+
+    [ThreadStatic]
+    private static InteractionTrace? _current;
+
+    /// <summary>
+    /// The time each stage was reached in microseconds on the <see cref="Stopwatch" /> clock, or 0 if it has not been.
+    /// </summary>
+    private readonly long[] _timestamps = new long[StageCount];
+
+    /// <summary>
+    /// The interaction that the work running on this thread is being done for, if it is being traced.
+    /// </summary>
+    public static InteractionTrace? Current => _current;
+
+    /// <inheritdoc cref="InteractionLatencyReport.Id" />
+    public long Id => id;
+
+    /// <inheritdoc cref="InteractionLatencyReport.EventType" />
+    public string? EventType => eventType;
+
+    /// <summary>
+    /// Gets the time the given stage was reached.
+    /// </summary>
+    public long this[InteractionStage stage] => Volatile.Read(ref _timestamps[(int)stage]);
+
+    /// <summary>
+    /// Makes the given interaction <see cref="Current" /> on this thread until the returned scope is disposed.
+    /// </summary>
+    /// <param name="trace">The interaction, or null for none.</param>
+    public static Scope Enter(InteractionTrace? trace)
+    {
+        var previous = _current;
+        _current = trace;
+        return new Scope(previous);
+    }
+
+    /// <summary>
+    /// Gets whether the given stage has been reached.
+    /// </summary>
+    public bool IsStamped(InteractionStage stage) => this[stage] != 0;
+
+    /// <summary>
+    /// Stamps the given stage with the current time, unless it has already been reached.
+    /// </summary>
+    public void Stamp(InteractionStage stage) => Stamp(stage, LatencyTracer.Now());
+
+    /// <summary>
+    /// Stamps the given stage with the given time, unless it has already been reached.
+    /// </summary>
+    public void Stamp(InteractionStage stage, long timestamp) =>
+        Interlocked.CompareExchange(ref _timestamps[(int)stage], timestamp, 0);
+
+    /// <summary>
+    /// Restores the previous <see cref="Current" /> interaction when disposed.
+    /// </summary>
+    internal readonly struct Scope(InteractionTrace? previous) : IDisposable
+    {
+        /// <inheritdoc />
+        public void Dispose() => _current = previous;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,365 @@
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Net;
+using System.Text;
+using System.Text.Json;
+
+namespace Testudo;
+
+/// <summary>
+/// Learns which resources each page requests while it starts up, and uses that on later launches to load them
+/// before the web view asks for them.
+/// </summary>
+/// <remarks>
+/// The profile of each entry page is the order and time that its resources were first requested in, from when the
+/// host page was requested until the page first rendered. Profiles are persisted between runs under the user's local
+/// application data. On later launches the profiled resources are read into memory in the background as soon as the
+/// first window is created, and the host page is served with <c>&lt;link rel="preload"&gt;</c> hints for them, so
+/// the web view requests them all up front instead of discovering them one by one. Resources that are not requested by
+/// the time the first page has rendered, or shortly after prefetching started, are discarded, and no more than
+/// <see cref="MaxPrefetchedBytes" /> are held at once.
+/// </remarks>
+public sealed class ResourcePrefetcher
+{
+    /// <summary>
+    /// The most resources that are recorded for a single entry page.
+    /// </summary>
+    private const int MaxProfiledResources = 128;
+
+    /// <summary>
+    /// The most bytes of prefetched resources that are held in memory at once.
+    /// </summary>
+    private const long MaxPrefetchedBytes = 32 * 1024 * 1024;
+
+    /// <summary>
+    /// How long prefetched resources are kept for if they are not requested.
+    /// </summary>
+    private static readonly TimeSpan PrefetchLifetime = TimeSpan.FromSeconds(30);
+
+    /// <summary>
+    /// The path of the file that profiles are persisted to.
+    /// </summary>
+    private readonly string _profilePath;
+
+    /// <summary>
+    /// The resources that each entry page requested the last time it started up.<br />
+    /// <b>Key</b> — The path of the entry page.<br />
+    /// <b>Value</b> — The requested resources, in the order they were requested.
+    /// </summary>
+    private readonly ConcurrentDictionary<string, ProfiledResource[]> _profiles;
+
+    /// <summary>
+    /// The resources that have been, or are being, read ahead of time and not yet served.<br />
+    /// <b>Key</b> — The absolute URI of the resource.<br />
+    /// <b>Value</b> — Completes with the resource, or null if it could not be loaded.
+    /// </summary>
+    private readonly ConcurrentDictionary<string, Task<PrefetchedResource?>> _prefetched = [];
+
+    /// <summary>
+    /// Serializes writes to <see cref="_profilePath" />.
+    /// </summary>
+    private readonly SemaphoreSlim _saveLock = new(1, 1);
+
+    private int _isPrefetchStarted;
+
+    /// <summary>
+    /// The total size of the prefetched resources that are held in <see cref="_prefetched" />.
+    /// </summary>
+    private long _prefetchedBytes;
+
+    /// <summary>
+    /// Loads the profiles that were persisted by previous runs of the application.
+    /// </summary>
+    /// <param name="configuration">The application's configuration, which names the directory profiles live in.</param>
+    public ResourcePrefetcher(TestudoApplicationConfigurationWrapper configuration)
+    {
+        var directory = configuration.Configuration.DataDirectory ?? Path.Combine(
+            Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData),
+            configuration.Configuration.ApplicationName,
+            "Testudo");
+        _profilePath = Path.Combine(directory, "resource-profiles.json");
+        _profiles = new ConcurrentDictionary<string, ProfiledResource[]>(LoadProfiles(_profilePath));
+    }
+
+    /// <summary>
+    /// Reads every profiled resource into memory in the background. Only does anything the first time it is called.
+    /// </summary>
+    /// <param name="loadContent">Loads a resource given its absolute URI, returning false if it does not exist.</param>
+    internal void StartPrefetching(ContentLoader loadContent)
+    {
+        if (Interlocked.Exchange(ref _isPrefetchStarted, 1) == 1)
+        {
+            return;
+        }
+
+        foreach (var path in _profiles.Values.SelectMany(p => p).Select(r => r.Path).Distinct())
+        {
+            var uri = TestudoWebViewManager.CreateUri(path);
+            _prefetched[uri] = Task.Run(() =>
+            {
+                if (!loadContent(uri, out var content, out var contentType))
+                {
+                    return null;
+                }
+
+                // Resources that don't fit are left for the web view to request as usual
+                if (Interlocked.Add(ref _prefetchedBytes, content.Length) > MaxPrefetchedBytes)
+                {
+                    Interlocked.Add(ref _prefetchedBytes, -content.Length);
+                    return null;
+                }
+
+                return new PrefetchedResource(content, contentType);
+            });
+        }
+
+        _ = Task.Delay(PrefetchLifetime).ContinueWith(_ => DiscardPrefetched(), TaskScheduler.Default);
+    }
+
+    /// <summary>
+    /// Discards every prefetched resource that has not been taken yet, such as once the first page has rendered.
+    /// </summary>
+    internal void DiscardPrefetched()
+    {
+        foreach (var uri in _prefetched.Keys)
+        {
+            if (_prefetched.TryRemove(uri, out var pending))
+            {
+                Release(pending);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Takes a resource that was read ahead of time, if it has finished loading.
+    /// </summary>
+    /// <param name="uri">The absolute URI of the resource.</param>
+    /// <param name="content">The content of the resource.</param>
+    /// <param name="contentType">The MIME type of the resource.</param>
+    /// <returns>Whether the resource was ready.</returns>
+    /// <remarks>
+    /// A resource that is still loading is left for the caller to load itself rather than blocking the main thread.
+    /// Each resource can only be taken once, after which it is loaded as usual.
+    /// </remarks>
+    internal bool TryTake(string uri, out byte[] content, out string contentType)
+    {
+        if (_prefetched.TryGetValue(uri, out var pending) && pending.IsCompletedSuccessfully
+            && _prefetched.TryRemove(uri, out _) && pending.Result is { } resource)
+        {
+            Interlocked.Add(ref _prefetchedBytes, -resource.Content.Length);
+            content = resource.Content;
+            contentType = resource.ContentType;
+            return true;
+        }
+
+        content = default!;
+        contentType = default!;
+        return false;
+    }
+
+    /// <summary>
+    /// Discards the copy of a resource that was read ahead of time, so that it is read again when it is requested.
+    /// </summary>
+    /// <param name="path">The path of the resource.</param>
+    internal void Invalidate(string path)
+    {
+        if (_prefetched.TryRemove(TestudoWebViewManager.CreateUri(path), out var pending))
+        {
+            Release(pending);
+        }
+    }
+
+    /// <summary>
+    /// Stops counting a discarded resource towards <see cref="MaxPrefetchedBytes" />, once it has finished loading.
+    /// </summary>
+    private void Release(Task<PrefetchedResource?> pending) => pending.ContinueWith(task =>
+    {
+        if (task.IsCompletedSuccessfully && task.Result is { } resource)
+        {
+            Interlocked.Add(ref _prefetchedBytes, -resource.Content.Length);
+        }
+    }, TaskContinuationOptions.ExecuteSynchronously);
+
+    /// <summary>
+    /// Starts recording the resources requested by the given entry page.
+    /// </summary>
+    /// <param name="entryPath">The path of the host page that was requested.</param>
+    /// <returns>The recording, which is saved once it is completed.</returns>
+    internal Recording BeginRecording(string entryPath) => new(this, entryPath);
+
+    /// <summary>
+    /// Adds preload hints for the resources that the given entry page is known to request to its host page.
+    /// </summary>
+    /// <param name="entryPath">The path of the host page.</param>
+    /// <param name="hostPage">The host page as UTF-8.</param>
+    /// <returns>The host page with the hints added after its <c>&lt;head&gt;</c> tag.</returns>
+    internal byte[] AddPreloadHints(string entryPath, byte[] hostPage)
+    {
+        if (!_profiles.TryGetValue(entryPath, out var resources))
+        {
+            return hostPage;
+        }
+
+        var html = Encoding.UTF8.GetString(hostPage);
+        var headStart = html.IndexOf("<head", StringComparison.OrdinalIgnoreCase);
+        var headEnd = headStart < 0 ? -1 : html.IndexOf('>', headStart);
+        if (headEnd < 0)
+        {
+            return hostPage;
+        }
+
+        var hints = new StringBuilder();
+        foreach (var resource in resources)
+        {
+            var (destination, isCrossOrigin) = GetPreloadDestination(resource.Path);
+            if (destination != null)
+            {
+                var href = WebUtility.HtmlEncode(resource.Path);
+                hints.Append($"\n    <link rel=\"preload\" href=\"{href}\" as=\"{destination}\"");
+                hints.Append(isCrossOrigin ? " crossorigin />" : " />");
+            }
+        }
+
+        return Encoding.UTF8.GetBytes(html.Insert(headEnd + 1, hints.ToString()));
+    }
+
+    /// <summary>
+    /// Gets the value of the <c>as</c> attribute to preload the given resource with.
+    /// </summary>
+    /// <param name="path">The path of the resource.</param>
+    /// <returns>
+    /// The destination, or null if the resource should not be hinted, and whether it must be fetched in CORS mode.
+    /// </returns>
+    private static (string? Destination, bool IsCrossOrigin) GetPreloadDestination(string path) =>
+        Path.GetExtension(path).ToLowerInvariant() switch
+        {
+            ".js" => ("script", false),
+            ".css" => ("style", false),
+            ".woff" or ".woff2" or ".ttf" or ".otf" => ("font", true),
+            ".png" or ".jpg" or ".jpeg" or ".gif" or ".svg" or ".webp" or ".ico" => ("image", false),
+            _ => (null, false)
+        };
+
+    /// <summary>
+    /// Replaces the profile of an entry page and persists every profile in the background.
+    /// </summary>
+    private void SaveProfile(string entryPath, ProfiledResource[] resources)
+    {
+        _profiles[entryPath] = resources;
+        _ = Task.Run(async () =>
+        {
+            await _saveLock.WaitAsync();
+            try
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(_profilePath)!);
+                await using var stream = File.Create(_profilePath);
+                await using var writer = new Utf8JsonWriter(stream, new JsonWriterOptions {Indented = true});
+                writer.WriteStartObject();
+                foreach (var (path, profile) in _profiles)
+                {
+                    writer.WriteStartArray(path);
+                    foreach (var resource in profile)
+                    {
+                        writer.WriteStartObject();
+                        writer.WriteString("path", resource.Path);
+                        writer.WriteNumber("offsetMilliseconds", resource.OffsetMilliseconds);
+                        writer.WriteEndObject();
+                    }
+
+                    writer.WriteEndArray();
+                }
+
+                writer.WriteEndObject();
+            }
+            catch (Exception exception) when (exception is IOException or UnauthorizedAccessException)
+            {
+                // The profile is only an optimization, so the next launch simply starts cold
+            }
+            finally
+            {
+                _saveLock.Release();
+            }
+        });
+    }
+
+    /// <summary>
+    /// Reads the profiles persisted by a previous run.
+    /// </summary>
+    /// <returns>The profiles, or nothing if the file does not exist or could not be read.</returns>
+    private static IEnumerable<KeyValuePair<string, ProfiledResource[]>> LoadProfiles(string profilePath)
+    {
+        try
+        {
+            if (!File.Exists(profilePath))
+            {
+                return [];
+            }
+
+            using var document = JsonDocument.Parse(File.ReadAllBytes(profilePath));
+            return document.RootElement.EnumerateObject()
+                .Select(entry => new KeyValuePair<string, ProfiledResource[]>(entry.Name, entry.Value
+                    .EnumerateArray()
+                    .Select(r => new ProfiledResource(
+                        r.GetProperty("path").GetString()!,
+                        r.GetProperty("offsetMilliseconds").GetDouble()))
+                    .ToArray()))
+                .ToList();
+        }
+        catch (Exception exception) when (exception is IOException or UnauthorizedAccessException or JsonException
+                                              or KeyNotFoundException or InvalidOperationException)
+        {
+            // A missing or corrupt profile only means that this launch starts cold
+            return [];
+        }
+    }
+
+    /// <summary>
+    /// Loads a resource given its absolute URI.
+    /// </summary>
+    internal delegate bool ContentLoader(string uri, out byte[] content, out string contentType);
+
+    /// <summary>
+    /// A resource that an entry page requested while it started up.
+    /// </summary>
+    /// <param name="Path">The path of the resource.</param>
+    /// <param name="OffsetMilliseconds">How long after the host page the resource was requested.</param>
+    private readonly record struct ProfiledResource(string Path, double OffsetMilliseconds);
+
+    /// <summary>
+    /// A resource that was read ahead of time.
+    /// </summary>
+    private sealed record PrefetchedResource(byte[] Content, string ContentType);
+
+    /// <summary>
+    /// Records the resources requested by a single entry page until it first renders.
+    /// </summary>
+    /// <remarks>
+    /// Only used on the main thread, where the web view's requests are served.
+    /// </remarks>
+    internal sealed class Recording(ResourcePrefetcher owner, string entryPath)
+    {
+        private readonly long _startTimestamp = Stopwatch.GetTimestamp();
+
+        private readonly List<ProfiledResource> _resources = [];
+
+        private readonly HashSet<string> _paths = [];
+
+        /// <summary>
+        /// Records a resource request, unless the same resource was already requested.
+        /// </summary>
+        /// <param name="path">The path of the resource.</param>
+        public void Add(string path)
+        {
+            if (_resources.Count < MaxProfiledResources && _paths.Add(path))
+            {
+                _resources.Add(new ProfiledResource(path,
+                    Stopwatch.GetElapsedTime(_startTimestamp).TotalMilliseconds));
+            }
+        }
+
+        /// <summary>
+        /// Replaces the entry page's profile with this recording and persists it.
+        /// </summary>
+        public void Complete() => owner.SaveProfile(entryPath, _resources.ToArray());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,387 @@
+using System.Diagnostics.CodeAnalysis;
+using System.Net.Sockets;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Testudo;
+
+/// <summary>
+/// Keeps an application to a single running instance per user, by handing the arguments of any later launch to the
+/// instance that is already running.
+/// </summary>
+/// <remarks>
+/// The running instance listens on a Unix domain socket, which is in <c>$XDG_RUNTIME_DIR</c> on Linux and under the
+/// user's local application data on Windows. A later launch connects to it, writes its arguments and exits before it
+/// has initialized GTK or WebView2, built its services or started a web process. <see cref="TryAcquire" /> must
+/// therefore be called at the very start of <c>Main</c>. On Linux, connections from other users are refused.
+/// </remarks>
+public sealed class SingleInstance : IDisposable
+{
+    /// <summary>
+    /// How long the running instance waits for a later launch to finish writing its arguments.
+    /// </summary>
+    private const int ReceiveTimeoutMilliseconds = 1000;
+
+    /// <summary>
+    /// The most arguments that a later launch may hand over.
+    /// </summary>
+    private const int MaxArguments = 1024;
+
+    /// <summary>
+    /// The most bytes of UTF-8 that the arguments of a later launch may add up to.
+    /// </summary>
+    private const int MaxArgumentBytes = 1024 * 1024;
+
+    /// <summary>
+    /// The <c>SOL_SOCKET</c> option level on Linux.
+    /// </summary>
+    private const int SolSocket = 1;
+
+    /// <summary>
+    /// The <c>SO_PEERCRED</c> socket option on Linux, which gets the <c>ucred</c> of the connected process.
+    /// </summary>
+    private const int SoPeerCred = 17;
+
+    /// <summary>
+    /// How many times a launch tries to hand its arguments over or become the running instance before it gives up.
+    /// </summary>
+    private const int MaxAttempts = 20;
+
+    /// <summary>
+    /// How long a launch waits between attempts while another launch holds the lock but is not listening yet.
+    /// </summary>
+    private const int RetryDelayMilliseconds = 100;
+
+    /// <summary>
+    /// The socket that later launches connect to.
+    /// </summary>
+    private readonly Socket _listener;
+
+    /// <summary>
+    /// The path of the socket file.
+    /// </summary>
+    private readonly string _socketPath;
+
+    /// <summary>
+    /// The lock file that is held for as long as this is the running instance, which tells later launches that the
+    /// socket file is not stale even before it is listening.
+    /// </summary>
+    private readonly FileStream _lock;
+
+    /// <summary>
+    /// Stops accepting later launches.
+    /// </summary>
+    private readonly CancellationTokenSource _cancellation = new();
+
+    private int _isListening;
+
+    private SingleInstance(Socket listener, string socketPath, FileStream @lock)
+    {
+        _listener = listener;
+        _socketPath = socketPath;
+        _lock = @lock;
+    }
+
+    /// <summary>
+    /// Becomes the running instance of the application, or hands the given arguments to the instance that is already
+    /// running.
+    /// </summary>
+    /// <param name="applicationName">
+    /// The name of the application, which should match <see cref="TestudoApplicationConfiguration.ApplicationName" />.
+    /// </param>
+    /// <param name="arguments">The command line arguments of this launch.</param>
+    /// <param name="instance">The running instance, which must be kept alive until the application exits.</param>
+    /// <returns>
+    /// Whether this process is the running instance. If not, its arguments have been handed over and it should exit.
+    /// </returns>
+    /// <exception cref="InvalidOperationException">
+    /// There is no private runtime directory to put the socket in, or another launch held the lock without ever
+    /// listening.
+    /// </exception>
+    public static bool TryAcquire(string applicationName, IReadOnlyList<string> arguments,
+        [NotNullWhen(true)] out SingleInstance? instance)
+    {
+        var socketPath = GetSocketPath(applicationName);
+        var endPoint = new UnixDomainSocketEndPoint(socketPath);
+
+        for (var attempt = 0; attempt < MaxAttempts; attempt++)
+        {
+            if (TryActivate(endPoint, arguments))
+            {
+                instance = null;
+                return false;
+            }
+
+            // Another launch that has bound the socket but is not listening yet also holds the lock, so wait for it
+            // to start listening rather than take its place
+            if (TryLock(socketPath) is not { } @lock)
+            {
+                Thread.Sleep(RetryDelayMilliseconds);
+                continue;
+            }
+
+            // The lock is released when its holder exits, so a socket file without it was left behind by an instance
+            // that did not exit cleanly
+            if (File.Exists(socketPath))
+            {
+                File.Delete(socketPath);
+            }
+
+            var listener = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+            try
+            {
+                listener.Bind(endPoint);
+                if (!OperatingSystem.IsWindows())
+                {
+                    File.SetUnixFileMode(socketPath, UnixFileMode.UserRead | UnixFileMode.UserWrite);
+                }
+
+                listener.Listen();
+                instance = new SingleInstance(listener, socketPath, @lock);
+                return true;
+            }
+            catch
+            {
+                listener.Dispose();
+                @lock.Dispose();
+                throw;
+            }
+        }
+
+        throw new InvalidOperationException($"Could not connect to or become the running instance of " +
+                                            $"{applicationName}.");
+    }
+
+    /// <summary>
+    /// Raised when the arguments of a later launch could not be received, or the handler passed to
+    /// <see cref="Listen" /> threw. The instance keeps listening regardless.
+    /// </summary>
+    /// <remarks>
+    /// Raised on a thread pool thread.
+    /// </remarks>
+    public event Action<Exception>? ActivationFailed;
+
+    /// <summary>
+    /// Starts receiving the arguments of later launches.
+    /// </summary>
+    /// <param name="activated">
+    /// Called with the arguments of each later launch, on a thread pool thread. Typically opens or focuses a window
+    /// through <see cref="ITestudoApplication.Invoke" /> and <see cref="ITestudoWindow.Activate" />.
+    /// </param>
+    /// <remarks>
+    /// Launches that happen before this is called wait in the socket's backlog, so call it once the application is
+    /// ready to open windows. Enabling <see cref="TestudoApplicationConfiguration.IsWebViewPrewarmEnabled" /> keeps
+    /// a web view engine warm for the windows that later launches open.
+    /// </remarks>
+    public void Listen(Action<IReadOnlyList<string>> activated)
+    {
+        if (Interlocked.Exchange(ref _isListening, 1) == 0)
+        {
+            _ = AcceptAsync(activated, _cancellation.Token);
+        }
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        _cancellation.Cancel();
+        _listener.Dispose();
+        _cancellation.Dispose();
+        File.Delete(_socketPath);
+
+        // The lock file is left in place, as deleting it would let two launches lock different files
+        _lock.Dispose();
+    }
+
+    /// <summary>
+    /// Gets the socket path that every launch of the given application by the current user agrees on.
+    /// </summary>
+    /// <param name="applicationName">The name of the application.</param>
+    /// <returns>The path of the socket file.</returns>
+    private static string GetSocketPath(string applicationName)
+    {
+        if (OperatingSystem.IsLinux())
+        {
+            // Abstract sockets and shared directories such as /tmp can be squatted by any local user, so only a
+            // runtime directory that is private to the user will do
+            var runtimeDirectory = Environment.GetEnvironmentVariable("XDG_RUNTIME_DIR");
+            if (string.IsNullOrEmpty(runtimeDirectory) || !Directory.Exists(runtimeDirectory) ||
+                (File.GetUnixFileMode(runtimeDirectory) & (UnixFileMode.GroupWrite | UnixFileMode.OtherWrite)) != 0)
+            {
+                throw new InvalidOperationException("Single instance mode needs $XDG_RUNTIME_DIR to be set to a " +
+                                                    "directory that only the current user can write to.");
+            }
+
+            return Path.Combine(runtimeDirectory, $"testudo-{applicationName}-{Environment.UserName}.sock");
+        }
+
+        var directory = Path.Combine(
+            Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData),
+            applicationName,
+            "Testudo");
+        Directory.CreateDirectory(directory);
+        return Path.Combine(directory, "instance.sock");
+    }
+
+    /// <summary>
+    /// Takes the lock that the running instance holds for as long as it runs.
+    /// </summary>
+    /// <param name="socketPath">The path of the socket file, which the lock file is named after.</param>
+    /// <returns>The open lock file, or null if another launch holds the lock.</returns>
+    /// <remarks>
+    /// <see cref="FileShare.None" /> takes an exclusive <c>flock</c> on Linux, and an exclusive handle on Windows.
+    /// </remarks>
+    private static FileStream? TryLock(string socketPath)
+    {
+        try
+        {
+            return new FileStream($"{socketPath}.lock", FileMode.OpenOrCreate, FileAccess.ReadWrite, FileShare.None);
+        }
+        catch (IOException)
+        {
+            return null;
+        }
+    }
+
+    /// <summary>
+    /// Hands the given arguments to the running instance, if there is one.
+    /// </summary>
+    /// <param name="endPoint">The running instance's socket.</param>
+    /// <param name="arguments">The arguments to hand over.</param>
+    /// <returns>Whether there was a running instance to hand the arguments to.</returns>
+    private static bool TryActivate(UnixDomainSocketEndPoint endPoint, IReadOnlyList<string> arguments)
+    {
+        using var socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified);
+        try
+        {
+            socket.Connect(endPoint);
+        }
+        catch (SocketException)
+        {
+            return false;
+        }
+
+        // The running instance reads the arguments whenever it gets to them, so there is no need to wait for it
+        using var stream = new NetworkStream(socket);
+        using var writer = new BinaryWriter(stream, Encoding.UTF8);
+        writer.Write(arguments.Count);
+        foreach (var argument in arguments)
+        {
+            writer.Write(argument);
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Accepts later launches until this instance is disposed.
+    /// </summary>
+    /// <param name="activated">Called with the arguments of each later launch.</param>
+    /// <param name="cancellationToken">Stops accepting launches.</param>
+    private async Task AcceptAsync(Action<IReadOnlyList<string>> activated, CancellationToken cancellationToken)
+    {
+        while (!cancellationToken.IsCancellationRequested)
+        {
+            Socket client;
+            try
+            {
+                client = await _listener.AcceptAsync(cancellationToken);
+            }
+            catch (Exception exception) when (exception is OperationCanceledException or ObjectDisposedException)
+            {
+                return;
+            }
+
+            // A misbehaving launch or handler must not stop later launches from being accepted
+            try
+            {
+                using (client)
+                {
+                    if (IsSameUser(client) && TryReceive(client) is { } arguments)
+                    {
+                        activated(arguments);
+                    }
+                }
+            }
+            catch (Exception exception)
+            {
+                ActivationFailed?.Invoke(exception);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Checks that a later launch belongs to the same user as the running instance.
+    /// </summary>
+    /// <param name="client">The later launch's connection.</param>
+    /// <returns>
+    /// Whether the peer runs as the current user. Always true on Windows, where the socket is protected by the
+    /// permissions of the user's profile instead.
+    /// </returns>
+    private static bool IsSameUser(Socket client)
+    {
+        if (!OperatingSystem.IsLinux())
+        {
+            return true;
+        }
+
+        // struct ucred { pid_t pid; uid_t uid; gid_t gid; }
+        Span<byte> credentials = stackalloc byte[12];
+        if (client.GetRawSocketOption(SolSocket, SoPeerCred, credentials) != credentials.Length)
+        {
+            return false;
+        }
+
+        return MemoryMarshal.Read<uint>(credentials[4..]) == geteuid();
+    }
+
+    /// <summary>
+    /// Reads the arguments that a later launch handed over.
+    /// </summary>
+    /// <param name="client">The later launch's connection.</param>
+    /// <returns>The arguments, or null if they could not be read.</returns>
+    private static string[]? TryReceive(Socket client)
+    {
+        client.ReceiveTimeout = ReceiveTimeoutMilliseconds;
+        try
+        {
+            using var stream = new NetworkStream(client);
+            using var reader = new BinaryReader(stream, Encoding.UTF8);
+            var count = reader.ReadInt32();
+            if (count is < 0 or > MaxArguments)
+            {
+                return null;
+            }
+
+            // BinaryReader.ReadString trusts the length prefix, so read the strings by hand to bound what is allocated
+            var arguments = new string[count];
+            var remainingBytes = MaxArgumentBytes;
+            for (var i = 0; i < count; i++)
+            {
+                var length = reader.Read7BitEncodedInt();
+                if (length < 0 || length > remainingBytes)
+                {
+                    return null;
+                }
+
+                var bytes = reader.ReadBytes(length);
+                if (bytes.Length != length)
+                {
+                    return null;
+                }
+
+                remainingBytes -= length;
+                arguments[i] = Encoding.UTF8.GetString(bytes);
+            }
+
+            return arguments;
+        }
+        catch (Exception exception) when (exception is IOException or EndOfStreamException or FormatException)
+        {
+            return null;
+        }
+    }
+
+    [DllImport("libc", SetLastError = false)]
+    private static extern uint geteuid();
+}
\ No newline at end of file
@@ -58,7 +58,7 @@ public partial class TestudoDispatcher : Dispatcher, IDisposable
             }
 
             // Invoke the action on the main thread
-            _application.Invoke(next.Execute);
+            _application.Invoke(next.Execute, next.Callback);
         }
 
         _thread.Join();
@@ -71,7 +71,7 @@ public partial class TestudoDispatcher : Dispatcher, IDisposable
     public override Task InvokeAsync(Action workItem)
     {
         var item = new QueueItem(workItem);
-        _queue.Add(item);
+        Enqueue(item);
         return item.Task;
     }
 
@@ -79,7 +79,7 @@ public partial class TestudoDispatcher : Dispatcher, IDisposable
     public override Task InvokeAsync(Func<Task> workItem)
     {
         var item = new QueueItem(workItem);
-        _queue.Add(item);
+        Enqueue(item);
         return item.Task;
     }
 
@@ -87,7 +87,7 @@ public partial class TestudoDispatcher : Dispatcher, IDisposable
     public override Task<TResult> InvokeAsync<TResult>(Func<TResult> workItem)
     {
         var item = new QueueItem<TResult>(workItem);
-        _queue.Add(item);
+        Enqueue(item);
         return item.Task;
     }
 
@@ -95,15 +95,35 @@ public partial class TestudoDispatcher : Dispatcher, IDisposable
     public override Task<TResult> InvokeAsync<TResult>(Func<Task<TResult>> workItem)
     {
         var item = new QueueItem<TResult>(workItem);
-        _queue.Add(item);
+        Enqueue(item);
         return item.Task;
     }
 
+    /// <summary>
+    /// Adds an action to the queue, stamping the interaction it was queued for if it is being traced.
+    /// </summary>
+    /// <param name="item">The action to queue.</param>
+    private void Enqueue(IQueueItem item)
+    {
+        item.Trace?.Stamp(InteractionStage.DispatcherQueued);
+        _queue.Add(item);
+    }
+
     /// <summary>
     /// Represents an action in the dispatcher queue.
     /// </summary>
     private interface IQueueItem
     {
+        /// <summary>
+        /// The interaction that was current when this item was queued, or null if it was not being traced.
+        /// </summary>
+        InteractionTrace? Trace { get; }
+
+        /// <summary>
+        /// The delegate that was queued, used to describe this item in stall reports.
+        /// </summary>
+        Delegate Callback { get; }
+
         /// <summary>
         /// Executes the action associated with this queue item.
         /// </summary>
@@ -119,10 +139,20 @@ public partial class TestudoDispatcher : Dispatcher, IDisposable
     {
         protected readonly TaskCompletionSource<TResult> _completion = new();
 
+        /// <inheritdoc />
+        public Delegate Callback => callback;
+
+        /// <inheritdoc />
+        public InteractionTrace? Trace { get; } = InteractionTrace.Current;
+
         /// <inheritdoc />
         /// <exception cref="NotSupportedException">Throws if the delegate type is not recognised.</exception>
         public void Execute()
         {
+            // Anything that runs synchronously here, such as a render batch, is attributed to the same interaction
+            Trace?.Stamp(InteractionStage.MainThreadInvoked);
+            using var scope = InteractionTrace.Enter(Trace);
+
             var result = callback.DynamicInvoke();
             switch (result)
             {
@@ -1,7 +1,9 @@
 using System.Runtime.InteropServices;
+using System.Security.Cryptography;
 using Microsoft.AspNetCore.Components;
 using Microsoft.AspNetCore.Components.Web;
 using Microsoft.AspNetCore.Components.WebView;
+using Microsoft.Extensions.DependencyInjection;
 using Microsoft.Extensions.FileProviders;
 
 namespace Testudo;
@@ -17,7 +19,8 @@ public class TestudoWebViewManager : WebViewManager
     /// <summary>
     /// Delegate that represents <see cref="OnWebResourceRequested" />.
     /// </summary>
-    public delegate IntPtr WebResourceRequestedDelegate(string uri, out int sizeBytes, out string contentType);
+    public delegate IntPtr WebResourceRequestedDelegate(string uri, string? ifNoneMatch, out int sizeBytes,
+        out string contentType, out string? entityTag);
 
     /// <summary>
     /// The path of <c>index.html</c> relative to <c>wwwroot</c>.
@@ -36,17 +39,61 @@ public class TestudoWebViewManager : WebViewManager
     /// </summary>
     private static readonly Uri BaseUri = new($"{UriScheme}://localhost/");
 
+    /// <summary>
+    /// The prefix of the IPC message that carries a render batch to the web view.
+    /// </summary>
+    private const string RenderBatchMessagePrefix = "__bwv:[\"RenderBatch\"";
+
+    /// <summary>
+    /// The prefix of the IPC message that the web view sends once it has applied a render batch.
+    /// </summary>
+    private const string RenderCompletedMessagePrefix = "__bwv:[\"OnRenderCompleted\"";
+
+    /// <summary>
+    /// Whether any web view has been sent a render batch yet, used to stamp <see cref="StartupPhase" />.
+    /// </summary>
+    private static bool _isFirstRenderBatchSent;
+
+    /// <summary>
+    /// Whether any web view has applied a render batch yet, used to stamp <see cref="StartupPhase" />.
+    /// </summary>
+    private static bool _isFirstRenderCompleted;
+
     /// <summary>
     /// The window that contains the web view that this class is managing.
     /// </summary>
     private readonly ITestudoWindow _window;
 
+    /// <summary>
+    /// Reads ahead the resources that pages are known to request while they start up.
+    /// </summary>
+    private readonly ResourcePrefetcher _prefetcher;
+
+    /// <summary>
+    /// Records the resources requested by the current page until it first renders, or null once it has.
+    /// </summary>
+    private ResourcePrefetcher.Recording? _recording;
+
+    /// <summary>
+    /// Watches the web root for changes, or null if <see cref="Extensions.AddLiveWebRoot" /> was not used.
+    /// </summary>
+    private readonly WebRootWatcher? _webRootWatcher;
+
+    /// <summary>
+    /// Traces each interaction from input to paint, or null if latency tracing is not enabled.
+    /// </summary>
+    private readonly LatencyTracer? _latencyTracer;
+
     /// <inheritdoc cref="WebViewManager" />
     /// <param name="window">The native window that contains this web view.</param>
     /// <param name="provider">The service provider associated with this web view's scope.</param>
     /// <param name="dispatcher">A dispatcher that synchronously dispatches actions to the UI thread.</param>
     /// <param name="fileProvider">A file provider that resolves web resources for this application.</param>
     /// <param name="jsComponents">The JS component configuration store for this application.</param>
+    /// <param name="prefetcher">Reads ahead the resources that pages are known to request while they start up.</param>
+    /// <param name="interactionTracedHandler">
+    /// Receives the latency of each interaction with the page, or null to not trace them.
+    /// </param>
     /// <param name="webMessageReceivedHandler">The web message received delegate for the window configuration.</param>
     /// <param name="webResourceRequestedHandler">
     /// The web resource requested delegate for the window configuration.
@@ -56,11 +103,24 @@ public class TestudoWebViewManager : WebViewManager
         Dispatcher dispatcher,
         IFileProvider fileProvider,
         JSComponentConfigurationStore jsComponents,
+        ResourcePrefetcher prefetcher,
+        Action<InteractionLatencyReport>? interactionTracedHandler,
         out WebMessageReceivedDelegate webMessageReceivedHandler,
         out WebResourceRequestedDelegate webResourceRequestedHandler)
         : base(provider, dispatcher, BaseUri, fileProvider, jsComponents, HostPageRelativePath)
     {
         _window = window;
+        _prefetcher = prefetcher;
+        _prefetcher.StartPrefetching(TryLoadContent);
+        _webRootWatcher = provider.GetService<WebRootWatcher>();
+        if (_webRootWatcher != null)
+        {
+            _webRootWatcher.FileChanged += OnWebRootFileChanged;
+        }
+        if (interactionTracedHandler != null)
+        {
+            _latencyTracer = new LatencyTracer(interactionTracedHandler);
+        }
         webMessageReceivedHandler = OnWebMessageReceived;
         webResourceRequestedHandler = OnWebResourceRequested;
     }
@@ -81,16 +141,69 @@ public class TestudoWebViewManager : WebViewManager
     /// <inheritdoc />
     protected override void SendMessage(string message)
     {
+        // Messages are only inspected until the first render, after which this is a single flag check
+        if (!_isFirstRenderBatchSent && message.StartsWith(RenderBatchMessagePrefix, StringComparison.Ordinal))
+        {
+            _isFirstRenderBatchSent = true;
+            TestudoApplication.MarkStartupPhase(StartupPhase.FirstRenderBatchSent);
+        }
+
+        _latencyTracer?.RenderBatchSent(message);
         _window.SendMessage(message);
     }
 
+    /// <inheritdoc />
+    protected override ValueTask DisposeAsyncCore()
+    {
+        if (_webRootWatcher != null)
+        {
+            _webRootWatcher.FileChanged -= OnWebRootFileChanged;
+        }
+
+        return base.DisposeAsyncCore();
+    }
+
+    /// <summary>
+    /// Refreshes a file that changed in the web root.
+    /// </summary>
+    /// <param name="path">The path of the file relative to the web root.</param>
+    private void OnWebRootFileChanged(string path) =>
+        _ = _window.ExecuteScriptAsync(WebRootWatcher.CreateRefreshScript(path));
+
     /// <summary>
     /// Callback for <see cref="TestudoWindowConfiguration.WebMessageReceivedHandler" />.
     /// </summary>
     /// <param name="message">The message that was received.</param>
     private void OnWebMessageReceived(string message)
     {
-        MessageReceived(BaseUri, message);
+        // Trace messages come from the page's half of the latency tracer and are not meant for Blazor
+        if (_latencyTracer != null && _latencyTracer.TryHandleMessage(message))
+        {
+            return;
+        }
+
+        // The work that Blazor queues for a browser event is attributed to its interaction
+        using (InteractionTrace.Enter(_latencyTracer?.BeginMessage(message)))
+        {
+            MessageReceived(BaseUri, message);
+        }
+
+        // The page has started up, so the resources it needed to get there are known
+        if (_recording != null && message.StartsWith(RenderCompletedMessagePrefix, StringComparison.Ordinal))
+        {
+            _recording.Complete();
+            _recording = null;
+        }
+
+        // Stamped after the message has been handled, so that it is the last thing startup waits on
+        if (!_isFirstRenderCompleted && message.StartsWith(RenderCompletedMessagePrefix, StringComparison.Ordinal))
+        {
+            _isFirstRenderCompleted = true;
+            TestudoApplication.MarkStartupPhase(StartupPhase.FirstRenderCompleted);
+
+            // Anything the page needed to start up has been requested by now
+            _prefetcher.DiscardPrefetched();
+        }
     }
 
     /// <summary>
@@ -98,11 +211,23 @@ public class TestudoWebViewManager : WebViewManager
     /// Parses the URL and returns the appropriate content buffer.
     /// </summary>
     /// <param name="uri">The URI associated with the desired resource.</param>
+    /// <param name="ifNoneMatch">The entity tag of the copy that the web view has cached, if it has one.</param>
     /// <param name="size">The size of the resulting data stream in bytes.</param>
     /// <param name="contentType">The MIME type associated with the resource.</param>
-    /// <returns>A pointer to a buffer containing the data of the requested resource.</returns>
-    private IntPtr OnWebResourceRequested(string uri, out int size, out string contentType)
+    /// <param name="entityTag">A hash of the resource's content, which the web view caches it under.</param>
+    /// <returns>
+    /// A pointer to a buffer containing the data of the requested resource, or <see cref="IntPtr.Zero" /> if it
+    /// does not exist or the web view's cached copy is still current.
+    /// </returns>
+    /// <remarks>
+    /// Requests for anything other than a file fall back to the host page, which starts a new
+    /// <see cref="ResourcePrefetcher.Recording" /> and is served with preload hints for what it will request.
+    /// </remarks>
+    private IntPtr OnWebResourceRequested(string uri, string? ifNoneMatch, out int size, out string contentType,
+        out string? entityTag)
     {
+        entityTag = null;
+
         var localPath = new Uri(uri).LocalPath;
         var isFile = Path.HasExtension(localPath);
 
@@ -113,27 +238,114 @@ public class TestudoWebViewManager : WebViewManager
             uri = uri[..index];
         }
 
-        // Get the content corresponding to the URI
+        byte[] content;
+        if (isFile)
+        {
+            _recording?.Add(localPath);
+            if (!_prefetcher.TryTake(uri, out content, out contentType)
+                && !TryLoadContent(uri, false, out content, out contentType))
+            {
+                size = 0;
+                return IntPtr.Zero;
+            }
+        }
+        else
+        {
+            _recording = _prefetcher.BeginRecording(localPath);
+            if (!TryLoadContent(uri, true, out content, out contentType))
+            {
+                size = 0;
+                return IntPtr.Zero;
+            }
+
+            content = _prefetcher.AddPreloadHints(localPath, content);
+        }
+
+        // Content that has not changed since the web view cached it does not need to be copied across again
+        entityTag = CreateEntityTag(content);
+        if (ifNoneMatch != null && IsMatch(ifNoneMatch, entityTag))
+        {
+            size = 0;
+            return IntPtr.Zero;
+        }
+
+        // Testudo.Native uses a CoTaskMem smart pointer to free "buffer" when it is finished with it
+        // so there is no need to free that memory here
+        size = content.Length;
+        var buffer = Marshal.AllocHGlobal(size);
+        Marshal.Copy(content, 0, buffer, size);
+        return buffer;
+    }
+
+    /// <summary>
+    /// Creates an entity tag from a hash of the given content, so that it is the same across runs and builds for as
+    /// long as the content does not change.
+    /// </summary>
+    /// <param name="content">The content of a resource.</param>
+    /// <returns>The quoted entity tag.</returns>
+    private static string CreateEntityTag(byte[] content) =>
+        $"\"{Convert.ToHexString(SHA256.HashData(content), 0, 16)}\"";
+
+    /// <summary>
+    /// Checks whether an <c>If-None-Match</c> header names the given entity tag.
+    /// </summary>
+    /// <param name="ifNoneMatch">The value of the header, which may list several entity tags.</param>
+    /// <param name="entityTag">The current entity tag of the resource.</param>
+    private static bool IsMatch(string ifNoneMatch, string entityTag)
+    {
+        foreach (var candidate in ifNoneMatch.Split(',', StringSplitOptions.TrimEntries))
+        {
+            // Weak comparison is enough to reuse a cached copy
+            var tag = candidate.StartsWith("W/", StringComparison.Ordinal) ? candidate[2..] : candidate;
+            if (tag == "*" || string.Equals(tag, entityTag, StringComparison.Ordinal))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// <inheritdoc cref="TryLoadContent(string, bool, out byte[], out string)" />
+    /// <remarks>
+    /// Used to read resources ahead of time, which are always files.
+    /// </remarks>
+    private bool TryLoadContent(string uri, out byte[] content, out string contentType) =>
+        TryLoadContent(uri, false, out content, out contentType);
+
+    /// <summary>
+    /// Reads the content of a resource.
+    /// </summary>
+    /// <param name="uri">The absolute URI of the resource, without a query string.</param>
+    /// <param name="allowFallbackOnHostPage">Whether to serve the host page if the URI is not a file.</param>
+    /// <param name="content">The content of the resource.</param>
+    /// <param name="contentType">The MIME type of the resource.</param>
+    /// <returns>Whether the resource exists.</returns>
+    /// <remarks>
+    /// May be called from any thread.
+    /// </remarks>
+    private bool TryLoadContent(string uri, bool allowFallbackOnHostPage, out byte[] content,
+        out string contentType)
+    {
         if (uri.StartsWith(BaseUri.ToString(), StringComparison.Ordinal)
-            && TryGetResponseContent(uri, !isFile, out _, out _,
-                out var content, out var headers))
+            && TryGetResponseContent(uri, allowFallbackOnHostPage, out _, out _,
+                out var stream, out var headers))
         {
             headers.TryGetValue("Content-Type", out var streamContentType);
             contentType = streamContentType ?? "application/octet-stream";
 
-            using var stream = new MemoryStream();
-            content.CopyTo(stream);
-            size = (int)stream.Position;
+            using var memoryStream = new MemoryStream();
+            using (stream)
+            {
+                stream.CopyTo(memoryStream);
+            }
 
-            // Testudo.Native uses a CoTaskMem smart pointer to free "buffer" when it is finished with it
-            // so there is no need to free that memory here
-            var buffer = Marshal.AllocHGlobal(size);
-            Marshal.Copy(stream.ToArray(), 0, buffer, size);
-            return buffer;
+            content = memoryStream.ToArray();
+            return true;
         }
 
-        size = 0;
+        content = default!;
         contentType = default!;
-        return IntPtr.Zero;
+        return false;
     }
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+using System.Collections.Concurrent;
+using System.Text.Json;
+
+namespace Testudo;
+
+/// <summary>
+/// Watches a <c>wwwroot</c> directory during development and refreshes changed files in every open web view.
+/// </summary>
+/// <remarks>
+/// Changed stylesheets are swapped in place, and any other change reloads the page. Only the changed files are
+/// dropped from <see cref="ResourcePrefetcher" />, so everything else is still served from memory.
+/// Registered by <see cref="Extensions.AddLiveWebRoot" />.
+/// </remarks>
+public sealed class WebRootWatcher : IDisposable
+{
+    /// <summary>
+    /// How long to wait for a file to stop changing before refreshing it, as editors often write a file in several
+    /// steps.
+    /// </summary>
+    private static readonly TimeSpan SettleDelay = TimeSpan.FromMilliseconds(100);
+
+    private readonly FileSystemWatcher _watcher;
+
+    private readonly ResourcePrefetcher _prefetcher;
+
+    /// <summary>
+    /// The directory being watched.
+    /// </summary>
+    private readonly string _directory;
+
+    /// <summary>
+    /// The changes that are waiting for their file to settle.<br />
+    /// <b>Key</b> — The path of the changed file relative to the web root, starting with a slash.<br />
+    /// <b>Value</b> — Fires once the file has settled.
+    /// </summary>
+    private readonly ConcurrentDictionary<string, Timer> _pendingChanges = [];
+
+    /// <summary>
+    /// Raised once a file in the web root has changed and settled, with its path relative to the web root.
+    /// </summary>
+    /// <remarks>
+    /// Raised on a thread pool thread.
+    /// </remarks>
+    public event Action<string>? FileChanged;
+
+    /// <summary>
+    /// Starts watching the given directory.
+    /// </summary>
+    /// <param name="directory">The web root directory to watch.</param>
+    /// <param name="prefetcher">The prefetcher whose copies of changed files must be discarded.</param>
+    public WebRootWatcher(string directory, ResourcePrefetcher prefetcher)
+    {
+        _directory = Path.GetFullPath(directory);
+        _prefetcher = prefetcher;
+
+        // On Linux this is backed by inotify, so nothing is polled
+        _watcher = new FileSystemWatcher(_directory)
+        {
+            IncludeSubdirectories = true,
+            NotifyFilter = NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size
+        };
+
+        _watcher.Changed += OnFileSystemEvent;
+        _watcher.Created += OnFileSystemEvent;
+        _watcher.Deleted += OnFileSystemEvent;
+        _watcher.Renamed += (_, e) =>
+        {
+            OnFileSystemEvent(null, new FileSystemEventArgs(WatcherChangeTypes.Deleted, _directory, e.OldName));
+            OnFileSystemEvent(null, e);
+        };
+        _watcher.EnableRaisingEvents = true;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        _watcher.Dispose();
+        foreach (var (_, timer) in _pendingChanges)
+        {
+            timer.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// Creates the script that refreshes the given file in a web view.
+    /// </summary>
+    /// <param name="path">The path of the changed file relative to the web root, starting with a slash.</param>
+    /// <returns>The script to evaluate in the web view.</returns>
+    internal static string CreateRefreshScript(string path)
+    {
+        if (!string.Equals(Path.GetExtension(path), ".css", StringComparison.OrdinalIgnoreCase))
+        {
+            return "location.reload();";
+        }
+
+        // Load the new stylesheet alongside the old one and only remove the old one once it has loaded, so the page
+        // is never unstyled. The query string is ignored when serving, but stops the web view using its cached copy
+        return $$"""
+                 (() => {
+                     const path = {{JsonSerializer.Serialize(path)}};
+                     for (const link of document.querySelectorAll('link[rel="stylesheet"]')) {
+                         const url = new URL(link.href, location.href);
+                         if (url.pathname !== path) continue;
+                         url.searchParams.set('testudo-refresh', Date.now());
+                         const replacement = link.cloneNode();
+                         replacement.href = url.href;
+                         replacement.onload = () => link.remove();
+                         link.after(replacement);
+                     }
+                 })();
+                 """;
+    }
+
+    /// <summary>
+    /// Restarts the settle delay of the file that changed.
+    /// </summary>
+    private void OnFileSystemEvent(object? sender, FileSystemEventArgs e)
+    {
+        if (Directory.Exists(e.FullPath))
+        {
+            return;
+        }
+
+        var path = "/" + Path.GetRelativePath(_directory, e.FullPath).Replace(Path.DirectorySeparatorChar, '/');
+        _pendingChanges.AddOrUpdate(path,
+            p => new Timer(OnFileSettled, p, SettleDelay, Timeout.InfiniteTimeSpan),
+            (_, timer) =>
+            {
+                timer.Change(SettleDelay, Timeout.InfiniteTimeSpan);
+                return timer;
+            });
+    }
+
+    /// <summary>
+    /// Discards any copy of the file that was read ahead of time, then raises <see cref="FileChanged" />.
+    /// </summary>
+    private void OnFileSettled(object? state)
+    {
+        var path = (string)state!;
+        if (_pendingChanges.TryRemove(path, out var timer))
+        {
+            timer.Dispose();
+        }
+
+        _prefetcher.Invalidate(path);
+        FileChanged?.Invoke(path);
+    }
+}
\ No newline at end of file
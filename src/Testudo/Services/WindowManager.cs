@@ -5,12 +5,21 @@ namespace Testudo;
 /// <inheritdoc />
 public class WindowManager(IScopeContext scopeContext) : IWindowManager
 {
-    private readonly ConcurrentDictionary<Type, ITestudoWindow> _windows = [];
+    /// <summary>
+    /// Holds the window for each root component, which may still be being created.
+    /// </summary>
+    private readonly ConcurrentDictionary<Type, Task<ITestudoWindow>> _windows = [];
+
+    /// <summary>
+    /// How long closing a window waits for it to finish being created, in case the main loop is no longer running.
+    /// </summary>
+    private static readonly TimeSpan CreationTimeout = TimeSpan.FromSeconds(5);
 
     /// <inheritdoc />
     public async Task CloseWindowAsync<TComponent>()
     {
-        if (_windows.TryRemove(typeof(TComponent), out var window))
+        if (_windows.TryRemove(typeof(TComponent), out var pendingWindow) &&
+            await TryGetCreatedWindowAsync(pendingWindow) is { } window)
         {
             await window.DisposeAsync();
         }
@@ -19,19 +28,79 @@ public class WindowManager(IScopeContext scopeContext) : IWindowManager
     /// <inheritdoc />
     public async ValueTask DisposeAsync()
     {
-        foreach (var (_, window) in _windows)
+        // Every window is disposed even if another one fails to, and the failures are reported together afterwards
+        List<Exception>? exceptions = null;
+        foreach (var (_, pendingWindow) in _windows)
         {
-            await window.DisposeAsync();
+            try
+            {
+                if (await TryGetCreatedWindowAsync(pendingWindow) is { } window)
+                {
+                    await window.DisposeAsync();
+                }
+            }
+            catch (Exception exception)
+            {
+                exceptions ??= [];
+                exceptions.Add(exception);
+            }
         }
-        
+
+        _windows.Clear();
         GC.SuppressFinalize(this);
+
+        if (exceptions != null)
+        {
+            throw new AggregateException("Some windows could not be disposed.", exceptions);
+        }
+    }
+
+    /// <summary>
+    /// Waits for a window to finish being created.
+    /// </summary>
+    /// <param name="pendingWindow">The window's creation.</param>
+    /// <returns>The window, or null if its creation failed or did not complete in time.</returns>
+    /// <remarks>
+    /// A failed creation has already been reported to the caller of <see cref="OpenWindowAsync{TComponent}" />, and
+    /// has nothing left to dispose. A creation that does not complete in time is still going, and the window is
+    /// disposed as soon as it has been created.
+    /// </remarks>
+    private static async Task<ITestudoWindow?> TryGetCreatedWindowAsync(Task<ITestudoWindow> pendingWindow)
+    {
+        try
+        {
+            return await pendingWindow.WaitAsync(CreationTimeout);
+        }
+        catch (TimeoutException)
+        {
+            // The window has already been forgotten, so nothing else would ever dispose it once it is created
+            _ = pendingWindow.ContinueWith(task => task.Result.DisposeAsync().AsTask(), CancellationToken.None,
+                TaskContinuationOptions.OnlyOnRanToCompletion, TaskScheduler.Default).Unwrap();
+            return null;
+        }
+        catch (Exception)
+        {
+            return null;
+        }
     }
 
     /// <inheritdoc />
-    public Task OpenWindowAsync<TComponent>(TestudoWindowConfiguration configuration)
+    public async Task OpenWindowAsync<TComponent>(TestudoWindowConfiguration configuration)
     {
-        // Ensure the window isn't already open
-        if (!_windows.ContainsKey(typeof(TComponent)))
+        // Reserve the window first so that concurrent calls for the same component only open it once
+        var reservation = new TaskCompletionSource<ITestudoWindow>(TaskCreationOptions.RunContinuationsAsynchronously);
+        if (!_windows.TryAdd(typeof(TComponent), reservation.Task))
+        {
+            // The window is already open, or is being opened by another call
+            if (_windows.TryGetValue(typeof(TComponent), out var existing))
+            {
+                await existing;
+            }
+
+            return;
+        }
+
+        try
         {
             // Ensure this scope's service provider can be retrieved
             if (scopeContext.ServiceProvider == null)
@@ -40,12 +109,25 @@ public class WindowManager(IScopeContext scopeContext) : IWindowManager
                                                     $" must be assigned immediately after the scope is created.");
             }
 
-            // Create the native window
-            var window = new TestudoWindow(scopeContext.ServiceProvider, configuration);
-            window.AddRootComponent<TComponent>();
-            _windows[typeof(TComponent)] = window;
-        }
+            // Create the native window, the root component is attached once the page is ready for it
+            var window = await TestudoWindow.CreateAsync(scopeContext.ServiceProvider, configuration);
+            try
+            {
+                await window.AddRootComponentAsync<TComponent>();
+            }
+            catch
+            {
+                await window.DisposeAsync();
+                throw;
+            }
 
-        return Task.CompletedTask;
+            reservation.SetResult(window);
+        }
+        catch (Exception exception)
+        {
+            _windows.TryRemove(new KeyValuePair<Type, Task<ITestudoWindow>>(typeof(TComponent), reservation.Task));
+            reservation.SetException(exception);
+            throw;
+        }
     }
 }
\ No newline at end of file